@@ -397,6 +397,14 @@ cSound *cAudio :: Get_Sound_File( std::string filename ) const
 		return NULL;
 	}
 
+	// already cached with the full path
+	cSound *sound = pSound_Manager->Get_Pointer( filename );
+
+	if( sound )
+	{
+		return sound;
+	}
+
 	// not available
 	if( !File_Exists( filename ) )
 	{
@@ -407,7 +415,7 @@ cSound *cAudio :: Get_Sound_File( std::string filename ) const
 		}
 	}
 
-	cSound *sound = pSound_Manager->Get_Pointer( filename );
+	sound = pSound_Manager->Get_Pointer( filename );
 
 	// if not already cached
 	if( !sound )
@@ -444,24 +452,35 @@ bool cAudio :: Play_Sound( std::string filename, int res_id /* = -1 */, int volu
 		return 0;
 	}
 
-	// not available
-	if( !File_Exists( filename ) )
+	// already cached sounds don't need a file check
+	cSound *sound_data = pSound_Manager->Get_Pointer( filename );
+
+	if( !sound_data && filename.find( DATA_DIR "/" GAME_SOUNDS_DIR "/" ) == std::string::npos )
 	{
-		// add sound directory
-		if( filename.find( DATA_DIR "/" GAME_SOUNDS_DIR "/" ) == std::string::npos )
-		{
-			filename.insert( 0, DATA_DIR "/" GAME_SOUNDS_DIR "/" );
-		}
+		sound_data = pSound_Manager->Get_Pointer( DATA_DIR "/" GAME_SOUNDS_DIR "/" + filename );
+	}
 
-		// not found
+	if( !sound_data )
+	{
+		// not available
 		if( !File_Exists( filename ) )
 		{
-			printf( "Could not find sound file : %s\n", filename.c_str() );
-			return 0;
+			// add sound directory
+			if( filename.find( DATA_DIR "/" GAME_SOUNDS_DIR "/" ) == std::string::npos )
+			{
+				filename.insert( 0, DATA_DIR "/" GAME_SOUNDS_DIR "/" );
+			}
+
+			// not found
+			if( !File_Exists( filename ) )
+			{
+				printf( "Could not find sound file : %s\n", filename.c_str() );
+				return 0;
+			}
 		}
-	}
 
-	cSound *sound_data = Get_Sound_File( filename );
+		sound_data = Get_Sound_File( filename );
+	}
 
 	// failed loading
 	if( !sound_data )
@@ -72,29 +72,64 @@ cSound_Manager :: ~cSound_Manager( void )
 
 cSound *cSound_Manager :: Get_Pointer( const std::string &path ) const
 {
-	for( SoundList::const_iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	return m_filename_index.Get( path );
+}
+
+void cSound_Manager :: Add( cSound *sound )
+{
+	m_load_count++;
+	cObject_Manager<cSound>::Add( sound );
+	// only the first sound with the filename is found
+	m_filename_index.Add( sound->m_filename, sound );
+}
+
+bool cSound_Manager :: Delete( size_t array_num, bool delete_data /* = 1 */ )
+{
+	// not in vector
+	if( array_num >= objects.size() )
 	{
-		cSound *obj = (*itr);
+		return 0;
+	}
 
-		if( obj->m_filename.compare( path ) == 0 )
+	return Delete( objects[array_num], delete_data );
+}
+
+bool cSound_Manager :: Delete( cSound *obj, bool delete_data /* = 1 */ )
+{
+	// empty object
+	if( !obj )
+	{
+		return 0;
+	}
+
+	// remove from index
+	if( m_filename_index.Remove( obj->m_filename, obj ) )
+	{
+		// index the next sound with the same filename
+		for( SoundList::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
 		{
-			// return first found
-			return obj;
+			if( (*itr) != obj && (*itr)->m_filename.compare( obj->m_filename ) == 0 )
+			{
+				m_filename_index.Add( (*itr)->m_filename, (*itr) );
+				break;
+			}
 		}
 	}
 
-	// not found
-	return NULL;
+	return cObject_Manager<cSound>::Delete( obj, delete_data );
 }
 
-void cSound_Manager :: Add( cSound *sound )
+void cSound_Manager :: Delete_All( void )
 {
-	m_load_count++;
-	cObject_Manager<cSound>::Add( sound );
+	m_filename_index.Clear();
+	cObject_Manager<cSound>::Delete_All();
 }
 
 void cSound_Manager :: Delete_Sounds( void )
 {
+	// the deleted sounds can not be found anymore
+	m_filename_index.Clear();
+
 	for( SoundList::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
 	{
 		cSound *obj = (*itr);
@@ -18,6 +18,7 @@
 
 #include "../core/globals.h"
 #include "../core/obj_manager.h"
+#include "../core/hash_index.h"
 // SDL
 // also includes needed SDL headers
 #include "SDL_mixer.h"
@@ -68,6 +69,13 @@ public:
 	 */
 	void Add( cSound *item );
 
+	// Delete the sound from given array number
+	virtual bool Delete( size_t array_num, bool delete_data = 1 );
+	// Delete the given sound
+	virtual bool Delete( cSound *obj, bool delete_data = 1 );
+	// Delete all sounds
+	virtual void Delete_All( void );
+
 	cSound *operator [] ( unsigned int identifier ) const
 	{
 		return cObject_Manager<cSound>::Get_Pointer( identifier );
@@ -84,6 +92,8 @@ public:
 private:
 	// sounds loaded since initialization
 	unsigned int m_load_count;
+	// sounds by filename
+	cHash_Index<cSound> m_filename_index;
 };
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -0,0 +1,302 @@
+/***************************************************************************
+ * benchmark.cpp  -  headless level update benchmark
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/benchmark.h"
+#include "../core/main.h"
+#include "../core/game_core.h"
+#include "../core/framerate.h"
+#include "../core/profiler.h"
+#include "../core/sprite_manager.h"
+#include "../core/filesystem/filesystem.h"
+#include "../level/level.h"
+#include "../player/player.h"
+#include "../input/keyboard.h"
+#include "../user/preferences.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace SMC
+{
+
+// frames without input after entering the level
+static const unsigned int benchmark_start_frames = 30;
+// frames between two jumps
+static const unsigned int benchmark_jump_interval = 75;
+// frames the jump key is held
+static const unsigned int benchmark_jump_frames = 40;
+// frames between two shots
+static const unsigned int benchmark_shoot_interval = 50;
+
+// Return the value at the percentile of the sorted values
+static Uint64 Get_Percentile( const vector<Uint64> &sorted_values, unsigned int percentile )
+{
+	if( sorted_values.empty() )
+	{
+		return 0;
+	}
+
+	// nearest rank
+	size_t rank = ( sorted_values.size() * percentile + 99 ) / 100;
+
+	if( rank == 0 )
+	{
+		rank = 1;
+	}
+
+	return sorted_values[rank - 1];
+}
+
+// Press or release the key if the state changed
+static void Set_Key( SDLKey key, bool pressed )
+{
+	if( pKeyboard->keys[key] == pressed )
+	{
+		return;
+	}
+
+	if( pressed )
+	{
+		pKeyboard->Key_Down( key );
+	}
+	else
+	{
+		pKeyboard->Key_Up( key );
+	}
+}
+
+/* *** *** *** *** *** *** cBenchmark *** *** *** *** *** *** *** *** *** *** *** */
+
+cBenchmark :: cBenchmark( unsigned int frames /* = 1000 */ )
+{
+	m_frames = frames;
+}
+
+cBenchmark :: ~cBenchmark( void )
+{
+	//
+}
+
+bool cBenchmark :: Run_Level( const std::string &filename )
+{
+	// same random numbers for every run
+	srand( 0 );
+
+	// enter as custom level
+	Game_Mode_Type = MODE_TYPE_LEVEL_CUSTOM;
+	Change_Game_Mode( MODE_LEVEL );
+	pPlayer->Reset_Save();
+
+	if( !pActive_Level->Load( filename ) )
+	{
+		return 0;
+	}
+
+	pActive_Level->Enter();
+
+	// every frame is one update at the target framerate
+	pFramerate->Set_Fixed_Timestep( 0 );
+	pFramerate->Set_Fixed_Speedfacor( 1.0f );
+	pFramerate->Reset();
+
+	cLevel_Run run;
+	run.m_name = Trim_Filename( filename, 0, 0 );
+	run.m_frames.reserve( m_frames );
+
+	for( unsigned int i = 0; i < m_frames; i++ )
+	{
+		// level finished or left
+		if( game_exit || Game_Mode != MODE_LEVEL || !pActive_Level->Is_Loaded() )
+		{
+			break;
+		}
+
+		Update_Input( i );
+
+		pActive_Sprite_Manager->m_collision_queries = 0;
+		pActive_Sprite_Manager->m_collision_results = 0;
+
+		pProfiler->Begin_Frame();
+		Uint64 start = Get_Profiler_Time();
+
+		Update_Game();
+
+		cBenchmark_Frame frame;
+		frame.m_update_time = Get_Profiler_Time() - start;
+		pProfiler->End_Frame();
+
+		frame.m_sprites = static_cast<unsigned int>(pActive_Sprite_Manager->objects.size());
+		// sprites in the active item list of the frame
+		frame.m_active_sprites = static_cast<unsigned int>(pActive_Sprite_Manager->m_active_items.size());
+
+		frame.m_collision_queries = pActive_Sprite_Manager->m_collision_queries;
+		frame.m_collision_results = pActive_Sprite_Manager->m_collision_results;
+		run.m_frames.push_back( frame );
+
+		// applies the fixed speed factor
+		pFramerate->Update();
+	}
+
+	Release_Input();
+	pActive_Level->Unload();
+	pFramerate->Set_Fixed_Speedfacor( 0.0f );
+
+	Print_Results( run );
+	m_runs.push_back( run );
+
+	return 1;
+}
+
+unsigned int cBenchmark :: Run_Directory( const std::string &dir )
+{
+	if( !Dir_Exists( dir ) )
+	{
+		printf( "Error : Benchmark level directory %s not found\n", dir.c_str() );
+		return 0;
+	}
+
+	vector<std::string> level_files = Get_Directory_Files( dir, ".smclvl" );
+	// same order on every system
+	std::sort( level_files.begin(), level_files.end() );
+
+	unsigned int count = 0;
+
+	for( vector<std::string>::iterator itr = level_files.begin(), itr_end = level_files.end(); itr != itr_end; ++itr )
+	{
+		const std::string &filename = (*itr);
+
+		// only level files
+		if( filename.length() < 7 || filename.compare( filename.length() - 7, 7, ".smclvl" ) != 0 )
+		{
+			continue;
+		}
+
+		if( Run_Level( filename ) )
+		{
+			count++;
+		}
+		else
+		{
+			printf( "Warning : Could not benchmark level %s\n", filename.c_str() );
+		}
+
+		if( game_exit )
+		{
+			break;
+		}
+	}
+
+	return count;
+}
+
+bool cBenchmark :: Save_CSV( const std::string &filename ) const
+{
+	ofstream file( filename.c_str(), ios::out | ios::trunc );
+
+	if( !file.is_open() )
+	{
+		printf( "Error : Couldn't open benchmark CSV file %s for saving\n", filename.c_str() );
+		return 0;
+	}
+
+	file << "level,frame,update_ms,sprites,active_sprites,collision_queries,collision_results" << std::endl;
+	file << std::fixed << std::setprecision( 4 );
+
+	for( Level_Run_List::const_iterator itr = m_runs.begin(), itr_end = m_runs.end(); itr != itr_end; ++itr )
+	{
+		const cLevel_Run &run = (*itr);
+
+		for( unsigned int i = 0; i < run.m_frames.size(); i++ )
+		{
+			const cBenchmark_Frame &frame = run.m_frames[i];
+
+			file << run.m_name << "," << i << ",";
+			file << static_cast<double>(frame.m_update_time) * 0.000001 << ",";
+			file << frame.m_sprites << "," << frame.m_active_sprites << ",";
+			file << frame.m_collision_queries << "," << frame.m_collision_results << std::endl;
+		}
+	}
+
+	file.close();
+
+	return 1;
+}
+
+void cBenchmark :: Update_Input( unsigned int frame ) const
+{
+	// let the level settle
+	if( frame < benchmark_start_frames )
+	{
+		return;
+	}
+
+	frame -= benchmark_start_frames;
+
+	// walk right and jump and shoot regularly
+	Set_Key( pPreferences->m_key_right, 1 );
+	Set_Key( pPreferences->m_key_jump, frame % benchmark_jump_interval < benchmark_jump_frames );
+	Set_Key( pPreferences->m_key_shoot, frame % benchmark_shoot_interval == 0 );
+}
+
+void cBenchmark :: Release_Input( void ) const
+{
+	Set_Key( pPreferences->m_key_right, 0 );
+	Set_Key( pPreferences->m_key_jump, 0 );
+	Set_Key( pPreferences->m_key_shoot, 0 );
+}
+
+void cBenchmark :: Print_Results( const cLevel_Run &run ) const
+{
+	if( run.m_frames.empty() )
+	{
+		printf( "%s : no frames updated\n", run.m_name.c_str() );
+		return;
+	}
+
+	vector<Uint64> times;
+	times.reserve( run.m_frames.size() );
+
+	Uint64 total_time = 0;
+	double total_sprites = 0;
+	double total_active_sprites = 0;
+	double total_queries = 0;
+	double total_results = 0;
+
+	for( Benchmark_Frame_List::const_iterator itr = run.m_frames.begin(), itr_end = run.m_frames.end(); itr != itr_end; ++itr )
+	{
+		const cBenchmark_Frame &frame = (*itr);
+
+		times.push_back( frame.m_update_time );
+		total_time += frame.m_update_time;
+		total_sprites += frame.m_sprites;
+		total_active_sprites += frame.m_active_sprites;
+		total_queries += frame.m_collision_queries;
+		total_results += frame.m_collision_results;
+	}
+
+	std::sort( times.begin(), times.end() );
+	const double count = static_cast<double>(run.m_frames.size());
+
+	printf( "%s : frames %u, update ms mean %.4f p50 %.4f p99 %.4f max %.4f, sprites %.1f, active %.1f, collision queries %.1f, results %.1f\n",
+		run.m_name.c_str(), static_cast<unsigned int>(run.m_frames.size()),
+		static_cast<double>(total_time) * 0.000001 / count,
+		static_cast<double>(Get_Percentile( times, 50 )) * 0.000001,
+		static_cast<double>(Get_Percentile( times, 99 )) * 0.000001,
+		static_cast<double>(times.back()) * 0.000001,
+		total_sprites / count, total_active_sprites / count, total_queries / count, total_results / count );
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,103 @@
+/***************************************************************************
+ * benchmark.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_BENCHMARK_H
+#define SMC_BENCHMARK_H
+
+#include "../core/global_basic.h"
+// SDL
+#include "SDL.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cBenchmark_Frame *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// measured values of one updated frame
+class cBenchmark_Frame
+{
+public:
+	// update time in nanoseconds
+	Uint64 m_update_time;
+	// sprites in the sprite manager
+	unsigned int m_sprites;
+	// sprites in the active item list of the frame
+	unsigned int m_active_sprites;
+	// collision queries
+	unsigned int m_collision_queries;
+	// objects found by the collision queries
+	unsigned int m_collision_results;
+};
+
+typedef vector<cBenchmark_Frame> Benchmark_Frame_List;
+
+/* *** *** *** *** *** cBenchmark *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Headless level benchmark
+ * Updates levels for a number of frames with scripted keyboard input and a fixed speed factor.
+ * The game must be initialized headless because nothing is drawn.
+*/
+class cBenchmark
+{
+public:
+	cBenchmark( unsigned int frames = 1000 );
+	~cBenchmark( void );
+
+	/* Run the level and print the results
+	 * stops early if the level is left
+	 * returns true if the level could be loaded
+	*/
+	bool Run_Level( const std::string &filename );
+	/* Run all levels in the directory
+	 * returns the number of levels run
+	*/
+	unsigned int Run_Directory( const std::string &dir );
+
+	/* Save the frames of all runs as CSV file
+	 * returns true if successful
+	*/
+	bool Save_CSV( const std::string &filename ) const;
+
+	// frames to update per level
+	unsigned int m_frames;
+
+private:
+	// a finished level run
+	class cLevel_Run
+	{
+	public:
+		// level name
+		std::string m_name;
+		// measured frames
+		Benchmark_Frame_List m_frames;
+	};
+
+	// Set the scripted keyboard input for the frame
+	void Update_Input( unsigned int frame ) const;
+	// Release all scripted keys
+	void Release_Input( void ) const;
+	// Print the update time percentiles and average counts of the run
+	void Print_Results( const cLevel_Run &run ) const;
+
+	typedef vector<cLevel_Run> Level_Run_List;
+	// finished runs
+	Level_Run_List m_runs;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -438,6 +438,36 @@ void cCamera :: Update( void )
 	}
 }
 
+void cCamera :: Save_Tick_Pos( void )
+{
+	m_interpolation.tick_x = x;
+	m_interpolation.tick_y = y;
+}
+
+void cCamera :: Set_Interpolated_Pos( float alpha )
+{
+	m_interpolation.pos_x = x;
+	m_interpolation.pos_y = y;
+
+	const float diff_x = x - m_interpolation.tick_x;
+	const float diff_y = y - m_interpolation.tick_y;
+
+	// jumped to a new position
+	if( fabs( diff_x ) > fixed_timestep_interpolation_distance || fabs( diff_y ) > fixed_timestep_interpolation_distance )
+	{
+		return;
+	}
+
+	x = m_interpolation.tick_x + ( diff_x * alpha );
+	y = m_interpolation.tick_y + ( diff_y * alpha );
+}
+
+void cCamera :: Restore_Pos( void )
+{
+	x = m_interpolation.pos_x;
+	y = m_interpolation.pos_y;
+}
+
 void cCamera :: Update_Position( void ) const
 {
 	// mouse
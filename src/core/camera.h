@@ -22,6 +22,20 @@
 namespace SMC
 {
 
+/* *** *** *** *** *** cCamera_Interpolation *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Camera positions for drawing between two fixed timestep updates
+struct cCamera_Interpolation
+{
+	cCamera_Interpolation( void )
+	: tick_x( 0.0f ), tick_y( 0.0f ), pos_x( 0.0f ), pos_y( 0.0f ) {};
+
+	// position before the last fixed timestep update
+	float tick_x, tick_y;
+	// updated position while the interpolated position is set
+	float pos_x, pos_y;
+};
+
 /* *** *** *** *** *** cCamera *** *** *** *** *** *** *** *** *** *** *** *** */
 
 class cCamera
@@ -70,6 +84,15 @@ public:
 	// update if position changed
 	void Update_Position( void ) const;
 
+	// Save the position before a fixed timestep update
+	void Save_Tick_Pos( void );
+	/* Set the position between the last two fixed timestep updates
+	 * not if it jumped to a new position
+	*/
+	void Set_Interpolated_Pos( float alpha );
+	// Restore the updated position
+	void Restore_Pos( void );
+
 	// position
 	float x, y;
 	// additional position offset
@@ -81,6 +104,8 @@ public:
 
 	// fixed horizontal scrolling velocity
 	float fixed_hor_vel;
+	// fixed timestep interpolation positions
+	cCamera_Interpolation m_interpolation;
 
 	// default limits
 	static const GL_rect default_limits;
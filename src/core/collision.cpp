@@ -20,23 +20,71 @@
 #include "../player/player.h"
 #include "../video/gl_surface.h"
 #include "../core/sprite_manager.h"
+#include "../core/memory_pool.h"
 // for binary_function and bind2nd
 #include <functional>
 
 namespace SMC
 {
 
+/* *** *** *** *** *** *** *** Collision memory *** *** *** *** *** *** *** *** *** *** */
+
+// memory for the collision objects
+static cMemory_Pool collision_pool( sizeof(cObjectCollision), 512 );
+// memory for the collision type lists
+static cMemory_Pool collision_type_pool( sizeof(cObjectCollisionType), 64 );
+
+// maximum cached list buffers
+static const unsigned int collision_list_cache_max = 64;
+// list buffers from deleted collision types which keep their capacity
+static vector<cObjectCollision_List> collision_list_cache;
+
 /* *** *** *** *** *** *** *** cObjectCollisionType *** *** *** *** *** *** *** *** *** *** */
 
 cObjectCollisionType :: cObjectCollisionType( void )
 : cObject_Manager<cObjectCollision>()
 {
-
+	// reuse an already allocated list buffer
+	if( !collision_list_cache.empty() )
+	{
+		objects.swap( collision_list_cache.back() );
+		collision_list_cache.pop_back();
+	}
 }
 
 cObjectCollisionType :: ~cObjectCollisionType( void )
 {
 	Delete_All();
+
+	// keep the list buffer for the next collision type
+	if( objects.capacity() && collision_list_cache.size() < collision_list_cache_max )
+	{
+		collision_list_cache.push_back( cObjectCollision_List() );
+		collision_list_cache.back().swap( objects );
+	}
+}
+
+void *cObjectCollisionType :: operator new( size_t size )
+{
+	// derived class
+	if( size != sizeof(cObjectCollisionType) )
+	{
+		return ::operator new( size );
+	}
+
+	return collision_type_pool.Alloc();
+}
+
+void cObjectCollisionType :: operator delete( void *ptr, size_t size )
+{
+	// derived class
+	if( size != sizeof(cObjectCollisionType) )
+	{
+		::operator delete( ptr );
+		return;
+	}
+
+	collision_type_pool.Free( ptr );
 }
 
 void cObjectCollisionType :: Add( cObjectCollision *obj )
@@ -128,6 +176,29 @@ cObjectCollision :: ~cObjectCollision( void )
 	//
 }
 
+void *cObjectCollision :: operator new( size_t size )
+{
+	// derived class
+	if( size != sizeof(cObjectCollision) )
+	{
+		return ::operator new( size );
+	}
+
+	return collision_pool.Alloc();
+}
+
+void cObjectCollision :: operator delete( void *ptr, size_t size )
+{
+	// derived class
+	if( size != sizeof(cObjectCollision) )
+	{
+		::operator delete( ptr );
+		return;
+	}
+
+	collision_pool.Free( ptr );
+}
+
 void cObjectCollision :: Set_Direction( const cSprite *base, const cSprite *col )
 {
 	direction = Get_Collision_Direction( base, col );
@@ -43,6 +43,10 @@ public:
 	// returns the colliding object rect
 	GL_rect Get_Collision_Object_Rect( void );
 
+	// allocate from the collision memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
+
 	// valid type
 	Col_Valid_Type valid_type;
 
@@ -89,6 +93,10 @@ public:
 	cObjectCollision *Find_First( const ArrayType type );
 	// returns the first found sprite if the given sprite type was found
 	cObjectCollision *Find_First( const SpriteType type );
+
+	// allocate from the collision type memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
 };
 
 /* *** *** *** *** *** *** *** functions *** *** *** *** *** *** *** *** *** *** */
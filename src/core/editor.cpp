@@ -299,13 +299,8 @@ void cEditor :: Unload( void )
 
 	tagged_item_objects.clear();
 
-	// Tagged Image Settings
-	for( TaggedItemImageSettingsList::iterator itr = tagged_item_images.begin(), itr_end = tagged_item_images.end(); itr != itr_end; ++itr )
-	{
-		delete *itr;
-	}
-
-	tagged_item_images.clear();
+	// Tagged Images
+	image_item_index.Clear();
 
 
 	// Help Sprites
@@ -1056,36 +1051,43 @@ bool cEditor :: Load_Item_Menu( std::string item_tags )
 		item_tags.erase( 0, pos + 1 );
 	}
 
-	unsigned int tag_pos = 0;
+	// images also need the required item tag
+	vector<std::string> image_tags = array_tags;
+	image_tags.push_back( editor_item_tag );
+
+	vector<const cEditor_Image_Item *> image_items;
+	image_item_index.Get_Items( image_tags, image_items );
 
 	// Get all Images with the Tags
-	for( TaggedItemImageSettingsList::iterator itr = tagged_item_images.begin(), itr_end = tagged_item_images.end(); itr != itr_end; ++itr )
+	for( vector<const cEditor_Image_Item *>::iterator itr = image_items.begin(), itr_end = image_items.end(); itr != itr_end; ++itr )
 	{
-		cImage_settings_data *settings = (*itr);
+		const cEditor_Image_Item *item = (*itr);
+		// the full image is only loaded if placed
+		std::string image_filename = item->m_filename;
+		cGL_Surface *image = image_item_index.Get_Thumbnail( item, pPreferences->m_editor_item_image_size * 2, pPreferences->m_editor_item_image_size );
 
-		// search
-		while( Is_Tag_Available( settings->m_editor_tags, array_tags[tag_pos] ) )
+		// thumbnail failed
+		if( !image )
 		{
-			tag_pos++;
+			image = pVideo->Get_Surface( item->m_filename );
+			image_filename.clear();
 
-			// found all tags
-			if( tag_pos >= array_tags.size() )
+			if( !image )
 			{
-				cGL_Surface *image = pVideo->Get_Surface( settings->m_base );
-				// Create sprite
-				cSprite *new_sprite = new cSprite( image );
-				// default massivetype
-				new_sprite->Set_Sprite_Type( static_cast<SpriteType>(image->m_type) );
-				// Add new Sprite
-				Add_Item_Object( new_sprite );
-
-				break;
+				continue;
 			}
 		}
 
-		tag_pos = 0;
+		// Create sprite
+		cSprite *new_sprite = new cSprite( image );
+		// default massivetype
+		new_sprite->Set_Sprite_Type( static_cast<SpriteType>(image->m_type) );
+		// Add new Sprite
+		Add_Item_Object( new_sprite, "", NULL, image_filename );
 	}
 
+	unsigned int tag_pos = 0;
+
 	// Get all Objects with the Tags
 	for( TaggedItemObjectsList::iterator itr = tagged_item_objects.begin(), itr_end = tagged_item_objects.end(); itr != itr_end; ++itr )
 	{
@@ -1128,7 +1130,7 @@ void cEditor :: Unload_Item_Menu( void )
 }
 
 
-void cEditor :: Add_Item_Object( cSprite *sprite, std::string new_name /* = "" */, cGL_Surface *image /* = NULL */ )
+void cEditor :: Add_Item_Object( cSprite *sprite, std::string new_name /* = "" */, cGL_Surface *image /* = NULL */, const std::string &image_filename /* = "" */ )
 {
 	// if invalid
 	if( !sprite )
@@ -1219,6 +1221,7 @@ void cEditor :: Add_Item_Object( cSprite *sprite, std::string new_name /* = "" *
 
 	// object pointer
 	new_item->sprite_obj = sprite;
+	new_item->image_filename = image_filename;
 
 	// Initialize
 	new_item->Init();
@@ -1229,30 +1232,8 @@ void cEditor :: Add_Item_Object( cSprite *sprite, std::string new_name /* = "" *
 
 void cEditor :: Load_Image_Items( std::string dir )
 {
-	vector<std::string> image_files = Get_Directory_Files( dir, ".settings" );
-
-	// load all available objects
-	for( vector<std::string>::iterator itr = image_files.begin(), itr_end = image_files.end(); itr != itr_end; ++itr )
-	{
-		// get filename
-		std::string filename = (*itr);
-
-		// load settings
-		cImage_settings_data *settings = pSettingsParser->Get( filename );
-
-		// if settings are available
-		if( settings )
-		{
-			// if required editor tag is available
-			if( settings->m_editor_tags.find( editor_item_tag ) != std::string::npos )
-			{
-				// set base to the filename
-				settings->m_base = filename;
-				// add real image
-				tagged_item_images.push_back( settings );
-			}
-		}
-	}
+	// only searches the directory if changed
+	image_item_index.Load( dir );
 }
 
 void cEditor :: Activate_Item( cEditor_Item_Object *entry )
@@ -1273,6 +1254,17 @@ void cEditor :: Activate_Item( cEditor_Item_Object *entry )
 		printf( "Error : Editor Sprite %s copy failed\n", entry->sprite_obj->m_name.c_str() );
 		return;
 	}
+
+	// the item shows a thumbnail
+	if( !entry->image_filename.empty() )
+	{
+		cGL_Surface *image = pVideo->Get_Surface( entry->image_filename );
+
+		if( image )
+		{
+			new_sprite->Set_Image( image, 1 );
+		}
+	}
 	
 	new_sprite->Set_Pos( pMouseCursor->m_pos_x, pMouseCursor->m_pos_y, 1 );
 
@@ -1450,9 +1442,11 @@ void cEditor :: Change_Draw_Position( cSprite *obj, bool move_back ) const
 			return;
 		}
 
-		pActive_Sprite_Manager->Delete( obj, 0 );
+		// only change the array position
+		pActive_Sprite_Manager->objects.erase( std::find( pActive_Sprite_Manager->objects.begin(), pActive_Sprite_Manager->objects.end(), obj ) );
 		pActive_Sprite_Manager->objects.back() = obj;
 		pActive_Sprite_Manager->objects.insert( pActive_Sprite_Manager->objects.end() - 1, last );
+		pActive_Sprite_Manager->Renumber();
 
 		obj->m_pos_z = pActive_Sprite_Manager->Get_Last( obj->m_type )->m_pos_z + 0.000001f;
 	}
@@ -1468,9 +1462,11 @@ void cEditor :: Change_Draw_Position( cSprite *obj, bool move_back ) const
 			return;
 		}
 
-		pActive_Sprite_Manager->Delete( obj, 0 );
+		// only change the array position
+		pActive_Sprite_Manager->objects.erase( std::find( pActive_Sprite_Manager->objects.begin(), pActive_Sprite_Manager->objects.end(), obj ) );
 		pActive_Sprite_Manager->objects.front() = obj;
 		pActive_Sprite_Manager->objects.insert( pActive_Sprite_Manager->objects.begin() + 1, first );
+		pActive_Sprite_Manager->Renumber();
 
 		obj->m_pos_z = pActive_Sprite_Manager->Get_First( obj->m_type )->m_pos_z - 0.000001f;
 	}
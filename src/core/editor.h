@@ -20,6 +20,7 @@
 #include "../objects/sprite.h"
 #include "../gui/hud.h"
 #include "../video/img_settings.h"
+#include "../core/editor_item_index.h"
 // CEGUI
 #include "CEGUIXMLHandler.h"
 #include "CEGUIXMLAttributes.h"
@@ -73,6 +74,8 @@ public:
 	cSprite *sprite_obj;
 	// preview image scale
 	float preview_scale;
+	// image used for the placed object if the sprite uses a thumbnail
+	std::string image_filename;
 };
 
 /* *** *** *** *** *** *** *** *** cEditor_Menu_Object *** *** *** *** *** *** *** *** *** */
@@ -158,9 +161,10 @@ public:
 	/* Add an Object to the Item list
 	 * if nName is set it will not use the object name
 	 * if image is set the default object image is not used
+	 * if image_filename is set the placed object uses this image instead of the sprite image
 	 */
-	void Add_Item_Object( cSprite *sprite, std::string new_name = "", cGL_Surface *image = NULL );
-	// Loads all Image Items
+	void Add_Item_Object( cSprite *sprite, std::string new_name = "", cGL_Surface *image = NULL, const std::string &image_filename = "" );
+	// Loads all Image Items from the editor item index
 	void Load_Image_Items( std::string dir );
 	// Active Item Entry
 	virtual void Activate_Item( cEditor_Item_Object *entry );
@@ -207,9 +211,9 @@ public:
 	// Timer until the Menu will be minimized
 	float menu_timer;
 
+	// Images with tags
+	cEditor_Item_Index image_item_index;
 	// Objects with tags
-	typedef vector<cImage_settings_data *> TaggedItemImageSettingsList;
-	TaggedItemImageSettingsList tagged_item_images;
 	typedef vector<cSprite *> TaggedItemObjectsList;
 	TaggedItemObjectsList tagged_item_objects;
 
@@ -0,0 +1,598 @@
+/***************************************************************************
+ * editor_item_index.cpp  -  index of the images with editor tags
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/editor_item_index.h"
+#include "../core/game_core.h"
+#include "../core/filesystem/filesystem.h"
+#include "../core/filesystem/resource_manager.h"
+#include "../video/video.h"
+#include "../video/img_manager.h"
+#include "../video/img_settings.h"
+#include <algorithm>
+#include <cstring>
+// boost filesystem
+#include "boost/filesystem/convenience.hpp"
+namespace fs = boost::filesystem;
+
+namespace SMC
+{
+
+// index file identifier
+static const char editor_item_index_magic[4] = { 'S', 'M', 'C', 'E' };
+
+/* *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** *** */
+
+// Add the value in little endian byte order
+static void Write_Uint( std::string &data, unsigned int value )
+{
+	data += static_cast<char>(value & 0xFF);
+	data += static_cast<char>(( value >> 8 ) & 0xFF);
+	data += static_cast<char>(( value >> 16 ) & 0xFF);
+	data += static_cast<char>(( value >> 24 ) & 0xFF);
+}
+
+// Add the string length and characters
+static void Write_String( std::string &data, const std::string &str )
+{
+	Write_Uint( data, static_cast<unsigned int>(str.length()) );
+	data += str;
+}
+
+/* Read a little endian value and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Uint( const vector<char> &data, size_t &pos, unsigned int &value )
+{
+	if( pos + 4 > data.size() )
+	{
+		return 0;
+	}
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&data[pos]);
+	value = bytes[0] | ( bytes[1] << 8 ) | ( bytes[2] << 16 ) | ( static_cast<unsigned int>(bytes[3]) << 24 );
+	pos += 4;
+
+	return 1;
+}
+
+/* Read a signed value and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Int( const vector<char> &data, size_t &pos, int &value )
+{
+	unsigned int bits;
+
+	if( !Read_Uint( data, pos, bits ) )
+	{
+		return 0;
+	}
+
+	value = static_cast<int>(bits);
+	return 1;
+}
+
+/* Read a string and advance the position
+ * returns false if the data ended
+*/
+static bool Read_String( const vector<char> &data, size_t &pos, std::string &str )
+{
+	unsigned int length;
+
+	if( !Read_Uint( data, pos, length ) || pos + length > data.size() )
+	{
+		return 0;
+	}
+
+	str.assign( data.begin() + pos, data.begin() + pos + length );
+	pos += length;
+
+	return 1;
+}
+
+// Split the editor tags into single tags
+static void Split_Tags( const std::string &editor_tags, vector<std::string> &tags )
+{
+	std::string::size_type start = 0;
+
+	while( start < editor_tags.length() )
+	{
+		std::string::size_type pos = editor_tags.find( ";", start );
+
+		// last tag
+		if( pos == std::string::npos )
+		{
+			pos = editor_tags.length();
+		}
+
+		if( pos > start )
+		{
+			tags.push_back( editor_tags.substr( start, pos - start ) );
+		}
+
+		start = pos + 1;
+	}
+}
+
+/* *** *** *** *** *** *** cEditor_Image_Item *** *** *** *** *** *** *** *** *** *** *** */
+
+cEditor_Image_Item :: cEditor_Image_Item( void )
+{
+	m_size = 0;
+	m_time = 0;
+	m_type = 0;
+	m_width = 0;
+	m_height = 0;
+	m_rotation_x = 0;
+	m_rotation_y = 0;
+	m_rotation_z = 0;
+}
+
+bool cEditor_Image_Item :: Has_Tag( const std::string &tag ) const
+{
+	return std::find( m_tags.begin(), m_tags.end(), tag ) != m_tags.end();
+}
+
+/* *** *** *** *** *** *** cEditor_Item_Index *** *** *** *** *** *** *** *** *** *** *** */
+
+cEditor_Item_Index :: cEditor_Item_Index( void )
+{
+	//
+}
+
+cEditor_Item_Index :: ~cEditor_Item_Index( void )
+{
+	Clear();
+}
+
+void cEditor_Item_Index :: Clear( void )
+{
+	m_items.clear();
+	m_tag_items.clear();
+	m_dir.clear();
+	m_directories.clear();
+	m_directory_times.clear();
+}
+
+void cEditor_Item_Index :: Load( const std::string &dir )
+{
+	// already loaded
+	if( m_dir.compare( dir ) == 0 )
+	{
+		return;
+	}
+
+	if( Load_Index( dir ) )
+	{
+		return;
+	}
+
+	Build( dir );
+	Save_Index();
+}
+
+void cEditor_Item_Index :: Get_Items( const vector<std::string> &tags, vector<const cEditor_Image_Item *> &items ) const
+{
+	if( tags.empty() )
+	{
+		return;
+	}
+
+	// use the tag with the least items
+	const ItemNumList *item_nums = NULL;
+
+	for( vector<std::string>::const_iterator itr = tags.begin(), itr_end = tags.end(); itr != itr_end; ++itr )
+	{
+		TagItemMap::const_iterator tag_itr = m_tag_items.find( *itr );
+
+		// no item has this tag
+		if( tag_itr == m_tag_items.end() )
+		{
+			return;
+		}
+
+		if( !item_nums || tag_itr->second.size() < item_nums->size() )
+		{
+			item_nums = &tag_itr->second;
+		}
+	}
+
+	for( ItemNumList::const_iterator itr = item_nums->begin(), itr_end = item_nums->end(); itr != itr_end; ++itr )
+	{
+		const cEditor_Image_Item *item = &m_items[*itr];
+		bool found = 1;
+
+		for( vector<std::string>::const_iterator tag_itr = tags.begin(), tag_itr_end = tags.end(); tag_itr != tag_itr_end; ++tag_itr )
+		{
+			if( !item->Has_Tag( *tag_itr ) )
+			{
+				found = 0;
+				break;
+			}
+		}
+
+		if( found )
+		{
+			items.push_back( item );
+		}
+	}
+}
+
+cGL_Surface *cEditor_Item_Index :: Get_Thumbnail( const cEditor_Image_Item *item, unsigned int max_width, unsigned int max_height ) const
+{
+	std::string thumbnail_file = pResource_Manager->user_data_dir + USER_IMGCACHE_DIR "/editor/" + int_to_string( editor_item_index_version ) + "/" + int_to_string( max_width ) + "x" + int_to_string( max_height ) + "/" + item->m_filename.substr( strlen( DATA_DIR "/" ) ) + ".png";
+
+	// already loaded
+	cGL_Surface *image = pImage_Manager->Get_Pointer( thumbnail_file );
+
+	if( image )
+	{
+		return image;
+	}
+
+	// drawing size of the image
+	float draw_width = static_cast<float>(item->m_width);
+	float draw_height = static_cast<float>(item->m_height);
+
+	std::string image_file = pVideo->Get_Surface_Filename( item->m_filename );
+	// 0 if not available
+	time_t thumbnail_time = Get_File_Modification_Time( thumbnail_file );
+
+	// create if not available or older than the settings or image file
+	if( !thumbnail_time || thumbnail_time < static_cast<time_t>(item->m_time) || thumbnail_time < Get_File_Modification_Time( image_file ) )
+	{
+		cVideo::cSoftware_Image software_image = pVideo->Load_Image( image_file, 1, 0 );
+
+		if( software_image.settings )
+		{
+			delete software_image.settings;
+		}
+
+		if( !software_image.sdl_surface )
+		{
+			return NULL;
+		}
+
+		// image size without the power of two border
+		const int image_width = software_image.sdl_surface->w;
+		const int image_height = software_image.sdl_surface->h;
+		SDL_Surface *surface = pVideo->Convert_To_Final_Software_Image( software_image.sdl_surface );
+		const unsigned int image_bpp = surface->format->BytesPerPixel;
+
+		// copy the image without the border
+		unsigned char *image_pixels = new unsigned char[image_width * image_height * image_bpp];
+
+		for( int row = 0; row < image_height; row++ )
+		{
+			memcpy( image_pixels + row * image_width * image_bpp, static_cast<unsigned char *>(surface->pixels) + row * surface->pitch, image_width * image_bpp );
+		}
+
+		SDL_FreeSurface( surface );
+
+		if( draw_width <= 0.0f || draw_height <= 0.0f )
+		{
+			draw_width = static_cast<float>(image_width);
+			draw_height = static_cast<float>(image_height);
+		}
+
+		// thumbnail size with the drawing size aspect ratio
+		const float scale = std::min( 1.0f, std::min( static_cast<float>(max_width) / draw_width, static_cast<float>(max_height) / draw_height ) );
+		const int thumbnail_width = std::max( static_cast<int>(draw_width * scale), 1 );
+		const int thumbnail_height = std::max( static_cast<int>(draw_height * scale), 1 );
+
+		// reduction block size for each direction
+		const int block_x = std::max( image_width / thumbnail_width, 1 );
+		const int block_y = std::max( image_height / thumbnail_height, 1 );
+		const int width = std::max( image_width / block_x, 1 );
+		const int height = std::max( image_height / block_y, 1 );
+
+		try
+		{
+			fs::create_directories( fs::path( thumbnail_file.substr( 0, thumbnail_file.rfind( "/" ) ), fs::native ) );
+		}
+		// could happen if we have no write rights
+		catch( const std::exception &ex )
+		{
+			printf( "%s\n", ex.what() );
+			delete[] image_pixels;
+			return NULL;
+		}
+
+		// already small enough
+		if( block_x == 1 && block_y == 1 )
+		{
+			pVideo->Save_Surface( thumbnail_file, image_pixels, width, height, image_bpp );
+		}
+		else
+		{
+			unsigned char *image_downsampled = new unsigned char[width * height * image_bpp];
+
+			if( pVideo->Downscale_Image( image_pixels, image_width, image_height, image_bpp, image_downsampled, block_x, block_y ) )
+			{
+				pVideo->Save_Surface( thumbnail_file, image_downsampled, width, height, image_bpp );
+			}
+
+			delete[] image_downsampled;
+		}
+
+		delete[] image_pixels;
+	}
+
+	cVideo::cSoftware_Image thumbnail_image;
+	thumbnail_image.sdl_surface = IMG_Load( thumbnail_file.c_str() );
+
+	if( !thumbnail_image.sdl_surface )
+	{
+		return NULL;
+	}
+
+	// small enough for the atlas
+	image = pVideo->Create_GL_Surface( thumbnail_file, thumbnail_image, 0, 1 );
+
+	if( !image )
+	{
+		return NULL;
+	}
+
+	// not in the pixmaps directory if loaded again
+	image->m_external_file = 1;
+
+	// the block reduction only keeps the aspect ratio of the image size
+	if( draw_width > 0.0f && draw_height > 0.0f )
+	{
+		const float scale = std::min( 1.0f, std::min( static_cast<float>(max_width) / draw_width, static_cast<float>(max_height) / draw_height ) );
+
+		image->m_start_w = draw_width * scale;
+		image->m_start_h = draw_height * scale;
+		image->m_w = image->m_start_w;
+		image->m_h = image->m_start_h;
+		image->m_col_w = image->m_w;
+		image->m_col_h = image->m_h;
+	}
+
+	// the sprites created with it use the image settings
+	image->m_name = item->m_name;
+	image->m_editor_tags = item->m_editor_tags;
+	image->m_type = item->m_type;
+	image->m_base_rot_x = static_cast<float>(item->m_rotation_x);
+	image->m_base_rot_y = static_cast<float>(item->m_rotation_y);
+	image->m_base_rot_z = static_cast<float>(item->m_rotation_z);
+
+	pImage_Manager->Add( image );
+
+	return image;
+}
+
+void cEditor_Item_Index :: Build( const std::string &dir )
+{
+	Clear();
+	m_dir = dir;
+
+	m_directories.push_back( dir );
+	m_directory_times.push_back( static_cast<unsigned int>(Get_File_Modification_Time( dir )) );
+
+	vector<std::string> files = Get_Directory_Files( dir, ".settings", 1 );
+
+	for( vector<std::string>::iterator itr = files.begin(), itr_end = files.end(); itr != itr_end; ++itr )
+	{
+		const std::string &filename = (*itr);
+
+		// directory
+		if( filename.length() < 9 || filename.compare( filename.length() - 9, 9, ".settings" ) != 0 )
+		{
+			m_directories.push_back( filename );
+			m_directory_times.push_back( static_cast<unsigned int>(Get_File_Modification_Time( filename )) );
+			continue;
+		}
+
+		cImage_settings_data *settings = pSettingsParser->Get( filename );
+
+		// not an editor item
+		if( !settings || settings->m_editor_tags.empty() )
+		{
+			delete settings;
+			continue;
+		}
+
+		cEditor_Image_Item item;
+		item.m_filename = filename;
+		item.m_size = static_cast<unsigned int>(Get_File_Size( filename ));
+		item.m_time = static_cast<unsigned int>(Get_File_Modification_Time( filename ));
+		item.m_editor_tags = settings->m_editor_tags;
+		item.m_name = settings->m_name;
+		item.m_type = settings->m_type;
+		item.m_width = settings->m_width;
+		item.m_height = settings->m_height;
+		item.m_rotation_x = settings->m_rotation_x;
+		item.m_rotation_y = settings->m_rotation_y;
+		item.m_rotation_z = settings->m_rotation_z;
+		delete settings;
+
+		Add_Item( item );
+	}
+}
+
+bool cEditor_Item_Index :: Load_Index( const std::string &dir )
+{
+	Clear();
+
+	ifstream ifs( Get_Index_Filename().c_str(), ios::in | ios::binary );
+
+	if( !ifs )
+	{
+		return 0;
+	}
+
+	// read the whole file
+	vector<char> data;
+	ifs.seekg( 0, ios::end );
+	data.resize( static_cast<size_t>(ifs.tellg()) );
+	ifs.seekg( 0, ios::beg );
+
+	if( data.size() < sizeof(editor_item_index_magic) || !ifs.read( &data[0], data.size() ) )
+	{
+		return 0;
+	}
+
+	ifs.close();
+
+	// check identifier
+	if( memcmp( &data[0], editor_item_index_magic, sizeof(editor_item_index_magic) ) != 0 )
+	{
+		return 0;
+	}
+
+	size_t pos = sizeof(editor_item_index_magic);
+	unsigned int version, dir_count, item_count;
+	std::string index_dir;
+
+	if( !Read_Uint( data, pos, version ) || version != editor_item_index_version || !Read_String( data, pos, index_dir ) || index_dir.compare( dir ) != 0 )
+	{
+		return 0;
+	}
+
+	// files were added or removed if a directory changed
+	if( !Read_Uint( data, pos, dir_count ) )
+	{
+		return 0;
+	}
+
+	for( unsigned int i = 0; i < dir_count; i++ )
+	{
+		std::string directory;
+		unsigned int time;
+
+		if( !Read_String( data, pos, directory ) || !Read_Uint( data, pos, time ) || time != static_cast<unsigned int>(Get_File_Modification_Time( directory )) )
+		{
+			Clear();
+			return 0;
+		}
+
+		m_directories.push_back( directory );
+		m_directory_times.push_back( time );
+	}
+
+	if( !Read_Uint( data, pos, item_count ) )
+	{
+		Clear();
+		return 0;
+	}
+
+	m_items.reserve( item_count );
+
+	for( unsigned int i = 0; i < item_count; i++ )
+	{
+		cEditor_Image_Item item;
+
+		bool valid = Read_String( data, pos, item.m_filename ) && Read_Uint( data, pos, item.m_size ) && Read_Uint( data, pos, item.m_time )
+			&& Read_String( data, pos, item.m_editor_tags ) && Read_String( data, pos, item.m_name ) && Read_Int( data, pos, item.m_type )
+			&& Read_Int( data, pos, item.m_width ) && Read_Int( data, pos, item.m_height )
+			&& Read_Int( data, pos, item.m_rotation_x ) && Read_Int( data, pos, item.m_rotation_y ) && Read_Int( data, pos, item.m_rotation_z );
+
+		// data ended or the settings changed
+		if( !valid || item.m_size != static_cast<unsigned int>(Get_File_Size( item.m_filename )) || item.m_time != static_cast<unsigned int>(Get_File_Modification_Time( item.m_filename )) )
+		{
+			Clear();
+			return 0;
+		}
+
+		Add_Item( item );
+	}
+
+	m_dir = dir;
+
+	return 1;
+}
+
+void cEditor_Item_Index :: Save_Index( void ) const
+{
+	std::string data( editor_item_index_magic, sizeof(editor_item_index_magic) );
+	Write_Uint( data, editor_item_index_version );
+	Write_String( data, m_dir );
+
+	Write_Uint( data, static_cast<unsigned int>(m_directories.size()) );
+
+	for( unsigned int i = 0; i < m_directories.size(); i++ )
+	{
+		Write_String( data, m_directories[i] );
+		Write_Uint( data, m_directory_times[i] );
+	}
+
+	Write_Uint( data, static_cast<unsigned int>(m_items.size()) );
+
+	for( EditorImageItemList::const_iterator itr = m_items.begin(), itr_end = m_items.end(); itr != itr_end; ++itr )
+	{
+		const cEditor_Image_Item &item = (*itr);
+
+		Write_String( data, item.m_filename );
+		Write_Uint( data, item.m_size );
+		Write_Uint( data, item.m_time );
+		Write_String( data, item.m_editor_tags );
+		Write_String( data, item.m_name );
+		Write_Uint( data, static_cast<unsigned int>(item.m_type) );
+		Write_Uint( data, static_cast<unsigned int>(item.m_width) );
+		Write_Uint( data, static_cast<unsigned int>(item.m_height) );
+		Write_Uint( data, static_cast<unsigned int>(item.m_rotation_x) );
+		Write_Uint( data, static_cast<unsigned int>(item.m_rotation_y) );
+		Write_Uint( data, static_cast<unsigned int>(item.m_rotation_z) );
+	}
+
+	// the image cache could be disabled
+	if( !Dir_Exists( pResource_Manager->user_data_dir + USER_IMGCACHE_DIR ) )
+	{
+		Create_Directory( pResource_Manager->user_data_dir + USER_IMGCACHE_DIR );
+	}
+
+	ofstream ofs( Get_Index_Filename().c_str(), ios::out | ios::binary | ios::trunc );
+
+	if( !ofs )
+	{
+		printf( "Warning : Couldn't save editor item index %s\n", Get_Index_Filename().c_str() );
+		return;
+	}
+
+	ofs.write( data.c_str(), data.length() );
+	ofs.close();
+}
+
+void cEditor_Item_Index :: Add_Item( const cEditor_Image_Item &item )
+{
+	const unsigned int item_num = static_cast<unsigned int>(m_items.size());
+	m_items.push_back( item );
+
+	cEditor_Image_Item &new_item = m_items.back();
+	Split_Tags( new_item.m_editor_tags, new_item.m_tags );
+
+	for( vector<std::string>::const_iterator itr = new_item.m_tags.begin(), itr_end = new_item.m_tags.end(); itr != itr_end; ++itr )
+	{
+		ItemNumList &item_nums = m_tag_items[*itr];
+
+		// tag is set multiple times
+		if( !item_nums.empty() && item_nums.back() == item_num )
+		{
+			continue;
+		}
+
+		item_nums.push_back( item_num );
+	}
+}
+
+std::string cEditor_Item_Index :: Get_Index_Filename( void ) const
+{
+	return pResource_Manager->user_data_dir + USER_IMGCACHE_DIR "/editor_items.idx";
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,126 @@
+/***************************************************************************
+ * editor_item_index.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_EDITOR_ITEM_INDEX_H
+#define SMC_EDITOR_ITEM_INDEX_H
+
+#include "../core/globals.h"
+#include "../video/gl_surface.h"
+#include <map>
+
+namespace SMC
+{
+
+/* *** *** *** *** *** *** cEditor_Image_Item *** *** *** *** *** *** *** *** *** *** *** */
+
+// Image with editor tags
+class cEditor_Image_Item
+{
+public:
+	cEditor_Image_Item( void );
+
+	// Return true if the item has the given tag
+	bool Has_Tag( const std::string &tag ) const;
+
+	// settings filename
+	std::string m_filename;
+	// settings file size and modification time
+	unsigned int m_size;
+	unsigned int m_time;
+
+	// editor tags
+	std::string m_editor_tags;
+	// editor tags split into single tags
+	vector<std::string> m_tags;
+	// name
+	std::string m_name;
+	// default sprite type
+	int m_type;
+	// image settings size ( 0 if not set )
+	int m_width, m_height;
+	// rotation
+	int m_rotation_x, m_rotation_y, m_rotation_z;
+};
+
+/* *** *** *** *** *** *** cEditor_Item_Index *** *** *** *** *** *** *** *** *** *** *** */
+
+// editor item index file version
+static const unsigned int editor_item_index_version = 2;
+
+/* Index of all images with editor tags
+ * Stored in the user image cache directory with the modification time of every
+ * directory and settings file. If any of them changed the directory is searched
+ * and the index saved again.
+ * The item list images are small thumbnails which are also stored in the user image cache directory.
+*/
+class cEditor_Item_Index
+{
+public:
+	cEditor_Item_Index( void );
+	~cEditor_Item_Index( void );
+
+	// Remove all items
+	void Clear( void );
+
+	/* Load the index of the given directory
+	 * if not available or outdated the directory is searched and the index is saved
+	*/
+	void Load( const std::string &dir );
+
+	// Add the items with all the given tags in the directory order
+	void Get_Items( const vector<std::string> &tags, vector<const cEditor_Image_Item *> &items ) const;
+
+	/* Return the thumbnail image of the item fitting in the given size
+	 * it is created from the image if not available or outdated
+	 * the image is managed by the image manager
+	*/
+	cGL_Surface *Get_Thumbnail( const cEditor_Image_Item *item, unsigned int max_width, unsigned int max_height ) const;
+
+private:
+	// Search the directory and add all images with editor tags
+	void Build( const std::string &dir );
+	/* Load the index file
+	 * returns false if not available or outdated
+	*/
+	bool Load_Index( const std::string &dir );
+	// Save the index file
+	void Save_Index( void ) const;
+	// Add the item to the items and the tag index
+	void Add_Item( const cEditor_Image_Item &item );
+
+	// Return the index filename
+	std::string Get_Index_Filename( void ) const;
+
+	typedef vector<cEditor_Image_Item> EditorImageItemList;
+	// items in the directory order
+	EditorImageItemList m_items;
+
+	typedef vector<unsigned int> ItemNumList;
+	typedef std::map<std::string, ItemNumList> TagItemMap;
+	// item numbers by tag
+	TagItemMap m_tag_items;
+
+	// indexed directory
+	std::string m_dir;
+	// directories with their modification time
+	vector<std::string> m_directories;
+	vector<unsigned int> m_directory_times;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
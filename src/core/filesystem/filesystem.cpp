@@ -114,6 +114,45 @@ size_t Get_File_Size( const std::string &filename )
 	return 0;
 }
 
+time_t Get_File_Modification_Time( const std::string &filename )
+{
+	struct stat file_info; 
+
+	// if file exists
+	if( stat( filename.c_str(), &file_info ) == 0 )
+	{
+		return file_info.st_mtime;
+	}
+
+	return 0;
+}
+
+void Get_File_Size_And_Time( const std::string &filename, size_t &size, time_t &modification_time )
+{
+	size = 0;
+	modification_time = 0;
+
+	struct stat file_info; 
+
+	// if file exists
+	if( stat( filename.c_str(), &file_info ) != 0 )
+	{
+		return;
+	}
+
+	modification_time = file_info.st_mtime;
+
+	// if regular file
+#ifdef _WIN32
+	if( (file_info.st_mode & S_IFREG) > 0 )
+#else
+	if( !S_ISDIR(file_info.st_mode) )
+#endif
+	{
+		size = file_info.st_size;
+	}
+}
+
 void Convert_Path_Separators( std::string &str )
 {
 	for( std::string::iterator itr = str.begin(); itr != str.end(); ++itr )
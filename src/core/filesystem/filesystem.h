@@ -44,6 +44,14 @@ bool Create_Directory( const std::string &dir );
 * returns 0 if the file does not exist
 */
 size_t Get_File_Size( const std::string &filename );
+/* Get the last modification time of the file
+* returns 0 if the file does not exist
+*/
+time_t Get_File_Modification_Time( const std::string &filename );
+/* Get the file size and last modification time with one file status request
+* both are 0 if the file does not exist
+*/
+void Get_File_Size_And_Time( const std::string &filename, size_t &size, time_t &modification_time );
 
 // Converts "\" and "!" to "/"
 void Convert_Path_Separators( std::string &str );
@@ -16,50 +16,16 @@
 #include "../core/globals.h"
 #include "../core/framerate.h"
 #include "../core/math/utilities.h"
+#include "../core/profiler.h"
+#include "../input/replay.h"
 // SDL
 #include "SDL.h"
 
 namespace SMC
 {
 
-/* *** *** *** *** *** *** cPerformance_Timer *** *** *** *** *** *** *** *** *** *** *** */
-
-cPerformance_Timer :: cPerformance_Timer( void )
-{
-	Reset();
-}
-
-cPerformance_Timer :: ~cPerformance_Timer( void )
-{
-
-}
-
-void cPerformance_Timer :: Reset( void )
-{
-	frame_counter = 0;
-	ms_counter = 0;
-	ms = 0;
-}
-
-void cPerformance_Timer :: Update( void )
-{
-	// count frame
-	frame_counter++;
-
-	// add milliseconds
-	Uint32 new_ticks = SDL_GetTicks();
-	ms_counter += new_ticks - pFramerate->m_perf_last_ticks;
-	pFramerate->m_perf_last_ticks = new_ticks;
-
-	// counted 100 frames
-	if( frame_counter >= 100 )
-	{
-		ms = ms_counter;
-		frame_counter = 0;
-		ms_counter = 0;
-	}
-}
-
+// maximum fixed timestep updates per frame
+static const unsigned int fixed_timestep_max_updates = 5;
 
 /* *** *** *** *** *** *** cFramerate *** *** *** *** *** *** *** *** *** *** *** */
 
@@ -73,26 +39,19 @@ cFramerate :: cFramerate( const float tfps /* = DESIRED_FPS */ )
 
 	m_force_speed_factor = 0.0f;
 
-	m_perf_last_ticks = 0;
+	m_fixed_timestep_rate = 0;
+	m_fixed_timestep_speed_factor = 1.0f;
+	m_fixed_timestep_alpha = 1.0f;
 
-	// create performance timers
-	for( unsigned int i = 0; i < 24; i++ )
-	{
-		m_perf_timer.push_back( new cPerformance_Timer() );
-	}
+	// 0 is used as unset time
+	m_game_ticks = 1;
 
 	Init( tfps );
 }
 
 cFramerate :: ~cFramerate( void )
 {
-	// clear performance timer
-	for( Performance_Timer_List::iterator itr = m_perf_timer.begin(), itr_end = m_perf_timer.end(); itr != itr_end; ++itr )
-	{
-		delete *itr;
-	}
 
-	m_perf_timer.clear();
 }
 
 void cFramerate :: Init( const float tfps )
@@ -140,6 +99,14 @@ void cFramerate :: Update( void )
 		m_speed_factor = static_cast<float>(m_elapsed_ticks / ( 1000 / m_fps_target ));
 	}
 
+	// record or replay the frame time
+	if( pReplay )
+	{
+		pReplay->Update_Frame( m_speed_factor, m_elapsed_ticks );
+	}
+
+	m_game_ticks += m_elapsed_ticks;
+
 	// speed factor based fps
 	m_fps = m_fps_target / m_speed_factor;
 	
@@ -181,11 +148,8 @@ void cFramerate :: Reset( void )
 	m_fps_average = 0;
 	m_frames_counted = 0;
 
-	// reset performance timer
-	for( Performance_Timer_List::iterator itr = m_perf_timer.begin(), itr_end = m_perf_timer.end(); itr != itr_end; ++itr )
-	{
-		(*itr)->Reset();
-	}
+	m_fixed_timestep_accumulator = 0;
+	m_fixed_timestep_last_time = Get_Profiler_Time();
 }
 
 void cFramerate :: Set_Max_Elapsed_Ticks( const Uint32 ticks )
@@ -198,6 +162,56 @@ void cFramerate :: Set_Fixed_Speedfacor( const float val )
 	m_force_speed_factor = val;
 }
 
+void cFramerate :: Set_Fixed_Timestep( unsigned int rate )
+{
+	m_fixed_timestep_rate = rate;
+	m_fixed_timestep_alpha = 1.0f;
+
+	if( rate )
+	{
+		m_fixed_timestep_speed_factor = m_fps_target / static_cast<float>(rate);
+	}
+
+	m_fixed_timestep_accumulator = 0;
+	m_fixed_timestep_last_time = Get_Profiler_Time();
+}
+
+unsigned int cFramerate :: Get_Fixed_Timestep_Updates( void )
+{
+	if( !m_fixed_timestep_rate )
+	{
+		m_fixed_timestep_alpha = 1.0f;
+		return 1;
+	}
+
+	const Uint64 step = 1000000000 / m_fixed_timestep_rate;
+	const Uint64 current_time = Get_Profiler_Time();
+
+	// the recorded frame time gives the same updates in a replay
+	if( pReplay && pReplay->Is_Active() )
+	{
+		m_fixed_timestep_accumulator += static_cast<Uint64>(m_elapsed_ticks) * 1000000;
+	}
+	else
+	{
+		m_fixed_timestep_accumulator += current_time - m_fixed_timestep_last_time;
+	}
+
+	m_fixed_timestep_last_time = current_time;
+
+	// drop the time of long frames instead of moving in too big steps
+	if( m_fixed_timestep_accumulator > step * fixed_timestep_max_updates )
+	{
+		m_fixed_timestep_accumulator = step * fixed_timestep_max_updates;
+	}
+
+	unsigned int updates = static_cast<unsigned int>(m_fixed_timestep_accumulator / step);
+	m_fixed_timestep_accumulator -= step * updates;
+	m_fixed_timestep_alpha = static_cast<float>(m_fixed_timestep_accumulator) / static_cast<float>(step);
+
+	return updates;
+}
+
 /* *** *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** */
 
 void Correct_Frame_Time( const unsigned int fps )
@@ -21,28 +21,8 @@
 namespace SMC
 {
 
-/* *** *** *** *** *** *** *** cPerformance_Timer *** *** *** *** *** *** *** *** *** *** */
-
-// counts milliseconds for 100 frames and sets them to ms
-class cPerformance_Timer
-{
-public:
-	cPerformance_Timer( void );
-	~cPerformance_Timer( void );
-
-	// reset
-	void Reset( void );
-
-	// Update and set new framerate ticks
-	void Update( void );
-
-	// current frame counter
-	Uint32 frame_counter;
-	// current milliseconds per frames counted
-	Uint32 ms_counter;
-	// milliseconds per 100 frames
-	Uint32 ms;
-};
+// a position change larger than this in one fixed timestep update is drawn without interpolation
+static const float fixed_timestep_interpolation_distance = 200.0f;
 
 /* *** *** *** *** *** *** *** cFramerate *** *** *** *** *** *** *** *** *** *** */
 
@@ -71,6 +51,16 @@ public:
 	*/
 	void Set_Fixed_Speedfacor( const float val );
 
+	/* Set the fixed timestep updates per second
+	 * if rate is 0 the game is updated once per frame with the measured speed factor
+	*/
+	void Set_Fixed_Timestep( unsigned int rate );
+	/* Return the number of fixed timestep updates for the time elapsed since the last call
+	 * and set the interpolation factor of the next drawn frame
+	 * elapsed time exceeding the maximum updates per frame is dropped
+	*/
+	unsigned int Get_Fixed_Timestep_Updates( void );
+
 	// target fps for speed factor calculations
 	float m_fps_target;
 	// current fps
@@ -94,6 +84,10 @@ public:
 	Uint32 m_elapsed_ticks;
 	// maximum elapsed ticks
 	Uint32 m_max_elapsed_ticks;
+	/* game time in milliseconds as sum of the elapsed ticks
+	 * same in a replay unlike SDL_GetTicks
+	 */
+	Uint32 m_game_ticks;
 
 	/* current factor
 	 * based on target fps
@@ -104,12 +98,18 @@ public:
 	// fixed speed factor value
 	float m_force_speed_factor;
 
-	// ## performance values ##
-	// ticks since last section
-	Uint32 m_perf_last_ticks;
-
-	typedef vector<cPerformance_Timer *> Performance_Timer_List;
-	Performance_Timer_List m_perf_timer;
+	// fixed timestep updates per second or 0 if disabled
+	unsigned int m_fixed_timestep_rate;
+	// speed factor of one fixed timestep update
+	float m_fixed_timestep_speed_factor;
+	/* position of the drawn frame between the last two updates
+	 * 0 is the previous and 1 the last update
+	*/
+	float m_fixed_timestep_alpha;
+	// elapsed time not yet updated in nanoseconds
+	Uint64 m_fixed_timestep_accumulator;
+	// time of the last update count in nanoseconds
+	Uint64 m_fixed_timestep_last_time;
 };
 
 /* *** *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** */
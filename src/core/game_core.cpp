@@ -21,6 +21,7 @@
 #include "../input/keyboard.h"
 #include "../input/mouse.h"
 #include "../input/joystick.h"
+#include "../input/replay.h"
 #include "../level/level_editor.h"
 #include "../overworld/world_editor.h"
 #include "../player/player.h"
@@ -623,7 +624,7 @@ std::string Time_to_String( time_t t, const char *format )
 
 void Clear_Input_Events( void )
 {
-	while( SDL_PollEvent( &input_event ) )
+	while( pReplay->Poll_Event( &input_event ) )
 	{
 		// todo : keep Windowmanager quit events ?
 		// ignore all events
@@ -1213,7 +1214,7 @@ void Draw_Static_Text( const std::string &text, const Color *color_text /* = &wh
 
 		if( wait_for_input )
 		{
-			while( SDL_PollEvent( &input_event ) )
+			while( pReplay->Poll_Event( &input_event ) )
 			{
 				if( input_event.type == SDL_KEYDOWN || input_event.type == SDL_JOYBUTTONDOWN || input_event.type == SDL_MOUSEBUTTONDOWN )
 				{
@@ -1376,29 +1377,8 @@ void Preload_Images( bool draw_gui /* = 0 */ )
 	image_files.push_back( "game/gold_m.png" );
 	image_files.push_back( "game/itembox.png" );
 
-	unsigned int loaded_files = 0;
-	unsigned int file_count = image_files.size();
-
 	// load images
-	for( vector<std::string>::iterator itr = image_files.begin(), itr_end = image_files.end(); itr != itr_end; ++itr )
-	{
-		// get filename
-		std::string filename = (*itr);
-
-		// preload image
-		pVideo->Get_Surface( filename );
-
-		// count files
-		loaded_files++;
-
-		if( draw_gui )
-		{
-			// update progress
-			progress_bar->setProgress( static_cast<float>(loaded_files) / static_cast<float>(file_count) );
-
-			Loading_Screen_Draw();
-		}
-	}
+	pVideo->Load_Surfaces( image_files, progress_bar );
 }
 
 void Preload_Sounds( bool draw_gui /* = 0 */ )
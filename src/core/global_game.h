@@ -358,42 +358,54 @@ enum ball_effect
 
 /* *** Performance timer types ***  */
 
-enum performance_timer_type
+enum performance_zone_type
 {
+	// frame
+	PERF_UPDATE_GAME,
+	PERF_DRAW_GAME,
+	PERF_RENDER,
 	// update
-	PERF_UPDATE_PROCESS_INPUT = 0,
-	PERF_UPDATE_LEVEL = 1,
-	PERF_UPDATE_LEVEL_EDITOR = 2,
-	PERF_UPDATE_HUD = 3,
-	PERF_UPDATE_PLAYER = 4,
-	PERF_UPDATE_PLAYER_COLLISIONS = 23,
-	PERF_UPDATE_LATE_LEVEL = 22,
-	PERF_UPDATE_LEVEL_COLLISIONS = 5,
-	PERF_UPDATE_CAMERA = 6,
+	PERF_UPDATE_PROCESS_INPUT,
+	PERF_UPDATE_LEVEL,
+	PERF_UPDATE_LEVEL_EDITOR,
+	PERF_UPDATE_HUD,
+	PERF_UPDATE_PLAYER,
+	PERF_UPDATE_PLAYER_COLLISIONS,
+	PERF_UPDATE_LATE_LEVEL,
+	PERF_UPDATE_LEVEL_COLLISIONS,
+	PERF_UPDATE_CAMERA,
 	// update overworld
-	PERF_UPDATE_OVERWORLD = 17,
+	PERF_UPDATE_OVERWORLD,
 	// update menu
-	PERF_UPDATE_MENU = 18,
+	PERF_UPDATE_MENU,
 	// update level settings
-	PERF_UPDATE_LEVEL_SETTINGS = 19,
+	PERF_UPDATE_LEVEL_SETTINGS,
+	// sprite manager
+	PERF_SPRITES_UPDATE,
+	PERF_SPRITES_COLLISIONS,
 	// draw level
-	PERF_DRAW_LEVEL_LAYER1 = 7,
-	PERF_DRAW_LEVEL_PLAYER = 8,
-	PERF_DRAW_LEVEL_LAYER2 = 9,
-	PERF_DRAW_LEVEL_HUD = 10,
-	PERF_DRAW_LEVEL_EDITOR = 11,
+	PERF_DRAW_LEVEL_LAYER1,
+	PERF_DRAW_LEVEL_PLAYER,
+	PERF_DRAW_LEVEL_LAYER2,
+	PERF_DRAW_LEVEL_HUD,
+	PERF_DRAW_LEVEL_EDITOR,
 	// draw overworld
-	PERF_DRAW_OVERWORLD = 16,
+	PERF_DRAW_OVERWORLD,
 	// draw menu
-	PERF_DRAW_MENU = 14,
+	PERF_DRAW_MENU,
 	// draw level settings
-	PERF_DRAW_LEVEL_SETTINGS = 15,
+	PERF_DRAW_LEVEL_SETTINGS,
 	// draw
-	PERF_DRAW_MOUSE = 12,
+	PERF_DRAW_MOUSE,
 	// rendering
-	PERF_RENDER_GAME = 13,
-	PERF_RENDER_GUI = 20,
-	PERF_RENDER_BUFFER = 21
+	PERF_RENDER_GAME,
+	PERF_RENDER_GUI,
+	PERF_RENDER_BUFFER,
+	PERF_RENDER_QUEUE,
+	// loading
+	PERF_LEVEL_LOAD,
+	// number of zones
+	PERF_ZONE_COUNT
 };
 
 /* *** Classes ***  */
@@ -409,6 +421,7 @@ class cLevel;
 class cLine_collision;
 class cLine_Request;
 class cLevel_Settings;
+class cLevel_Snapshot;
 class cMenu_Base;
 class cObjectCollisionType;
 class cObjectCollision;
@@ -424,6 +437,7 @@ class cSize_Float;
 class cSize_Int;
 class cSprite_Manager;
 class cSurface_Request;
+class cSurface_List_Request;
 class cSprite;
 class cWorld_Sprite_Manager;
 class Color;
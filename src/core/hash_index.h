@@ -0,0 +1,180 @@
+/***************************************************************************
+ * hash_index.h  -  string hash index template
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_HASH_INDEX_H
+#define SMC_HASH_INDEX_H
+
+#include "../core/global_basic.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cHash_Index *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Return the FNV-1a hash of the given string
+inline unsigned int Get_String_Hash( const std::string &str )
+{
+	unsigned int hash = 2166136261u;
+
+	for( std::string::const_iterator itr = str.begin(), itr_end = str.end(); itr != itr_end; ++itr )
+	{
+		hash ^= static_cast<unsigned char>(*itr);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/* Maps a string key to an object pointer
+ * Only the first added object is stored for a key.
+ * The objects are not owned by the index.
+*/
+template<class T> class cHash_Index
+{
+public:
+	cHash_Index( void )
+	{
+		m_count = 0;
+	}
+
+	~cHash_Index( void ) {};
+
+	/* Add the object with the given key
+	 * returns false if the key is already used
+	*/
+	bool Add( const std::string &key, T *obj )
+	{
+		if( Get( key ) )
+		{
+			return 0;
+		}
+
+		// grow if the buckets are full
+		if( m_count >= m_buckets.size() )
+		{
+			Resize( m_buckets.empty() ? 64 : m_buckets.size() * 2 );
+		}
+
+		m_buckets[Get_Bucket( key )].push_back( cEntry( key, obj ) );
+		m_count++;
+
+		return 1;
+	}
+
+	/* Remove the given object
+	 * returns false if it was not stored with the key
+	*/
+	bool Remove( const std::string &key, const T *obj )
+	{
+		if( m_buckets.empty() )
+		{
+			return 0;
+		}
+
+		EntryList &bucket = m_buckets[Get_Bucket( key )];
+
+		for( typename EntryList::iterator itr = bucket.begin(), itr_end = bucket.end(); itr != itr_end; ++itr )
+		{
+			if( (*itr).obj == obj && (*itr).key.compare( key ) == 0 )
+			{
+				bucket.erase( itr );
+				m_count--;
+				return 1;
+			}
+		}
+
+		return 0;
+	}
+
+	/* Return the object with the given key
+	 * if not found returns NULL
+	*/
+	T *Get( const std::string &key ) const
+	{
+		if( m_buckets.empty() )
+		{
+			return NULL;
+		}
+
+		const EntryList &bucket = m_buckets[Get_Bucket( key )];
+
+		for( typename EntryList::const_iterator itr = bucket.begin(), itr_end = bucket.end(); itr != itr_end; ++itr )
+		{
+			if( (*itr).key.compare( key ) == 0 )
+			{
+				return (*itr).obj;
+			}
+		}
+
+		return NULL;
+	}
+
+	// Remove all entries
+	void Clear( void )
+	{
+		m_buckets.clear();
+		m_count = 0;
+	}
+
+	// Return the entry count
+	size_t size( void ) const
+	{
+		return m_count;
+	}
+
+private:
+	struct cEntry
+	{
+		cEntry( const std::string &nkey, T *nobj )
+		: key( nkey ), obj( nobj ) {};
+
+		std::string key;
+		T *obj;
+	};
+
+	typedef vector<cEntry> EntryList;
+
+	// Return the bucket of the key
+	size_t Get_Bucket( const std::string &key ) const
+	{
+		// bucket count is always a power of 2
+		return Get_String_Hash( key ) & ( m_buckets.size() - 1 );
+	}
+
+	// Set a new bucket count and move all entries
+	void Resize( size_t bucket_count )
+	{
+		vector<EntryList> old_buckets;
+		old_buckets.swap( m_buckets );
+		m_buckets.resize( bucket_count );
+
+		for( typename vector<EntryList>::iterator itr = old_buckets.begin(), itr_end = old_buckets.end(); itr != itr_end; ++itr )
+		{
+			for( typename EntryList::iterator entry = (*itr).begin(), entry_end = (*itr).end(); entry != entry_end; ++entry )
+			{
+				m_buckets[Get_Bucket( (*entry).key )].push_back( *entry );
+			}
+		}
+	}
+
+	vector<EntryList> m_buckets;
+	size_t m_count;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
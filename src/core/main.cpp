@@ -21,6 +21,7 @@
 #include "../level/level.h"
 #include "../gui/menu.h"
 #include "../core/framerate.h"
+#include "../core/profiler.h"
 #include "../video/font.h"
 #include "../user/preferences.h"
 #include "../audio/sound_manager.h"
@@ -33,10 +34,14 @@
 #include "../input/mouse.h"
 #include "../user/savegame.h"
 #include "../input/keyboard.h"
+#include "../input/replay.h"
 #include "../video/renderer.h"
 #include "../objects/level_exit.h"
 #include "../core/i18n.h"
 #include "../gui/menu_data.h"
+#include "../level/level_binary.h"
+#include "../level/level_preloader.h"
+#include "../core/benchmark.h"
 #ifdef __APPLE__
 // needed for datapath detection
 #include <CoreFoundation/CoreFoundation.h>
@@ -99,6 +104,11 @@ int main( int argc, char **argv )
 
 	// convert arguments to a vector string
 	vector<std::string> arguments( argv, argv + argc );
+	// frames to update per level in benchmark mode
+	unsigned int benchmark_frames = 1000;
+	// input recording and replay files
+	std::string record_filename;
+	std::string replay_filename;
 
 	if( argc >= 2 )
 	{
@@ -114,6 +124,13 @@ int main( int argc, char **argv )
 				printf( "-d, --debug\tEnable debug modes with the options : game performance\n" );
 				printf( "-l, --level\tLoad the given level\n" );
 				printf( "-w, --world\tLoad the given world\n" );
+				printf( "-c, --convert-levels\tCompile all levels for faster loading and exit\n" );
+				printf( "-y, --verify-levels\tCompare all levels with their compiled levels and exit\n" );
+				printf( "-i, --index-image-settings\tSave the parsed settings of all images for faster loading and exit\n" );
+				printf( "-b, --benchmark\tUpdate the given level or all levels without a screen, print the update times and exit\n" );
+				printf( "-f, --frames\tNumber of frames to update per level in benchmark mode\n" );
+				printf( "-r, --record\tRecord the input of the session into the given file\n" );
+				printf( "-p, --replay\tReplay the session recorded in the given file and exit\n" );
 				return EXIT_SUCCESS;
 			}
 			// version
@@ -164,6 +181,60 @@ int main( int argc, char **argv )
 			{
 				// skip
 			}
+			// level compiling is handled later
+			else if( arguments[i] == "--convert-levels" || arguments[i] == "-c" )
+			{
+				// skip
+			}
+			// compiled level verifying is handled later
+			else if( arguments[i] == "--verify-levels" || arguments[i] == "-y" )
+			{
+				// skip
+			}
+			// image settings indexing is handled later
+			else if( arguments[i] == "--index-image-settings" || arguments[i] == "-i" )
+			{
+				// skip
+			}
+			// benchmark is handled later
+			else if( arguments[i] == "--benchmark" || arguments[i] == "-b" )
+			{
+				// skip
+			}
+			// benchmark frames
+			else if( arguments[i] == "--frames" || arguments[i] == "-f" )
+			{
+				// no value
+				if( i + 1 >= arguments.size() || string_to_int( arguments[i + 1] ) <= 0 )
+				{
+					printf( "%s requires a frame count\n", arguments[i].c_str() );
+					return EXIT_FAILURE;
+				}
+
+				benchmark_frames = string_to_int( arguments[i + 1] );
+				i++;
+			}
+			// input recording or replay
+			else if( arguments[i] == "--record" || arguments[i] == "-r" || arguments[i] == "--replay" || arguments[i] == "-p" )
+			{
+				// no value
+				if( i + 1 >= arguments.size() || arguments[i + 1].empty() )
+				{
+					printf( "%s requires a filename\n", arguments[i].c_str() );
+					return EXIT_FAILURE;
+				}
+
+				if( arguments[i] == "--record" || arguments[i] == "-r" )
+				{
+					record_filename = arguments[i + 1];
+				}
+				else
+				{
+					replay_filename = arguments[i + 1];
+				}
+
+				i++;
+			}
 			// unknown argument
 			else if( arguments[i].substr( 0, 1 ) == "-" )
 			{
@@ -173,10 +244,13 @@ int main( int argc, char **argv )
 		}
 	}
 
+	// benchmark without a screen
+	bool benchmark = argc > 2 && ( arguments[1] == "--benchmark" || arguments[1] == "-b" ) && !arguments[2].empty();
+
 	try
 	{
 		// initialize everything
-		Init_Game();
+		Init_Game( benchmark );
 	}
 	catch( const std::exception &e )
 	{
@@ -184,14 +258,99 @@ int main( int argc, char **argv )
 		return EXIT_FAILURE;
 	}
 
+	// command line level compiling
+	if( argc > 1 && ( arguments[1] == "--convert-levels" || arguments[1] == "-c" ) )
+	{
+		unsigned int count = Convert_Level_Directory( DATA_DIR "/" GAME_LEVEL_DIR );
+		count += Convert_Level_Directory( pResource_Manager->user_data_dir + USER_LEVEL_DIR );
+		printf( "Compiled %u levels\n", count );
+
+		Exit_Game();
+		return EXIT_SUCCESS;
+	}
+
+	// command line compiled level verifying
+	if( argc > 1 && ( arguments[1] == "--verify-levels" || arguments[1] == "-y" ) )
+	{
+		unsigned int failed = Verify_Level_Directory( DATA_DIR "/" GAME_LEVEL_DIR );
+		failed += Verify_Level_Directory( pResource_Manager->user_data_dir + USER_LEVEL_DIR );
+		printf( "%u levels differ from their compiled levels\n", failed );
+
+		Exit_Game();
+		return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	// command line image settings indexing
+	if( argc > 1 && ( arguments[1] == "--index-image-settings" || arguments[1] == "-i" ) )
+	{
+		unsigned int count = pSettingsParser->Build_Index( DATA_DIR "/" GAME_PIXMAPS_DIR );
+		pSettingsParser->Save_Index( Get_Image_Settings_Index_Filename() );
+		printf( "Indexed %u image settings\n", count );
+
+		Exit_Game();
+		return EXIT_SUCCESS;
+	}
+
+	// command line benchmark
+	if( benchmark )
+	{
+		cBenchmark level_benchmark( benchmark_frames );
+
+		// all game levels
+		if( arguments[2] == "all" )
+		{
+			unsigned int count = level_benchmark.Run_Directory( DATA_DIR "/" GAME_LEVEL_DIR );
+			printf( "Benchmarked %u levels\n", count );
+		}
+		else if( !level_benchmark.Run_Level( arguments[2] ) )
+		{
+			printf( "Error : Could not benchmark level %s\n", arguments[2].c_str() );
+		}
+
+		std::string csv_filename = pResource_Manager->user_data_dir + "benchmark.csv";
+
+		if( level_benchmark.Save_CSV( csv_filename ) )
+		{
+			printf( "Saved benchmark frames to %s\n", csv_filename.c_str() );
+		}
+
+		Exit_Game();
+		return EXIT_SUCCESS;
+	}
+
+	// command line level
+	std::string start_level;
+
+	if( argc > 2 && ( arguments[1] == "--level" || arguments[1] == "-l" ) )
+	{
+		start_level = arguments[2];
+	}
+
+	// command line input replay starts with the recorded level
+	if( !replay_filename.empty() )
+	{
+		if( !pReplay->Start_Replay( replay_filename ) )
+		{
+			Exit_Game();
+			return EXIT_FAILURE;
+		}
+
+		start_level = pReplay->m_level;
+	}
+	// command line input recording
+	else if( !record_filename.empty() )
+	{
+		pReplay->Start_Recording( record_filename, start_level );
+	}
+
 	// command line level loading
-	if( argc > 2 && ( arguments[1] == "--level" || arguments[1] == "-l" ) && !arguments[2].empty() )
+	if( !start_level.empty() )
 	{
 		// set start menu active
 		pMenuCore->Load( MENU_START );
 		// enter level
 		Game_Action = GA_ENTER_LEVEL;
-		Game_Action_Data.add( "level", arguments[2] );
+		Game_Action_Data.add( "level", start_level );
 	}
 	// command line world loading
 	else if( argc > 2 && ( arguments[1] == "--world" || arguments[1] == "-w" ) && !arguments[2].empty() )
@@ -213,16 +372,42 @@ int main( int argc, char **argv )
 	// game loop
 	while( !game_exit )
 	{
-		// update
-		Update_Game();
-		// draw
-		Draw_Game();
+		// profile only in performance debug mode
+		pProfiler->m_enabled = game_debug_performance;
+		pProfiler->Begin_Frame();
 
-		// render
-		pVideo->Render();
+		if( pFramerate->m_fixed_timestep_rate )
+		{
+			// update
+			Update_Game_Fixed_Timestep();
+			// load the prefetched textures
+			pImage_Manager->Load_Queued_Textures();
+			// draw and render between the last two updates
+			Begin_Interpolation();
+			Draw_Game();
+			pVideo->Render();
+			End_Interpolation();
+		}
+		else
+		{
+			// update
+			Update_Game();
+			// load the prefetched textures
+			pImage_Manager->Load_Queued_Textures();
+			// draw
+			Draw_Game();
+
+			// render
+			pVideo->Render();
+		}
+
+		// unload unused textures over the budget
+		pImage_Manager->Update_Residency();
 
 		// update speedfactor
 		pFramerate->Update();
+
+		pProfiler->End_Frame();
 	}
 
 	// exit
@@ -235,7 +420,14 @@ int main( int argc, char **argv )
 namespace SMC
 {
 
-void Init_Game( void )
+// objects and current positions while drawing interpolated positions
+static cSprite_Manager *interpolated_sprite_manager = NULL;
+static cSprite *interpolated_player = NULL;
+static float player_pos_x = 0.0f;
+static float player_pos_y = 0.0f;
+static cCamera *interpolated_camera = NULL;
+
+void Init_Game( bool headless /* = 0 */ )
 {
 	// init random number generator
 	srand( static_cast<unsigned int>(time( NULL )) );
@@ -246,6 +438,10 @@ void Init_Game( void )
 	pAudio = new cAudio();
 	pFont = new cFont_Manager();
 	pFramerate = new cFramerate();
+	pProfiler = new cProfiler();
+	pReplay = new cReplay();
+	// also profile loading a level from the command line
+	pProfiler->m_enabled = game_debug_performance;
 	pRenderer = new cRenderQueue( 200 );
 	pRenderer_GUI = new cRenderQueue( 5 );
 	pPreferences = new cPreferences();
@@ -253,6 +449,9 @@ void Init_Game( void )
 	pSound_Manager = new cSound_Manager();
 	pSettingsParser = new cImage_settings();
 
+	// without screen
+	pVideo->m_headless = headless;
+
 	// Init Stage 2 - set preferences and init audio and the video screen
 	/* Set default user directory
 	 * can get overridden later from the preferences
@@ -271,18 +470,37 @@ void Init_Game( void )
 	// init translation support
 	I18N_Init();
 	// delete CEGUI System fake
-	pVideo->Delete_CEGUI_Fake();
+	if( !headless )
+	{
+		pVideo->Delete_CEGUI_Fake();
+	}
 
 	// init user dir directory
 	pResource_Manager->Init_User_Directory();
+	// parsed image settings if indexed
+	pSettingsParser->Load_Index( Get_Image_Settings_Index_Filename() );
 	// video init
 	pVideo->Init_SDL();
-	pVideo->Init_Video();
-	pVideo->Init_CEGUI();
+
+	if( headless )
+	{
+		// keep the CEGUI System fake for the GUI
+		pVideo->Init_CEGUI_Headless();
+		pVideo->Init_Resolution_Scale();
+	}
+	else
+	{
+		pVideo->Init_Video();
+		pVideo->Init_CEGUI();
+	}
+
 	pVideo->Init_CEGUI_Data();
 	pFont->Init();
 	// audio init
-	pAudio->Init();
+	if( !headless )
+	{
+		pAudio->Init();
+	}
 
 	pPlayer = new cPlayer();
 	// set the first active player available
@@ -296,10 +514,13 @@ void Init_Game( void )
 	// apply preferences
 	pPreferences->Apply();
 
-	// draw generic loading screen
-	Loading_Screen_Init();
-	// initialize image cache
-	pVideo->Init_Image_Cache( 0, 1 );
+	if( !headless )
+	{
+		// draw generic loading screen
+		Loading_Screen_Init();
+		// initialize image cache
+		pVideo->Init_Image_Cache( 0, 1 );
+	}
 
 	// Init Stage 3 - game classes
 	pPlayer->Init();
@@ -317,20 +538,37 @@ void Init_Game( void )
 	pMenuCore = new cMenuCore();
 
 	pSavegame = new cSavegame();
+	pLevel_Preloader = new cLevel_Preloader();
 
 	// cache
-	Preload_Images( 1 );
-	Preload_Sounds( 1 );
-	Loading_Screen_Exit();
+	if( !headless )
+	{
+		Preload_Images( 1 );
+		Preload_Sounds( 1 );
+		Loading_Screen_Exit();
+	}
 }
 
 void Exit_Game( void )
 {
+	// save the recorded performance data
+	if( pProfiler && game_debug_performance )
+	{
+		pProfiler->Save();
+	}
+
 	if( pPreferences )
 	{
 		pPreferences->Save();
 	}
 
+	// save the recorded input
+	if( pReplay )
+	{
+		delete pReplay;
+		pReplay = NULL;
+	}
+
 	pLevel_Manager->Unload();
 	pMenuCore->handler->m_level->Unload();
 
@@ -388,6 +626,12 @@ void Exit_Game( void )
 		pSavegame = NULL;
 	}
 
+	if( pLevel_Preloader )
+	{
+		delete pLevel_Preloader;
+		pLevel_Preloader = NULL;
+	}
+
 	if( pMouseCursor )
 	{
 		delete pMouseCursor;
@@ -442,6 +686,12 @@ void Exit_Game( void )
 		pRenderer_GUI = NULL;
 	}
 
+	// the CEGUI System fake was kept
+	if( pGuiSystem && pVideo->m_headless )
+	{
+		pVideo->Delete_CEGUI_Fake();
+	}
+
 	if( pGuiSystem )
 	{
 		delete pGuiSystem;
@@ -484,6 +734,12 @@ void Exit_Game( void )
 		pResource_Manager = NULL;
 	}
 
+	if( pProfiler )
+	{
+		delete pProfiler;
+		pProfiler = NULL;
+	}
+
 	char *last_sdl_error = SDL_GetError();
 	if( strlen( last_sdl_error ) > 0 )
 	{
@@ -627,6 +883,8 @@ void Update_Game( void )
 		return;
 	}
 
+	cProfiler_Zone zone( PERF_UPDATE_GAME );
+
 	// ## game events
 	// level mode
 	if( Game_Mode == MODE_LEVEL )
@@ -1084,7 +1342,7 @@ void Update_Game( void )
 	}
 
 	// ## input
-	while( SDL_PollEvent( &input_event ) )
+	while( pReplay->Poll_Event( &input_event ) )
 	{
 		// handle
 		Handle_Input_Global( &input_event );
@@ -1096,173 +1354,195 @@ void Update_Game( void )
 	pAudio->Resume_Music();
 	pAudio->Update();
 
-	// performance measuring
-	pFramerate->m_perf_last_ticks = SDL_GetTicks();
-
 	// ## update
 	if( Game_Mode == MODE_LEVEL )
 	{
 		// input
+		pProfiler->Begin_Zone( PERF_UPDATE_PROCESS_INPUT );
 		pActive_Level->Process_Input();
 		pLevel_Editor->Process_Input();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_PROCESS_INPUT]->Update();
+		pProfiler->End_Zone();
 
 		// update
+		pProfiler->Begin_Zone( PERF_UPDATE_LEVEL );
 		pActive_Level->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_LEVEL]->Update();
+		pProfiler->End_Zone();
 
 		// editor
+		pProfiler->Begin_Zone( PERF_UPDATE_LEVEL_EDITOR );
 		pLevel_Editor->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_LEVEL_EDITOR]->Update();
+		pProfiler->End_Zone();
 
 		// hud
+		pProfiler->Begin_Zone( PERF_UPDATE_HUD );
 		pHud_Manager->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_HUD]->Update();
+		pProfiler->End_Zone();
 
 		// player
+		pProfiler->Begin_Zone( PERF_UPDATE_PLAYER );
 		pPlayer->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_PLAYER]->Update();
+		pProfiler->End_Zone();
 
 		// player collisions
+		pProfiler->Begin_Zone( PERF_UPDATE_PLAYER_COLLISIONS );
+
 		if( !editor_enabled )
 		{
 			pPlayer->Collide_Move();
 			pPlayer->Handle_Collisions();
 		}
 
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_PLAYER_COLLISIONS]->Update();
+		pProfiler->End_Zone();
 
 		// late update for level objects
+		pProfiler->Begin_Zone( PERF_UPDATE_LATE_LEVEL );
 		pActive_Level->Update_Late();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_LATE_LEVEL]->Update();
+		pProfiler->End_Zone();
 
 		// level collisions
+		pProfiler->Begin_Zone( PERF_UPDATE_LEVEL_COLLISIONS );
+
 		if( !editor_enabled )
 		{
 			pActive_Sprite_Manager->Handle_Collision_Items();
 		}
 
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_LEVEL_COLLISIONS]->Update();
+		pProfiler->End_Zone();
 
 		// Camera ( update after new player position was set )
+		pProfiler->Begin_Zone( PERF_UPDATE_CAMERA );
 		pActive_Camera->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_CAMERA]->Update();
-
+		pProfiler->End_Zone();
 	}
 	else if( Game_Mode == MODE_OVERWORLD )
 	{
+		pProfiler->Begin_Zone( PERF_UPDATE_OVERWORLD );
 		pActive_Overworld->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_OVERWORLD]->Update();
+		pProfiler->End_Zone();
 	}
 	else if( Game_Mode == MODE_MENU )
 	{
+		pProfiler->Begin_Zone( PERF_UPDATE_MENU );
 		pMenuCore->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_MENU]->Update();
+		pProfiler->End_Zone();
 	}
 	else if( Game_Mode == MODE_LEVEL_SETTINGS )
 	{
+		pProfiler->Begin_Zone( PERF_UPDATE_LEVEL_SETTINGS );
 		pLevel_Editor->pSettings->Update();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_UPDATE_LEVEL_SETTINGS]->Update();
+		pProfiler->End_Zone();
 	}
 
 	// gui
 	Gui_Handle_Time();
 }
 
+void Update_Game_Fixed_Timestep( void )
+{
+	const unsigned int updates = pFramerate->Get_Fixed_Timestep_Updates();
+
+	for( unsigned int i = 0; i < updates && !game_exit; i++ )
+	{
+		// positions before the update for interpolation
+		pActive_Sprite_Manager->Save_Tick_Positions();
+		pActive_Player->m_tick_pos_x = pActive_Player->m_pos_x;
+		pActive_Player->m_tick_pos_y = pActive_Player->m_pos_y;
+		pActive_Camera->Save_Tick_Pos();
+
+		// constant speed factor
+		pFramerate->m_speed_factor = pFramerate->m_fixed_timestep_speed_factor;
+
+		Update_Game();
+	}
+}
+
+void Begin_Interpolation( void )
+{
+	const float alpha = pFramerate->m_fixed_timestep_alpha;
+
+	interpolated_sprite_manager = pActive_Sprite_Manager;
+	interpolated_sprite_manager->Set_Interpolated_Positions( alpha );
+
+	interpolated_player = pActive_Player;
+	player_pos_x = interpolated_player->m_pos_x;
+	player_pos_y = interpolated_player->m_pos_y;
+	interpolated_player->Set_Interpolated_Pos( alpha );
+
+	interpolated_camera = pActive_Camera;
+	interpolated_camera->Set_Interpolated_Pos( alpha );
+}
+
+void End_Interpolation( void )
+{
+	interpolated_sprite_manager->Restore_Positions();
+
+	interpolated_player->m_pos_x = player_pos_x;
+	interpolated_player->m_pos_y = player_pos_y;
+
+	interpolated_camera->Restore_Pos();
+}
+
 void Draw_Game( void )
 {
-	// don't draw if exiting
-	if( game_exit )
+	// don't draw if exiting or without screen
+	if( game_exit || pVideo->m_headless )
 	{
 		return;
 	}
 
-	// performance measuring
-	pFramerate->m_perf_last_ticks = SDL_GetTicks();
+	cProfiler_Zone zone( PERF_DRAW_GAME );
 
 	if( Game_Mode == MODE_LEVEL )
 	{
 		// draw level layer 1
+		pProfiler->Begin_Zone( PERF_DRAW_LEVEL_LAYER1 );
 		pActive_Level->Draw_Layer_1();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_LEVEL_LAYER1]->Update();
+		pProfiler->End_Zone();
 
 		// player draw
+		pProfiler->Begin_Zone( PERF_DRAW_LEVEL_PLAYER );
 		pPlayer->Draw();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_LEVEL_PLAYER]->Update();
+		pProfiler->End_Zone();
 
 		// draw level layer 2
+		pProfiler->Begin_Zone( PERF_DRAW_LEVEL_LAYER2 );
 		pActive_Level->Draw_Layer_2();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_LEVEL_LAYER2]->Update();
+		pProfiler->End_Zone();
 
 		// hud
+		pProfiler->Begin_Zone( PERF_DRAW_LEVEL_HUD );
 		pHud_Manager->Draw();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_LEVEL_HUD]->Update();
+		pProfiler->End_Zone();
 
 		// level editor
+		pProfiler->Begin_Zone( PERF_DRAW_LEVEL_EDITOR );
 		pLevel_Editor->Draw();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_LEVEL_EDITOR]->Update();
-
+		pProfiler->End_Zone();
 	}
 	else if( Game_Mode == MODE_OVERWORLD )
 	{
 		// world
+		pProfiler->Begin_Zone( PERF_DRAW_OVERWORLD );
 		pActive_Overworld->Draw();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_OVERWORLD]->Update();
+		pProfiler->End_Zone();
 	}
 	else if( Game_Mode == MODE_MENU )
 	{
+		pProfiler->Begin_Zone( PERF_DRAW_MENU );
 		pMenuCore->Draw();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_MENU]->Update();
+		pProfiler->End_Zone();
 	}
 	else if( Game_Mode == MODE_LEVEL_SETTINGS )
 	{
+		pProfiler->Begin_Zone( PERF_DRAW_LEVEL_SETTINGS );
 		pLevel_Editor->pSettings->Draw();
-
-		// update performance timer
-		pFramerate->m_perf_timer[PERF_DRAW_LEVEL_SETTINGS]->Update();
+		pProfiler->End_Zone();
 	}
 
 	// Mouse
+	pProfiler->Begin_Zone( PERF_DRAW_MOUSE );
 	pMouseCursor->Draw();
-
-	// update performance timer
-	pFramerate->m_perf_timer[PERF_DRAW_MOUSE]->Update();
+	pProfiler->End_Zone();
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
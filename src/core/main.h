@@ -23,9 +23,11 @@ namespace SMC
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
-// Initialize everything, called before everything else
-// Seed random numbers, init SDL, OpenGL, CEGUI, load preferences, and create globals
-void Init_Game( void );
+/* Initialize everything, called before everything else
+ * Seed random numbers, init SDL, OpenGL, CEGUI, load preferences, and create globals
+ * headless : if set no screen, OpenGL or audio is initialized and the CEGUI fake is kept ( benchmark mode )
+*/
+void Init_Game( bool headless = 0 );
 
 // Save preferences, delete globals, and closes SDL
 void Exit_Game( void );
@@ -42,6 +44,17 @@ bool Handle_Input_Global( SDL_Event *ev );
 */
 void Update_Game( void );
 
+/* Update the game with fixed timesteps for the elapsed time
+ * Should be called continuously from Game Loop instead of Update_Game if fixed timestep is enabled.
+*/
+void Update_Game_Fixed_Timestep( void );
+/* Move the sprites and camera for drawing between the last two fixed timestep updates
+ * End_Interpolation must be called after rendering
+*/
+void Begin_Interpolation( void );
+// Restore the current sprite and camera positions
+void End_Interpolation( void );
+
 /* Draw current game state
  * Should be called continuously from Game Loop.
 */
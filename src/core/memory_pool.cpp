@@ -0,0 +1,92 @@
+/***************************************************************************
+ * memory_pool.cpp  -  fixed size block memory pool
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/memory_pool.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** *** cMemory_Pool *** *** *** *** *** *** *** *** *** *** *** */
+
+// round the block size up to keep the alignment of double and pointers
+static size_t Get_Aligned_Block_Size( size_t size )
+{
+	const size_t align = sizeof(double) > sizeof(void *) ? sizeof(double) : sizeof(void *);
+
+	if( size < align )
+	{
+		return align;
+	}
+
+	return ( ( size + align - 1 ) / align ) * align;
+}
+
+cMemory_Pool :: cMemory_Pool( size_t block_size, size_t chunk_blocks /* = 256 */ )
+: m_block_size( Get_Aligned_Block_Size( block_size ) ), m_chunk_blocks( chunk_blocks )
+{
+	m_free = NULL;
+}
+
+cMemory_Pool :: ~cMemory_Pool( void )
+{
+	for( vector<char *>::iterator itr = m_chunks.begin(), itr_end = m_chunks.end(); itr != itr_end; ++itr )
+	{
+		delete[] *itr;
+	}
+
+	m_chunks.clear();
+	m_free = NULL;
+}
+
+void *cMemory_Pool :: Alloc( void )
+{
+	if( !m_free )
+	{
+		Add_Chunk();
+	}
+
+	cFree_Block *block = m_free;
+	m_free = block->next;
+
+	return block;
+}
+
+void cMemory_Pool :: Free( void *block )
+{
+	if( !block )
+	{
+		return;
+	}
+
+	cFree_Block *free_block = static_cast<cFree_Block *>(block);
+	free_block->next = m_free;
+	m_free = free_block;
+}
+
+void cMemory_Pool :: Add_Chunk( void )
+{
+	char *chunk = new char[m_block_size * m_chunk_blocks];
+	m_chunks.push_back( chunk );
+
+	// link the blocks from back to front so the first block is used first
+	for( size_t i = m_chunk_blocks; i > 0; i-- )
+	{
+		Free( chunk + ( ( i - 1 ) * m_block_size ) );
+	}
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
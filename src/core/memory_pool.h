@@ -0,0 +1,67 @@
+/***************************************************************************
+ * memory_pool.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_MEMORY_POOL_H
+#define SMC_MEMORY_POOL_H
+
+#include "../core/global_basic.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cMemory_Pool *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Memory pool for blocks of the same size
+ * Freed blocks are kept in a free list and reused by the next allocation.
+ * Memory is only given back to the system if the pool is deleted.
+ * Used as class operator new/delete for often created small objects.
+*/
+class cMemory_Pool
+{
+public:
+	cMemory_Pool( size_t block_size, size_t chunk_blocks = 256 );
+	~cMemory_Pool( void );
+
+	// Return a new block
+	void *Alloc( void );
+	// Give the block back to the pool
+	void Free( void *block );
+
+	// block size in bytes
+	const size_t m_block_size;
+	// number of blocks allocated at once
+	const size_t m_chunk_blocks;
+
+private:
+	// free block list entry
+	struct cFree_Block
+	{
+		cFree_Block *next;
+	};
+
+	// allocate a new chunk and add its blocks to the free list
+	void Add_Chunk( void );
+
+	// first free block
+	cFree_Block *m_free;
+	// allocated chunks
+	vector<char *> m_chunks;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -39,15 +39,18 @@ public:
 	// Delete the object from given array number
 	virtual bool Delete( size_t array_num, bool delete_data = 1 )
 	{
-		// if in vector
-		if( array_num < objects.size() )
+		// not in vector
+		if( array_num >= objects.size() )
 		{
-			objects.erase( objects.begin() + array_num );
+			return 0;
 		}
 
+		T *obj = objects[array_num];
+		objects.erase( objects.begin() + array_num );
+
 		if( delete_data )
 		{
-			delete objects[array_num];
+			delete obj;
 		}
 
 		return 1;
@@ -62,14 +65,13 @@ public:
 			return 0;
 		}
 
-		// get iterator
-		typename vector<T *>::iterator itr = std::find( objects.begin(), objects.end(), obj );
+		const int array_num = Get_Array_Num( obj );
 
 		// available in vector
-		if( itr != objects.end() )
+		if( array_num >= 0 )
 		{
 			// erase
-			objects.erase( itr );
+			objects.erase( objects.begin() + array_num );
 		}
 
 		if( delete_data )
@@ -147,7 +149,7 @@ public:
 	/* Return the object array number
 	 * if not found returns -1
 	*/
-	int Get_Array_Num( T *obj ) const
+	virtual int Get_Array_Num( T *obj ) const
 	{
 		// invalid
 		if( !obj )
@@ -0,0 +1,493 @@
+/***************************************************************************
+ * profiler.cpp  -  nanosecond frame profiler
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/profiler.h"
+#include "../core/filesystem/resource_manager.h"
+#include <algorithm>
+#include <iomanip>
+#ifdef _WIN32
+	#include <windows.h>
+#elif defined( __APPLE__ )
+	#include <mach/mach_time.h>
+#else
+	#include <time.h>
+#endif
+
+namespace SMC
+{
+
+// zone names in the order of the zone types
+static const char *zone_names[PERF_ZONE_COUNT] =
+{
+	"Update Game",
+	"Draw Game",
+	"Render",
+	"Update Process Input",
+	"Update Level",
+	"Update Level Editor",
+	"Update Hud",
+	"Update Player",
+	"Update Player Collisions",
+	"Update Level Late",
+	"Update Level Collisions",
+	"Update Camera",
+	"Update Overworld",
+	"Update Menu",
+	"Update Level Settings",
+	"Sprites Update",
+	"Sprites Collisions",
+	"Draw Level Layer 1",
+	"Draw Level Player",
+	"Draw Level Layer 2",
+	"Draw Level Hud",
+	"Draw Level Editor",
+	"Draw Overworld",
+	"Draw Menu",
+	"Draw Level Settings",
+	"Draw Mouse",
+	"Render Game",
+	"Render Gui",
+	"Render Buffer",
+	"Render Queue",
+	"Level Load"
+};
+
+// frames used for the zone time average
+static const unsigned int profiler_average_frames = 100;
+
+// Write the nanoseconds as microseconds with three decimal places
+static void Write_Microseconds( ofstream &file, Uint64 ns )
+{
+	file << static_cast<unsigned long>(ns / 1000) << '.' << std::setw( 3 ) << std::setfill( '0' ) << static_cast<unsigned int>(ns % 1000);
+}
+
+// Return the value at the given percentile of the sorted values
+static Uint64 Get_Percentile( const vector<Uint64> &sorted_values, unsigned int percentile )
+{
+	if( sorted_values.empty() )
+	{
+		return 0;
+	}
+
+	// nearest rank
+	size_t rank = ( sorted_values.size() * percentile + 99 ) / 100;
+
+	if( rank == 0 )
+	{
+		rank = 1;
+	}
+
+	return sorted_values[rank - 1];
+}
+
+/* *** *** *** *** *** *** cProfiler_Frame *** *** *** *** *** *** *** *** *** *** *** */
+
+cProfiler_Frame :: cProfiler_Frame( void )
+{
+	m_start = 0;
+	m_duration = 0;
+}
+
+/* *** *** *** *** *** *** cProfiler *** *** *** *** *** *** *** *** *** *** *** */
+
+cProfiler :: cProfiler( unsigned int frame_count /* = 3600 */ )
+{
+	m_enabled = 0;
+
+	if( frame_count < 2 )
+	{
+		frame_count = 2;
+	}
+
+	m_frames.resize( frame_count );
+	m_open_zones.reserve( 32 );
+
+	Reset();
+}
+
+cProfiler :: ~cProfiler( void )
+{
+	//
+}
+
+void cProfiler :: Begin_Frame( void )
+{
+	if( !m_enabled )
+	{
+		return;
+	}
+
+	m_frames[m_frame_pos].m_start = Get_Profiler_Time();
+}
+
+void cProfiler :: End_Frame( void )
+{
+	if( !m_enabled )
+	{
+		return;
+	}
+
+	cProfiler_Frame &frame = m_frames[m_frame_pos];
+	frame.m_duration = Get_Profiler_Time() - frame.m_start;
+
+	// add to the average
+	for( Profiler_Event_List::const_iterator itr = frame.m_events.begin(), itr_end = frame.m_events.end(); itr != itr_end; ++itr )
+	{
+		m_zone_counter[(*itr).m_zone] += (*itr).m_duration;
+	}
+
+	m_average_frames++;
+
+	if( m_average_frames >= profiler_average_frames )
+	{
+		for( unsigned int i = 0; i < PERF_ZONE_COUNT; i++ )
+		{
+			m_zone_average[i] = static_cast<float>(m_zone_counter[i] / m_average_frames) * 0.000001f;
+			m_zone_counter[i] = 0;
+		}
+
+		m_average_frames = 0;
+	}
+
+	// next frame
+	m_frame_pos++;
+
+	if( m_frame_pos >= m_frames.size() )
+	{
+		m_frame_pos = 0;
+	}
+
+	if( m_frames_recorded < m_frames.size() - 1 )
+	{
+		m_frames_recorded++;
+	}
+
+	// keeps the allocated event memory
+	m_frames[m_frame_pos].m_events.clear();
+	m_frames[m_frame_pos].m_start = 0;
+	m_frames[m_frame_pos].m_duration = 0;
+}
+
+void cProfiler :: Begin_Zone( performance_zone_type zone )
+{
+	cOpen_Zone open_zone;
+	open_zone.m_zone = zone;
+	// always added to keep the zone nesting valid if enabled changes
+	open_zone.m_start = m_enabled ? Get_Profiler_Time() : 0;
+
+	m_open_zones.push_back( open_zone );
+}
+
+void cProfiler :: End_Zone( void )
+{
+	if( m_open_zones.empty() )
+	{
+		return;
+	}
+
+	const cOpen_Zone open_zone = m_open_zones.back();
+	m_open_zones.pop_back();
+
+	// not started while enabled
+	if( !m_enabled || !open_zone.m_start )
+	{
+		return;
+	}
+
+	cProfiler_Event event;
+	event.m_start = open_zone.m_start;
+	event.m_duration = Get_Profiler_Time() - open_zone.m_start;
+	event.m_zone = open_zone.m_zone;
+	event.m_depth = m_open_zones.size();
+
+	m_frames[m_frame_pos].m_events.push_back( event );
+}
+
+float cProfiler :: Get_Zone_Time( performance_zone_type zone ) const
+{
+	return m_zone_average[zone];
+}
+
+void cProfiler :: Reset( void )
+{
+	for( Profiler_Frame_List::iterator itr = m_frames.begin(), itr_end = m_frames.end(); itr != itr_end; ++itr )
+	{
+		(*itr).m_events.clear();
+		(*itr).m_start = 0;
+		(*itr).m_duration = 0;
+	}
+
+	m_frame_pos = 0;
+	m_frames_recorded = 0;
+	m_average_frames = 0;
+
+	for( unsigned int i = 0; i < PERF_ZONE_COUNT; i++ )
+	{
+		m_zone_counter[i] = 0;
+		m_zone_average[i] = 0.0f;
+	}
+}
+
+bool cProfiler :: Save_Trace( const std::string &filename ) const
+{
+	ofstream file( filename.c_str(), ios::out | ios::trunc );
+
+	if( !file.is_open() )
+	{
+		printf( "Error : Couldn't open profiler trace file %s for saving\n", filename.c_str() );
+		return 0;
+	}
+
+	// times are relative to the oldest frame
+	Uint64 time_base = 0;
+
+	if( m_frames_recorded )
+	{
+		const cProfiler_Frame &oldest_frame = Get_Frame( m_frames_recorded - 1 );
+		time_base = oldest_frame.m_start;
+
+		// zones can start before the first frame
+		for( Profiler_Event_List::const_iterator itr = oldest_frame.m_events.begin(), itr_end = oldest_frame.m_events.end(); itr != itr_end; ++itr )
+		{
+			time_base = std::min( time_base, (*itr).m_start );
+		}
+	}
+
+	file << "{\"traceEvents\":[" << std::endl;
+
+	bool first = 1;
+
+	for( unsigned int age = m_frames_recorded; age > 0; age-- )
+	{
+		const cProfiler_Frame &frame = Get_Frame( age - 1 );
+
+		// frame
+		if( !first )
+		{
+			file << "," << std::endl;
+		}
+
+		first = 0;
+		file << "{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":";
+		Write_Microseconds( file, frame.m_start - time_base );
+		file << ",\"dur\":";
+		Write_Microseconds( file, frame.m_duration );
+		file << "}";
+
+		// zones
+		for( Profiler_Event_List::const_iterator itr = frame.m_events.begin(), itr_end = frame.m_events.end(); itr != itr_end; ++itr )
+		{
+			const cProfiler_Event &event = (*itr);
+
+			file << "," << std::endl << "{\"name\":\"" << Get_Zone_Name( event.m_zone ) << "\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":";
+			Write_Microseconds( file, event.m_start - time_base );
+			file << ",\"dur\":";
+			Write_Microseconds( file, event.m_duration );
+			file << "}";
+		}
+	}
+
+	file << std::endl << "]," << std::endl << "\"displayTimeUnit\":\"ns\"}" << std::endl;
+	file.close();
+
+	return 1;
+}
+
+bool cProfiler :: Save_CSV( const std::string &filename ) const
+{
+	ofstream file( filename.c_str(), ios::out | ios::trunc );
+
+	if( !file.is_open() )
+	{
+		printf( "Error : Couldn't open profiler CSV file %s for saving\n", filename.c_str() );
+		return 0;
+	}
+
+	// time of each frame and zone per frame
+	vector<Uint64> frame_times;
+	vector<Uint64> zone_times[PERF_ZONE_COUNT];
+	unsigned int zone_calls[PERF_ZONE_COUNT];
+
+	frame_times.reserve( m_frames_recorded );
+
+	for( unsigned int i = 0; i < PERF_ZONE_COUNT; i++ )
+	{
+		zone_calls[i] = 0;
+	}
+
+	for( unsigned int age = 0; age < m_frames_recorded; age++ )
+	{
+		const cProfiler_Frame &frame = Get_Frame( age );
+		frame_times.push_back( frame.m_duration );
+
+		Uint64 frame_zone_times[PERF_ZONE_COUNT];
+		bool frame_zone_used[PERF_ZONE_COUNT];
+
+		for( unsigned int i = 0; i < PERF_ZONE_COUNT; i++ )
+		{
+			frame_zone_times[i] = 0;
+			frame_zone_used[i] = 0;
+		}
+
+		for( Profiler_Event_List::const_iterator itr = frame.m_events.begin(), itr_end = frame.m_events.end(); itr != itr_end; ++itr )
+		{
+			frame_zone_times[(*itr).m_zone] += (*itr).m_duration;
+			frame_zone_used[(*itr).m_zone] = 1;
+			zone_calls[(*itr).m_zone]++;
+		}
+
+		// only frames which used the zone
+		for( unsigned int i = 0; i < PERF_ZONE_COUNT; i++ )
+		{
+			if( frame_zone_used[i] )
+			{
+				zone_times[i].push_back( frame_zone_times[i] );
+			}
+		}
+	}
+
+	file << "zone,frames,calls,mean_ms,p50_ms,p99_ms,max_ms" << std::endl;
+	file << std::fixed << std::setprecision( 4 );
+
+	// frame and all zones
+	for( int i = -1; i < PERF_ZONE_COUNT; i++ )
+	{
+		vector<Uint64> &times = ( i < 0 ) ? frame_times : zone_times[i];
+
+		if( times.empty() )
+		{
+			continue;
+		}
+
+		std::sort( times.begin(), times.end() );
+
+		Uint64 total = 0;
+
+		for( vector<Uint64>::const_iterator itr = times.begin(), itr_end = times.end(); itr != itr_end; ++itr )
+		{
+			total += *itr;
+		}
+
+		file << ( ( i < 0 ) ? "Frame" : Get_Zone_Name( static_cast<performance_zone_type>(i) ) ) << ",";
+		file << static_cast<unsigned int>(times.size()) << "," << ( ( i < 0 ) ? static_cast<unsigned int>(times.size()) : zone_calls[i] ) << ",";
+		file << static_cast<double>(total / times.size()) * 0.000001 << ",";
+		file << static_cast<double>(Get_Percentile( times, 50 )) * 0.000001 << ",";
+		file << static_cast<double>(Get_Percentile( times, 99 )) * 0.000001 << ",";
+		file << static_cast<double>(times.back()) * 0.000001 << std::endl;
+	}
+
+	file.close();
+
+	return 1;
+}
+
+void cProfiler :: Save( void ) const
+{
+	if( !m_frames_recorded )
+	{
+		return;
+	}
+
+	std::string trace_filename = pResource_Manager->user_data_dir + "performance_trace.json";
+	std::string csv_filename = pResource_Manager->user_data_dir + "performance.csv";
+
+	if( Save_Trace( trace_filename ) )
+	{
+		printf( "Saved performance trace of %u frames to %s\n", m_frames_recorded, trace_filename.c_str() );
+	}
+	if( Save_CSV( csv_filename ) )
+	{
+		printf( "Saved performance statistics to %s\n", csv_filename.c_str() );
+	}
+}
+
+const char *cProfiler :: Get_Zone_Name( performance_zone_type zone )
+{
+	if( zone < 0 || zone >= PERF_ZONE_COUNT || !zone_names[zone] )
+	{
+		return "Unknown";
+	}
+
+	return zone_names[zone];
+}
+
+const cProfiler_Frame &cProfiler :: Get_Frame( unsigned int age ) const
+{
+	const unsigned int size = m_frames.size();
+
+	return m_frames[( m_frame_pos + size - 1 - ( age % size ) ) % size];
+}
+
+/* *** *** *** *** *** *** cProfiler_Zone *** *** *** *** *** *** *** *** *** *** *** */
+
+cProfiler_Zone :: cProfiler_Zone( performance_zone_type zone )
+{
+	if( pProfiler )
+	{
+		pProfiler->Begin_Zone( zone );
+	}
+}
+
+cProfiler_Zone :: ~cProfiler_Zone( void )
+{
+	if( pProfiler )
+	{
+		pProfiler->End_Zone();
+	}
+}
+
+/* *** *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** */
+
+Uint64 Get_Profiler_Time( void )
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = { 0 };
+
+	if( !frequency.QuadPart )
+	{
+		QueryPerformanceFrequency( &frequency );
+	}
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter( &counter );
+
+	// split to not overflow
+	const Uint64 count = static_cast<Uint64>(counter.QuadPart);
+	const Uint64 freq = static_cast<Uint64>(frequency.QuadPart);
+	return ( count / freq ) * 1000000000 + ( ( count % freq ) * 1000000000 ) / freq;
+#elif defined( __APPLE__ )
+	static mach_timebase_info_data_t timebase = { 0, 0 };
+
+	if( !timebase.denom )
+	{
+		mach_timebase_info( &timebase );
+	}
+
+	return ( static_cast<Uint64>(mach_absolute_time()) * timebase.numer ) / timebase.denom;
+#else
+	timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	return static_cast<Uint64>(ts.tv_sec) * 1000000000 + static_cast<Uint64>(ts.tv_nsec);
+#endif
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cProfiler *pProfiler = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,166 @@
+/***************************************************************************
+ * profiler.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_PROFILER_H
+#define SMC_PROFILER_H
+
+#include "../core/global_basic.h"
+#include "../core/global_game.h"
+// SDL
+#include "SDL.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cProfiler_Event *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// a finished zone
+class cProfiler_Event
+{
+public:
+	// start time in nanoseconds
+	Uint64 m_start;
+	// duration in nanoseconds
+	Uint64 m_duration;
+	// zone type
+	performance_zone_type m_zone;
+	// number of parent zones
+	unsigned int m_depth;
+};
+
+typedef vector<cProfiler_Event> Profiler_Event_List;
+
+/* *** *** *** *** *** cProfiler_Frame *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// recorded zones of one frame
+class cProfiler_Frame
+{
+public:
+	cProfiler_Frame( void );
+
+	// frame start time in nanoseconds
+	Uint64 m_start;
+	// frame duration in nanoseconds
+	Uint64 m_duration;
+	// finished zones in the order they ended
+	Profiler_Event_List m_events;
+};
+
+/* *** *** *** *** *** cProfiler *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Nanosecond frame profiler
+ * Zones can be nested and are recorded for each frame.
+ * The last frames are kept in a ring buffer and can be saved as
+ * Chrome trace ( chrome://tracing ) and as CSV with frame time percentiles.
+ * Zones are only recorded if the performance debug mode is enabled.
+*/
+class cProfiler
+{
+public:
+	// frame count is the ring buffer size
+	cProfiler( unsigned int frame_count = 3600 );
+	~cProfiler( void );
+
+	// Start a new frame
+	void Begin_Frame( void );
+	// Finish the current frame
+	void End_Frame( void );
+
+	// Start a zone inside the current zone
+	void Begin_Zone( performance_zone_type zone );
+	// Finish the last started zone
+	void End_Zone( void );
+
+	// Return the average milliseconds per frame of the zone measured over the last 100 frames
+	float Get_Zone_Time( performance_zone_type zone ) const;
+
+	// Remove all recorded frames
+	void Reset( void );
+
+	/* Save the recorded frames as Chrome trace json file
+	 * returns true if successful
+	*/
+	bool Save_Trace( const std::string &filename ) const;
+	/* Save the zone statistics of the recorded frames as CSV file
+	 * with the mean, median ( p50 ), p99 and maximum milliseconds per frame
+	 * returns true if successful
+	*/
+	bool Save_CSV( const std::string &filename ) const;
+	// Save the trace and CSV file into the user data directory if frames were recorded
+	void Save( void ) const;
+
+	// Return the zone name
+	static const char *Get_Zone_Name( performance_zone_type zone );
+
+	// if set zones are recorded
+	bool m_enabled;
+
+private:
+	// Return the recorded frame with the given age ( 0 is the last finished frame )
+	const cProfiler_Frame &Get_Frame( unsigned int age ) const;
+
+	// started zone
+	class cOpen_Zone
+	{
+	public:
+		Uint64 m_start;
+		performance_zone_type m_zone;
+	};
+
+	typedef vector<cOpen_Zone> Open_Zone_List;
+	// started zones ( last is the innermost )
+	Open_Zone_List m_open_zones;
+
+	typedef vector<cProfiler_Frame> Profiler_Frame_List;
+	// frame ring buffer
+	Profiler_Frame_List m_frames;
+	// current frame in the ring buffer
+	unsigned int m_frame_pos;
+	// number of finished frames in the ring buffer
+	unsigned int m_frames_recorded;
+
+	// zone times of the current average period in nanoseconds
+	Uint64 m_zone_counter[PERF_ZONE_COUNT];
+	// frames of the current average period
+	unsigned int m_average_frames;
+	// average zone milliseconds per frame of the last period
+	float m_zone_average[PERF_ZONE_COUNT];
+};
+
+/* *** *** *** *** *** cProfiler_Zone *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Profiles the zone until it gets deleted
+class cProfiler_Zone
+{
+public:
+	cProfiler_Zone( performance_zone_type zone );
+	~cProfiler_Zone( void );
+};
+
+/* *** *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** */
+
+// Return the time of a monotonic high resolution clock in nanoseconds
+Uint64 Get_Profiler_Time( void );
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Profiler
+extern cProfiler *pProfiler;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -0,0 +1,189 @@
+/***************************************************************************
+ * rect_grid.cpp  -  uniform grid spatial index for rects
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/rect_grid.h"
+#include <algorithm>
+
+namespace SMC
+{
+
+// maximum number of cells before the cell size gets increased
+static const int grid_max_cells = 128 * 128;
+// positions outside of this range are always clamped into the border cells
+static const float grid_max_pos = 10000000.0f;
+
+/* *** *** *** *** *** *** cGrid_Cells *** *** *** *** *** *** *** *** *** *** *** */
+
+cGrid_Cells :: cGrid_Cells( float cell_size )
+{
+	m_default_cell_size = cell_size;
+	m_cell_size = cell_size;
+	m_origin_x = 0;
+	m_origin_y = 0;
+	m_cols = 0;
+	m_rows = 0;
+}
+
+void cGrid_Cells :: Set_Bounds( float min_x, float min_y, float max_x, float max_y, int border_cells /* = 0 */ )
+{
+	// limit to a sane world size
+	min_x = std::max( min_x, -grid_max_pos );
+	min_y = std::max( min_y, -grid_max_pos );
+	max_x = std::min( max_x, grid_max_pos );
+	max_y = std::min( max_y, grid_max_pos );
+
+	m_cell_size = m_default_cell_size;
+
+	// increase the cell size until the cell count is valid
+	for( ;; )
+	{
+		m_origin_x = static_cast<int>(floor( min_x / m_cell_size )) - border_cells;
+		m_origin_y = static_cast<int>(floor( min_y / m_cell_size )) - border_cells;
+		m_cols = static_cast<int>(floor( max_x / m_cell_size )) + border_cells + 1 - m_origin_x;
+		m_rows = static_cast<int>(floor( max_y / m_cell_size )) + border_cells + 1 - m_origin_y;
+
+		if( m_cols <= grid_max_cells && m_rows <= grid_max_cells && m_cols * m_rows <= grid_max_cells )
+		{
+			break;
+		}
+
+		m_cell_size *= 2.0f;
+	}
+}
+
+void cGrid_Cells :: Reset( void )
+{
+	m_cell_size = m_default_cell_size;
+	m_cols = 0;
+	m_rows = 0;
+}
+
+bool cGrid_Cells :: Get_Cell_Range( const GL_rect &rect, int &x1, int &y1, int &x2, int &y2 ) const
+{
+	bool outside = 0;
+
+	x1 = Get_Cell( rect.m_x, m_origin_x, m_cols, outside );
+	y1 = Get_Cell( rect.m_y, m_origin_y, m_rows, outside );
+	x2 = Get_Cell( rect.m_x + rect.m_w, m_origin_x, m_cols, outside );
+	y2 = Get_Cell( rect.m_y + rect.m_h, m_origin_y, m_rows, outside );
+
+	return outside;
+}
+
+int cGrid_Cells :: Get_Cell( float pos, int origin, int count, bool &outside ) const
+{
+	// clamp as float to stay in the integer range
+	float cell = floor( pos / m_cell_size ) - static_cast<float>(origin);
+
+	if( cell < 0.0f )
+	{
+		outside = 1;
+		return 0;
+	}
+	if( cell > static_cast<float>(count - 1) )
+	{
+		outside = 1;
+		return count - 1;
+	}
+
+	return static_cast<int>(cell);
+}
+
+/* *** *** *** *** *** *** cRect_Grid *** *** *** *** *** *** *** *** *** *** *** */
+
+cRect_Grid :: cRect_Grid( float cell_size /* = 128.0f */ )
+: m_layout( cell_size )
+{
+	//
+}
+
+cRect_Grid :: ~cRect_Grid( void )
+{
+	//
+}
+
+void cRect_Grid :: Rebuild( const vector<GL_rect> &rects )
+{
+	Clear();
+
+	if( rects.empty() )
+	{
+		return;
+	}
+
+	// get the bounds of all rects
+	float min_x = rects[0].m_x;
+	float min_y = rects[0].m_y;
+	float max_x = rects[0].m_x + rects[0].m_w;
+	float max_y = rects[0].m_y + rects[0].m_h;
+
+	for( vector<GL_rect>::const_iterator itr = rects.begin() + 1, itr_end = rects.end(); itr != itr_end; ++itr )
+	{
+		const GL_rect &rect = (*itr);
+
+		min_x = std::min( min_x, rect.m_x );
+		min_y = std::min( min_y, rect.m_y );
+		max_x = std::max( max_x, rect.m_x + rect.m_w );
+		max_y = std::max( max_y, rect.m_y + rect.m_h );
+	}
+
+	m_layout.Set_Bounds( min_x, min_y, max_x, max_y );
+	m_cells.resize( m_layout.Get_Count() );
+
+	// add rects
+	for( unsigned int i = 0; i < rects.size(); i++ )
+	{
+		int x1, y1, x2, y2;
+		m_layout.Get_Cell_Range( rects[i], x1, y1, x2, y2 );
+
+		for( int y = y1; y <= y2; y++ )
+		{
+			for( int x = x1; x <= x2; x++ )
+			{
+				m_cells[m_layout.Get_Num( x, y )].push_back( i );
+			}
+		}
+	}
+}
+
+void cRect_Grid :: Clear( void )
+{
+	m_cells.clear();
+	m_layout.Reset();
+}
+
+void cRect_Grid :: Get_Nums( vector<unsigned int> &nums, const GL_rect &rect ) const
+{
+	if( m_cells.empty() )
+	{
+		return;
+	}
+
+	int x1, y1, x2, y2;
+	m_layout.Get_Cell_Range( rect, x1, y1, x2, y2 );
+
+	for( int y = y1; y <= y2; y++ )
+	{
+		for( int x = x1; x <= x2; x++ )
+		{
+			const NumList &cell = m_cells[m_layout.Get_Num( x, y )];
+			nums.insert( nums.end(), cell.begin(), cell.end() );
+		}
+	}
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,106 @@
+/***************************************************************************
+ * rect_grid.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_RECT_GRID_H
+#define SMC_RECT_GRID_H
+
+#include "../core/global_basic.h"
+#include "../core/math/rect.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cGrid_Cells *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Cell layout of a uniform grid
+ * Positions outside of the bounds are clamped into the border cells.
+*/
+class cGrid_Cells
+{
+public:
+	cGrid_Cells( float cell_size );
+
+	/* Set the origin and cell count to cover the given bounds with additional border cells around it
+	 * the cell size is increased until the cell count is valid
+	*/
+	void Set_Bounds( float min_x, float min_y, float max_x, float max_y, int border_cells = 0 );
+	// Reset to the default cell size without cells
+	void Reset( void );
+
+	// Set the cell range touched by the given rect and return true if it was outside of the bounds
+	bool Get_Cell_Range( const GL_rect &rect, int &x1, int &y1, int &x2, int &y2 ) const;
+
+	// Return the number of cells
+	inline int Get_Count( void ) const
+	{
+		return m_cols * m_rows;
+	}
+	// Return the cell number ( row after row )
+	inline int Get_Num( int x, int y ) const
+	{
+		return ( y * m_cols ) + x;
+	}
+
+	// cell size used after a reset
+	float m_default_cell_size;
+	// cell width and height
+	float m_cell_size;
+	// first cell position in cell units
+	int m_origin_x, m_origin_y;
+	// cell count
+	int m_cols, m_rows;
+
+private:
+	// Return the clamped cell of the given position and set outside if it was clamped
+	int Get_Cell( float pos, int origin, int count, bool &outside ) const;
+};
+
+/* *** *** *** *** *** cRect_Grid *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Uniform grid spatial index for a fixed list of rects
+ * Every rect number is stored in each cell the rect touches.
+ * The grid is only build from the complete list and has to be rebuild if a rect changed.
+*/
+class cRect_Grid
+{
+public:
+	cRect_Grid( float cell_size = 128.0f );
+	~cRect_Grid( void );
+
+	// Rebuild the bounds and cells from the given rects ( the rect number is the index )
+	void Rebuild( const vector<GL_rect> &rects );
+	// Remove all rects
+	void Clear( void );
+
+	/* Add the numbers of the rects from the cells touched by the given rect
+	 * a number can be added more than once if the rect touches multiple cells
+	 * the rects are not checked against the given rect
+	*/
+	void Get_Nums( vector<unsigned int> &nums, const GL_rect &rect ) const;
+
+private:
+	// cell layout
+	cGrid_Cells m_layout;
+	// rect numbers in each cell ( row after row )
+	typedef vector<unsigned int> NumList;
+	typedef vector<NumList> CellList;
+	CellList m_cells;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -0,0 +1,363 @@
+/***************************************************************************
+ * sprite_chunks.cpp  -  static sprites baked into vertex arrays
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/sprite_chunks.h"
+#include "../core/game_core.h"
+#include "../core/camera.h"
+#include "../video/img_manager.h"
+#include <algorithm>
+
+namespace SMC
+{
+
+// Return the z position the sprite is drawn with
+static float Get_Draw_Pos_Z( const cSprite *sprite )
+{
+	if( editor_enabled && sprite->m_editor_pos_z > 0.0f )
+	{
+		return sprite->m_editor_pos_z;
+	}
+
+	return sprite->m_pos_z;
+}
+
+// Return the image the sprite is drawn with
+static const cGL_Surface *Get_Draw_Image( const cSprite *sprite )
+{
+	if( editor_enabled )
+	{
+		return sprite->m_start_image;
+	}
+
+	return sprite->m_image;
+}
+
+// draw z position sort
+struct draw_zpos_sort
+{
+	bool operator()( const cSprite *a, const cSprite *b ) const
+	{
+		return Get_Draw_Pos_Z( a ) < Get_Draw_Pos_Z( b );
+	}
+};
+
+/* *** *** *** *** *** *** cSprite_Chunks *** *** *** *** *** *** *** *** *** *** *** */
+
+cSprite_Chunks :: cSprite_Chunks( float chunk_width, float chunk_height )
+{
+	m_chunk_width = chunk_width;
+	m_chunk_height = chunk_height;
+	m_editor_enabled = editor_enabled;
+	m_texture_generation = 0;
+}
+
+cSprite_Chunks :: ~cSprite_Chunks( void )
+{
+	Clear();
+}
+
+void cSprite_Chunks :: Add( cSprite *sprite )
+{
+	// already added or not possible
+	if( sprite->m_chunk_num >= 0 || !sprite->Is_Chunk_Draw_Valid() )
+	{
+		return;
+	}
+
+	const cChunk_Key key = Get_Key( sprite );
+	ChunkMap::iterator itr = m_chunk_map.find( key );
+	int chunk_num;
+
+	if( itr != m_chunk_map.end() )
+	{
+		chunk_num = itr->second;
+	}
+	// create
+	else
+	{
+		cChunk *chunk = new cChunk();
+		chunk->m_key = key;
+		chunk->m_changed = 0;
+
+		chunk_num = static_cast<int>(m_chunks.size());
+		m_chunks.push_back( chunk );
+		m_chunk_map[key] = chunk_num;
+	}
+
+	cChunk *chunk = m_chunks[chunk_num];
+	chunk->m_objects.push_back( sprite );
+	sprite->m_chunk_num = chunk_num;
+
+	Set_Changed( chunk );
+}
+
+void cSprite_Chunks :: Remove( cSprite *sprite )
+{
+	// not in a chunk
+	if( sprite->m_chunk_num < 0 )
+	{
+		return;
+	}
+
+	cChunk *chunk = m_chunks[sprite->m_chunk_num];
+	cSprite_List::iterator itr = std::find( chunk->m_objects.begin(), chunk->m_objects.end(), sprite );
+
+	if( itr != chunk->m_objects.end() )
+	{
+		// order is restored on rebuild
+		*itr = chunk->m_objects.back();
+		chunk->m_objects.pop_back();
+	}
+
+	sprite->m_chunk_num = -1;
+	sprite->m_chunk_drawn = 0;
+
+	Set_Changed( chunk );
+}
+
+void cSprite_Chunks :: Update( cSprite *sprite )
+{
+	// not in a chunk
+	if( sprite->m_chunk_num < 0 )
+	{
+		Add( sprite );
+		return;
+	}
+
+	cChunk *chunk = m_chunks[sprite->m_chunk_num];
+	const cChunk_Key key = Get_Key( sprite );
+
+	// moved to another cell or the type changed
+	if( chunk->m_key.x != key.x || chunk->m_key.y != key.y || chunk->m_key.type != key.type )
+	{
+		Remove( sprite );
+		Add( sprite );
+		return;
+	}
+
+	Set_Changed( chunk );
+}
+
+void cSprite_Chunks :: Clear( void )
+{
+	for( ChunkList::iterator itr = m_chunks.begin(), itr_end = m_chunks.end(); itr != itr_end; ++itr )
+	{
+		delete *itr;
+	}
+
+	m_chunks.clear();
+	m_changed_chunks.clear();
+	m_chunk_map.clear();
+}
+
+void cSprite_Chunks :: Rebuild( void )
+{
+	// editor sprites are drawn differently and texture coordinates are invalid after reloading
+	if( m_editor_enabled != editor_enabled || m_texture_generation != pImage_Manager->m_texture_generation )
+	{
+		m_editor_enabled = editor_enabled;
+		m_texture_generation = pImage_Manager->m_texture_generation;
+
+		for( ChunkList::iterator itr = m_chunks.begin(), itr_end = m_chunks.end(); itr != itr_end; ++itr )
+		{
+			Set_Changed( *itr );
+		}
+	}
+
+	for( ChunkList::iterator itr = m_changed_chunks.begin(), itr_end = m_changed_chunks.end(); itr != itr_end; ++itr )
+	{
+		Rebuild_Chunk( *itr );
+	}
+
+	m_changed_chunks.clear();
+}
+
+void cSprite_Chunks :: Draw( void )
+{
+	const GL_rect camera_rect( pActive_Camera->x, pActive_Camera->y, static_cast<float>(game_res_w), static_cast<float>(game_res_h) );
+
+	for( ChunkList::iterator itr = m_chunks.begin(), itr_end = m_chunks.end(); itr != itr_end; ++itr )
+	{
+		cChunk *chunk = (*itr);
+
+		// nothing to draw or not visible
+		if( chunk->m_layers.empty() || !chunk->m_rect.Intersects( camera_rect ) )
+		{
+			continue;
+		}
+
+		// texture ids changed
+		if( !Use_Textures( chunk ) )
+		{
+			Rebuild_Chunk( chunk );
+
+			if( chunk->m_layers.empty() )
+			{
+				continue;
+			}
+		}
+
+		// a request for each z position to keep the depth order with other requests
+		for( vector<cChunk::cLayer>::const_iterator layer_itr = chunk->m_layers.begin(), layer_itr_end = chunk->m_layers.end(); layer_itr != layer_itr_end; ++layer_itr )
+		{
+			const cChunk::cLayer &layer = (*layer_itr);
+
+			// create request
+			cVertex_Array_Request *request = new cVertex_Array_Request();
+			request->m_array = &chunk->m_array;
+			request->m_run_start = layer.run_start;
+			request->m_run_count = layer.run_count;
+			request->pos_z = layer.pos_z;
+			// add request
+			pRenderer->Add( request );
+		}
+	}
+}
+
+cSprite_Chunks::cChunk_Key cSprite_Chunks :: Get_Key( const cSprite *sprite ) const
+{
+	cChunk_Key key;
+	key.x = static_cast<int>(floor( sprite->m_start_pos_x / m_chunk_width ));
+	key.y = static_cast<int>(floor( sprite->m_start_pos_y / m_chunk_height ));
+	key.type = sprite->m_type;
+
+	return key;
+}
+
+void cSprite_Chunks :: Set_Changed( cChunk *chunk )
+{
+	// already set
+	if( chunk->m_changed )
+	{
+		return;
+	}
+
+	chunk->m_changed = 1;
+	m_changed_chunks.push_back( chunk );
+}
+
+void cSprite_Chunks :: Rebuild_Chunk( cChunk *chunk )
+{
+	chunk->m_changed = 0;
+	chunk->m_array.Clear();
+	chunk->m_layers.clear();
+	chunk->m_surfaces.clear();
+	chunk->m_texture_ids.clear();
+
+	// quads are drawn in z order
+	std::sort( chunk->m_objects.begin(), chunk->m_objects.end(), draw_zpos_sort() );
+
+	float min_x = 0.0f;
+	float min_y = 0.0f;
+	float max_x = 0.0f;
+	float max_y = 0.0f;
+	bool first = 1;
+
+	for( cSprite_List::iterator itr = chunk->m_objects.begin(), itr_end = chunk->m_objects.end(); itr != itr_end; ++itr )
+	{
+		cSprite *obj = (*itr);
+
+		obj->m_chunk_drawn = 0;
+
+		// drawn by itself in the current state
+		if( !obj->Is_Chunk_Draw_Valid() )
+		{
+			continue;
+		}
+
+		cSurface_Request request;
+		obj->Draw_Image_Data( &request );
+
+		if( !chunk->m_array.Add( &request ) )
+		{
+			continue;
+		}
+
+		obj->m_chunk_drawn = 1;
+
+		// used image
+		const cGL_Surface *image = Get_Draw_Image( obj );
+
+		if( image && std::find( chunk->m_surfaces.begin(), chunk->m_surfaces.end(), image ) == chunk->m_surfaces.end() )
+		{
+			chunk->m_surfaces.push_back( image );
+			chunk->m_texture_ids.push_back( image->m_image );
+		}
+
+		// bounds of the added quad
+		for( RenderVertexList::const_iterator vertex_itr = chunk->m_array.m_vertices.end() - 4, vertex_itr_end = chunk->m_array.m_vertices.end(); vertex_itr != vertex_itr_end; ++vertex_itr )
+		{
+			const cRender_Vertex &vertex = (*vertex_itr);
+
+			if( first )
+			{
+				min_x = vertex.x;
+				min_y = vertex.y;
+				max_x = vertex.x;
+				max_y = vertex.y;
+				first = 0;
+				continue;
+			}
+
+			min_x = std::min( min_x, vertex.x );
+			min_y = std::min( min_y, vertex.y );
+			max_x = std::max( max_x, vertex.x );
+			max_y = std::max( max_y, vertex.y );
+		}
+	}
+
+	chunk->m_rect = GL_rect( min_x, min_y, max_x - min_x, max_y - min_y );
+
+	// group the runs by z position ( sorted by z )
+	for( unsigned int i = 0; i < chunk->m_array.m_runs.size(); i++ )
+	{
+		const float pos_z = chunk->m_array.m_runs[i].pos_z;
+
+		if( chunk->m_layers.empty() || chunk->m_layers.back().pos_z != pos_z )
+		{
+			cChunk::cLayer layer;
+			layer.pos_z = pos_z;
+			layer.run_start = i;
+			layer.run_count = 0;
+			chunk->m_layers.push_back( layer );
+		}
+
+		chunk->m_layers.back().run_count++;
+	}
+}
+
+bool cSprite_Chunks :: Use_Textures( cChunk *chunk ) const
+{
+	bool valid = 1;
+
+	for( unsigned int i = 0; i < chunk->m_surfaces.size(); i++ )
+	{
+		const cGL_Surface *image = chunk->m_surfaces[i];
+
+		// loads the texture again if unloaded
+		image->Use_Texture();
+
+		if( image->m_image != chunk->m_texture_ids[i] )
+		{
+			valid = 0;
+		}
+	}
+
+	return valid;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,140 @@
+/***************************************************************************
+ * sprite_chunks.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_SPRITE_CHUNKS_H
+#define SMC_SPRITE_CHUNKS_H
+
+#include "../core/global_game.h"
+#include "../objects/sprite.h"
+#include "../video/renderer.h"
+#include <map>
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cSprite_Chunks *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Static sprites baked into vertex arrays
+ * Sprites which can be drawn from a chunk are added to the chunk of their position and type.
+ * A chunk is only rebuild if one of its sprites changed and is drawn with one
+ * request. The sprites which are drawn from a chunk are skipped by the sprite manager.
+*/
+class cSprite_Chunks
+{
+public:
+	cSprite_Chunks( float chunk_width, float chunk_height );
+	~cSprite_Chunks( void );
+
+	// Add the sprite to the chunk at its position if it can be drawn from a chunk
+	void Add( cSprite *sprite );
+	// Remove the sprite from its chunk
+	void Remove( cSprite *sprite );
+	/* Rebuild the chunk of the sprite because its drawing changed
+	 * if not in a chunk it is added if possible
+	 * if the start position cell or type changed it is moved to the new chunk
+	*/
+	void Update( cSprite *sprite );
+	// Remove all chunks without changing the sprites
+	void Clear( void );
+
+	// Rebuild the changed chunks
+	void Rebuild( void );
+	// Add a render request for each chunk visible on the screen
+	void Draw( void );
+
+private:
+	// chunk cell and sprite type
+	struct cChunk_Key
+	{
+		int x, y;
+		int type;
+
+		bool operator < ( const cChunk_Key &key ) const
+		{
+			if( x != key.x )
+			{
+				return x < key.x;
+			}
+			if( y != key.y )
+			{
+				return y < key.y;
+			}
+
+			return type < key.type;
+		}
+	};
+
+	// sprites of the same type in one cell
+	class cChunk
+	{
+	public:
+		// sprites in this chunk
+		cSprite_List m_objects;
+		// quads of the sprites drawn from this chunk
+		cVertex_Array m_array;
+		// images of the quads and their texture id when build
+		vector<const cGL_Surface *> m_surfaces;
+		vector<GLuint> m_texture_ids;
+		// runs of the array with the same z position
+		struct cLayer
+		{
+			float pos_z;
+			unsigned int run_start;
+			unsigned int run_count;
+		};
+		vector<cLayer> m_layers;
+		// bounds of the quads
+		GL_rect m_rect;
+		// cell and sprite type
+		cChunk_Key m_key;
+		// if set the vertex array needs to be rebuild
+		bool m_changed;
+	};
+
+	// Return the chunk key of the sprite start position and type
+	cChunk_Key Get_Key( const cSprite *sprite ) const;
+	// Set the chunk to be rebuild
+	void Set_Changed( cChunk *chunk );
+	// Rebuild the vertex array of the chunk
+	void Rebuild_Chunk( cChunk *chunk );
+	/* Mark the textures of the chunk as used
+	 * returns false if a texture changed because it was unloaded
+	*/
+	bool Use_Textures( cChunk *chunk ) const;
+
+	// chunk width and height
+	float m_chunk_width, m_chunk_height;
+
+	typedef vector<cChunk *> ChunkList;
+	// all chunks ( the sprite chunk number is the index )
+	ChunkList m_chunks;
+	// changed chunks
+	ChunkList m_changed_chunks;
+
+	typedef std::map<cChunk_Key, int> ChunkMap;
+	// chunk number by cell and type
+	ChunkMap m_chunk_map;
+
+	// editor state the chunks were build for
+	bool m_editor_enabled;
+	// image manager texture generation the chunks were build for
+	unsigned int m_texture_generation;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -0,0 +1,248 @@
+/***************************************************************************
+ * sprite_grid.cpp  -  uniform grid spatial index for sprites
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/sprite_grid.h"
+#include <algorithm>
+
+namespace SMC
+{
+
+// free cells around the sprites on rebuild
+static const int grid_border_cells = 2;
+
+/* *** *** *** *** *** *** cSprite_Grid *** *** *** *** *** *** *** *** *** *** *** */
+
+cSprite_Grid :: cSprite_Grid( float cell_size /* = 256.0f */ )
+: m_layout( cell_size )
+{
+	m_rebuild = 1;
+	m_count = 0;
+	m_outside_count = 0;
+	m_query_id = 0;
+}
+
+cSprite_Grid :: ~cSprite_Grid( void )
+{
+	//
+}
+
+void cSprite_Grid :: Add( cSprite *sprite )
+{
+	// added on rebuild
+	if( m_rebuild )
+	{
+		return;
+	}
+
+	int x1, y1, x2, y2;
+
+	if( m_layout.Get_Cell_Range( sprite->m_col_rect, x1, y1, x2, y2 ) )
+	{
+		m_outside_count++;
+	}
+
+	Insert( sprite, x1, y1, x2, y2 );
+	m_count++;
+
+	// too many sprites in the border cells
+	if( m_outside_count > 256 + m_count / 2 )
+	{
+		m_rebuild = 1;
+	}
+}
+
+void cSprite_Grid :: Remove( cSprite *sprite )
+{
+	// not in the grid
+	if( m_rebuild || sprite->m_grid_x1 < 0 )
+	{
+		return;
+	}
+
+	for( int y = sprite->m_grid_y1; y <= sprite->m_grid_y2; y++ )
+	{
+		for( int x = sprite->m_grid_x1; x <= sprite->m_grid_x2; x++ )
+		{
+			cSprite_List &cell = m_cells[m_layout.Get_Num( x, y )];
+			cSprite_List::iterator itr = std::find( cell.begin(), cell.end(), sprite );
+
+			if( itr == cell.end() )
+			{
+				continue;
+			}
+
+			// order is not important
+			*itr = cell.back();
+			cell.pop_back();
+		}
+	}
+
+	sprite->m_grid_x1 = -1;
+	m_count--;
+}
+
+void cSprite_Grid :: Update( cSprite *sprite )
+{
+	// not in the grid
+	if( m_rebuild || sprite->m_grid_x1 < 0 )
+	{
+		return;
+	}
+
+	int x1, y1, x2, y2;
+	bool outside = m_layout.Get_Cell_Range( sprite->m_col_rect, x1, y1, x2, y2 );
+
+	// still in the same cells
+	if( x1 == sprite->m_grid_x1 && y1 == sprite->m_grid_y1 && x2 == sprite->m_grid_x2 && y2 == sprite->m_grid_y2 )
+	{
+		return;
+	}
+
+	Remove( sprite );
+	Insert( sprite, x1, y1, x2, y2 );
+	m_count++;
+
+	if( outside )
+	{
+		m_outside_count++;
+
+		if( m_outside_count > 256 + m_count / 2 )
+		{
+			m_rebuild = 1;
+		}
+	}
+}
+
+void cSprite_Grid :: Rebuild( const cSprite_List &objects )
+{
+	m_cells.clear();
+	m_count = 0;
+	m_outside_count = 0;
+	m_rebuild = 0;
+
+	// get the bounds of all sprites
+	float min_x = 0.0f;
+	float min_y = 0.0f;
+	float max_x = 0.0f;
+	float max_y = 0.0f;
+	bool first = 1;
+
+	for( cSprite_List::const_iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	{
+		const cSprite *obj = (*itr);
+
+		// ignore destroyed objects for the bounds
+		if( obj->m_auto_destroy )
+		{
+			continue;
+		}
+
+		const GL_rect &rect = obj->m_col_rect;
+
+		if( first )
+		{
+			min_x = rect.m_x;
+			min_y = rect.m_y;
+			max_x = rect.m_x + rect.m_w;
+			max_y = rect.m_y + rect.m_h;
+			first = 0;
+			continue;
+		}
+
+		min_x = std::min( min_x, rect.m_x );
+		min_y = std::min( min_y, rect.m_y );
+		max_x = std::max( max_x, rect.m_x + rect.m_w );
+		max_y = std::max( max_y, rect.m_y + rect.m_h );
+	}
+
+	m_layout.Set_Bounds( min_x, min_y, max_x, max_y, grid_border_cells );
+	m_cells.resize( m_layout.Get_Count() );
+
+	// add sprites
+	for( cSprite_List::const_iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	{
+		cSprite *obj = (*itr);
+
+		int x1, y1, x2, y2;
+		m_layout.Get_Cell_Range( obj->m_col_rect, x1, y1, x2, y2 );
+		Insert( obj, x1, y1, x2, y2 );
+		m_count++;
+	}
+}
+
+void cSprite_Grid :: Clear( void )
+{
+	m_cells.clear();
+	m_layout.Reset();
+	m_count = 0;
+	m_outside_count = 0;
+	m_rebuild = 1;
+}
+
+void cSprite_Grid :: Get_Objects( cSprite_List &objects, const GL_rect &rect )
+{
+	if( m_rebuild )
+	{
+		return;
+	}
+
+	int x1, y1, x2, y2;
+	m_layout.Get_Cell_Range( rect, x1, y1, x2, y2 );
+
+	// new query
+	m_query_id++;
+
+	for( int y = y1; y <= y2; y++ )
+	{
+		for( int x = x1; x <= x2; x++ )
+		{
+			const cSprite_List &cell = m_cells[m_layout.Get_Num( x, y )];
+
+			for( cSprite_List::const_iterator itr = cell.begin(), itr_end = cell.end(); itr != itr_end; ++itr )
+			{
+				cSprite *obj = (*itr);
+
+				// already added from another cell
+				if( obj->m_grid_query_id == m_query_id )
+				{
+					continue;
+				}
+
+				obj->m_grid_query_id = m_query_id;
+				objects.push_back( obj );
+			}
+		}
+	}
+}
+
+void cSprite_Grid :: Insert( cSprite *sprite, int x1, int y1, int x2, int y2 )
+{
+	sprite->m_grid_x1 = x1;
+	sprite->m_grid_y1 = y1;
+	sprite->m_grid_x2 = x2;
+	sprite->m_grid_y2 = y2;
+
+	for( int y = y1; y <= y2; y++ )
+	{
+		for( int x = x1; x <= x2; x++ )
+		{
+			m_cells[m_layout.Get_Num( x, y )].push_back( sprite );
+		}
+	}
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,82 @@
+/***************************************************************************
+ * sprite_grid.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_SPRITE_GRID_H
+#define SMC_SPRITE_GRID_H
+
+#include "../core/global_game.h"
+#include "../objects/sprite.h"
+#include "../core/rect_grid.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cSprite_Grid *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Uniform grid spatial index for sprite collision rects
+ * Every sprite is stored in each cell its collision rect touches.
+ * Rects outside of the grid bounds are clamped into the border cells
+ * and if too many sprites are outside the grid bounds get rebuild.
+*/
+class cSprite_Grid
+{
+public:
+	cSprite_Grid( float cell_size = 256.0f );
+	~cSprite_Grid( void );
+
+	// Add the sprite to all cells touched by its collision rect
+	void Add( cSprite *sprite );
+	// Remove the sprite from all its cells
+	void Remove( cSprite *sprite );
+	// Move the sprite into other cells if its collision rect changed cells
+	void Update( cSprite *sprite );
+
+	// Rebuild the bounds and cells from the given sprites
+	void Rebuild( const cSprite_List &objects );
+	// Remove all sprites and set the grid to be rebuild
+	void Clear( void );
+
+	/* Add all sprites from the cells touched by the given rect
+	 * each sprite is only added once
+	 * the sprite collision rects are not checked against the given rect
+	*/
+	void Get_Objects( cSprite_List &objects, const GL_rect &rect );
+
+	// if set the grid needs to be rebuild before it can be used
+	bool m_rebuild;
+
+private:
+	// Add the sprite to the given cell range
+	void Insert( cSprite *sprite, int x1, int y1, int x2, int y2 );
+
+	// cell layout
+	cGrid_Cells m_layout;
+	// sprites in each cell ( row after row )
+	typedef vector<cSprite_List> CellList;
+	CellList m_cells;
+
+	// number of sprites in the grid
+	unsigned int m_count;
+	// how often sprites were added outside of the bounds since the last rebuild
+	unsigned int m_outside_count;
+	// current query identifier
+	unsigned int m_query_id;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -18,20 +18,34 @@
 #include "../player/player.h"
 #include "../input/mouse.h"
 #include "../overworld/world_player.h"
+#include "../core/profiler.h"
+#include "../core/camera.h"
+#include "../video/img_manager.h"
 #include <algorithm>
 
 namespace SMC
 {
 
+// distance around the camera and player range in which sleeping sprites are updated
+static const float sprite_wake_distance = 200.0f;
+
 /* *** *** *** *** *** *** cSprite_Manager *** *** *** *** *** *** *** *** *** *** *** */
 
 cSprite_Manager :: cSprite_Manager( unsigned int reserve_items /* = 2000 */, unsigned int zpos_items /* = 100 */ )
-: cObject_Manager<cSprite>()
+: cObject_Manager<cSprite>(), m_chunks( static_cast<float>(game_res_w), static_cast<float>(game_res_h) )
 {
 	objects.reserve( reserve_items );
 
 	zposdata.assign( zpos_items, 0.0f );
 	zposdata_editor.assign( zpos_items,0.0f );
+
+	m_collision_queries = 0;
+	m_collision_results = 0;
+
+	m_sleep_changed = 1;
+	m_active_frame = 0;
+	m_max_player_range = 0;
+	m_next_generation = 1;
 }
 
 cSprite_Manager :: ~cSprite_Manager( void )
@@ -49,25 +63,155 @@ void cSprite_Manager :: Add( cSprite *sprite )
 
 	Set_Pos_Z( sprite );
 
+	// don't interpolate from the last update position
+	sprite->m_tick_pos_x = sprite->m_pos_x;
+	sprite->m_tick_pos_y = sprite->m_pos_y;
+
+	sprite->m_generation = m_next_generation;
+	m_next_generation++;
+
+	// 0 is never a valid generation
+	if( !m_next_generation )
+	{
+		m_next_generation = 1;
+	}
+
 	// Check if an destroyed object can be replaced
-	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	while( !m_free_slots.empty() )
 	{
-		// get object pointer
-		cSprite *obj = (*itr);
+		const unsigned int array_num = m_free_slots.back();
+		m_free_slots.pop_back();
 
-		// if destroy is set
-		if( obj->m_auto_destroy )
+		// outdated
+		if( array_num >= objects.size() || !objects[array_num]->m_auto_destroy )
 		{
-			// set new object
-			*itr = sprite;
-			// delete old
-			delete obj;
+			continue;
+		}
+
+		// get object pointer
+		cSprite *obj = objects[array_num];
 
-			return;
+		m_grid.Remove( obj );
+		m_chunks.Remove( obj );
+		obj->m_sprite_manager = NULL;
+
+		// the array number could already be in the active items
+		sprite->m_active_frame = obj->m_active_frame;
+
+		// set new object
+		objects[array_num] = sprite;
+		// delete old
+		delete obj;
+
+		sprite->m_sprite_manager = this;
+		sprite->m_array_num = static_cast<int>(array_num);
+		m_grid.Add( sprite );
+		m_chunks.Add( sprite );
+		Add_Active_Item( sprite );
+
+		// already destroyed
+		if( sprite->m_auto_destroy )
+		{
+			Add_Free_Slot( sprite );
 		}
+
+		return;
 	}
 
 	cObject_Manager<cSprite>::Add( sprite );
+
+	sprite->m_sprite_manager = this;
+	sprite->m_array_num = static_cast<int>(objects.size()) - 1;
+	m_grid.Add( sprite );
+	m_chunks.Add( sprite );
+	Add_Active_Item( sprite );
+
+	// already destroyed
+	if( sprite->m_auto_destroy )
+	{
+		Add_Free_Slot( sprite );
+	}
+}
+
+void cSprite_Manager :: Add_Free_Slot( cSprite *sprite )
+{
+	// not added to this manager
+	if( sprite->m_sprite_manager != this || sprite->m_array_num < 0 )
+	{
+		return;
+	}
+
+	m_free_slots.push_back( static_cast<unsigned int>(sprite->m_array_num) );
+}
+
+bool cSprite_Manager :: Delete( size_t array_num, bool delete_data /* = 1 */ )
+{
+	// not in vector
+	if( array_num >= objects.size() )
+	{
+		return 0;
+	}
+
+	return Delete( objects[array_num], delete_data );
+}
+
+bool cSprite_Manager :: Delete( cSprite *obj, bool delete_data /* = 1 */ )
+{
+	// empty object
+	if( !obj )
+	{
+		return 0;
+	}
+
+	const int array_num = Get_Array_Num( obj );
+
+	// available in vector
+	if( array_num >= 0 )
+	{
+		m_grid.Remove( obj );
+		m_chunks.Remove( obj );
+		obj->m_sprite_manager = NULL;
+		obj->m_array_num = -1;
+
+		cSprite *last = objects.back();
+		objects.pop_back();
+
+		// move the last sprite into the array number
+		if( last != obj )
+		{
+			objects[array_num] = last;
+			last->m_array_num = array_num;
+
+			/* the lists still contain the old array number which is now out of range
+			 * and the new array number can be a different sprite
+			*/
+			if( last->m_auto_destroy )
+			{
+				m_free_slots.push_back( static_cast<unsigned int>(array_num) );
+			}
+			else if( !last->m_can_sleep )
+			{
+				m_awake_items.push_back( static_cast<unsigned int>(array_num) );
+			}
+			else if( last->m_woken )
+			{
+				m_woken_items.push_back( static_cast<unsigned int>(array_num) );
+			}
+
+			// keep it in the current frame
+			if( m_active_frame && last->m_active_frame == m_active_frame && obj->m_active_frame != m_active_frame )
+			{
+				m_active_items.push_back( static_cast<unsigned int>(array_num) );
+			}
+		}
+	}
+
+	if( delete_data )
+	{
+		delete obj;
+	}
+
+	return 1;
 }
 
 cSprite *cSprite_Manager :: Copy( unsigned int identifier )
@@ -97,7 +241,20 @@ void cSprite_Manager :: Delete_All( bool delayed /* = 0 */ )
 	// instant
 	else
 	{
+		for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+		{
+			(*itr)->m_sprite_manager = NULL;
+		}
+
+		m_grid.Clear();
+		m_chunks.Clear();
 		cObject_Manager<cSprite>::Delete_All();
+		m_free_slots.clear();
+
+		m_active_items.clear();
+		m_awake_items.clear();
+		m_woken_items.clear();
+		m_sleep_changed = 1;
 	}
 
 	// todo : pPlayer and pMouseCursor should be elsewhere !
@@ -208,8 +365,19 @@ void cSprite_Manager :: Get_Objects_sorted( cSprite_List &new_objects, bool edit
 
 void cSprite_Manager :: Get_Colliding_Objects( cSprite_List &col_objects, const GL_rect &rect, bool with_player /* = 0 */, const cSprite *exclude_sprite /* = NULL */ ) const
 {
+	if( m_grid.m_rebuild )
+	{
+		m_grid.Rebuild( objects );
+	}
+
+	// get the objects from the touched cells
+	const size_t first_num = col_objects.size();
+	m_grid.Get_Objects( col_objects, rect );
+
 	// Check objects
-	for( cSprite_List::const_iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	cSprite_List::iterator valid_itr = col_objects.begin() + first_num;
+
+	for( cSprite_List::iterator itr = valid_itr, itr_end = col_objects.end(); itr != itr_end; ++itr )
 	{
 		// get object pointer
 		cSprite *obj = (*itr);
@@ -226,9 +394,15 @@ void cSprite_Manager :: Get_Colliding_Objects( cSprite_List &col_objects, const
 			continue;
 		}
 
-		col_objects.push_back( obj );
+		*valid_itr = obj;
+		++valid_itr;
 	}
 
+	col_objects.erase( valid_itr, col_objects.end() );
+
+	m_collision_queries++;
+	m_collision_results += static_cast<unsigned int>(col_objects.size() - first_num);
+
 	if( with_player && pActive_Player != exclude_sprite )
 	{
 		if( rect.Intersects( pActive_Player->m_col_rect ) )
@@ -238,6 +412,349 @@ void cSprite_Manager :: Get_Colliding_Objects( cSprite_List &col_objects, const
 	}
 }
 
+void cSprite_Manager :: Update_Grid( cSprite *sprite )
+{
+	m_grid.Update( sprite );
+	m_chunks.Update( sprite );
+}
+
+int cSprite_Manager :: Get_Array_Num( cSprite *obj ) const
+{
+	// invalid
+	if( !obj )
+	{
+		return -1;
+	}
+
+	// not added to this manager
+	if( obj->m_sprite_manager != this || obj->m_array_num < 0 || static_cast<size_t>(obj->m_array_num) >= objects.size() )
+	{
+		return -1;
+	}
+
+	return obj->m_array_num;
+}
+
+cSprite_Handle cSprite_Manager :: Get_Handle( cSprite *obj ) const
+{
+	cSprite_Handle handle;
+
+	// not added to this manager
+	if( !obj || obj->m_sprite_manager != this )
+	{
+		return handle;
+	}
+
+	handle.m_array_num = Get_Array_Num( obj );
+	handle.m_generation = obj->m_generation;
+
+	return handle;
+}
+
+cSprite *cSprite_Manager :: Get_From_Handle( const cSprite_Handle &handle ) const
+{
+	if( handle.m_array_num < 0 || static_cast<size_t>(handle.m_array_num) >= objects.size() )
+	{
+		return NULL;
+	}
+
+	cSprite *obj = objects[handle.m_array_num];
+
+	// deleted, replaced or moved
+	if( obj->m_generation != handle.m_generation )
+	{
+		return NULL;
+	}
+
+	return obj;
+}
+
+void cSprite_Manager :: Renumber( size_t start /* = 0 */ )
+{
+	// remove the free slots which are renumbered
+	for( Item_Num_List::iterator itr = m_free_slots.begin(); itr != m_free_slots.end(); )
+	{
+		if( *itr >= start )
+		{
+			itr = m_free_slots.erase( itr );
+		}
+		else
+		{
+			++itr;
+		}
+	}
+
+	for( size_t i = start; i < objects.size(); i++ )
+	{
+		cSprite *obj = objects[i];
+
+		obj->m_array_num = static_cast<int>(i);
+
+		if( obj->m_auto_destroy )
+		{
+			m_free_slots.push_back( static_cast<unsigned int>(i) );
+		}
+	}
+
+	// array numbers changed
+	m_sleep_changed = 1;
+	m_active_items.clear();
+}
+
+void cSprite_Manager :: Wake( cSprite *sprite )
+{
+	if( !sprite->m_can_sleep || sprite->m_woken || sprite->m_auto_destroy || sprite->m_sprite_manager != this )
+	{
+		return;
+	}
+
+	const int num = Get_Array_Num( sprite );
+
+	if( num < 0 )
+	{
+		return;
+	}
+
+	sprite->m_woken = 1;
+	m_woken_items.push_back( static_cast<unsigned int>(num) );
+
+	// add to the current frame
+	if( m_active_frame && sprite->m_active_frame != m_active_frame )
+	{
+		sprite->m_active_frame = m_active_frame;
+		m_active_items.push_back( static_cast<unsigned int>(num) );
+	}
+}
+
+void cSprite_Manager :: Add_Active_Item( cSprite *sprite )
+{
+	sprite->m_woken = 0;
+
+	if( sprite->m_can_sleep )
+	{
+		if( sprite->m_player_range > m_max_player_range )
+		{
+			m_max_player_range = sprite->m_player_range;
+		}
+	}
+	else
+	{
+		m_awake_items.push_back( static_cast<unsigned int>(sprite->m_array_num) );
+	}
+
+	// a new item is also updated if it is added in the current frame
+	if( m_active_frame && sprite->m_active_frame != m_active_frame )
+	{
+		sprite->m_active_frame = m_active_frame;
+		m_active_items.push_back( static_cast<unsigned int>(sprite->m_array_num) );
+	}
+}
+
+void cSprite_Manager :: Update_Active_Items( void )
+{
+	m_active_frame++;
+	m_active_items.clear();
+
+	// rebuild from all items
+	if( m_sleep_changed )
+	{
+		m_awake_items.clear();
+		m_woken_items.clear();
+		m_max_player_range = 0;
+
+		for( size_t i = 0; i < objects.size(); i++ )
+		{
+			cSprite *obj = objects[i];
+
+			obj->m_array_num = static_cast<int>(i);
+			obj->m_woken = 0;
+
+			if( !obj->m_can_sleep )
+			{
+				m_awake_items.push_back( static_cast<unsigned int>(i) );
+				continue;
+			}
+
+			if( obj->m_player_range > m_max_player_range )
+			{
+				m_max_player_range = obj->m_player_range;
+			}
+
+			if( !obj->m_auto_destroy && !obj->Is_Sleep_Valid() )
+			{
+				obj->m_woken = 1;
+				m_woken_items.push_back( static_cast<unsigned int>(i) );
+			}
+		}
+
+		m_sleep_changed = 0;
+	}
+
+	// items which can not sleep
+	Item_Num_List::iterator valid_itr = m_awake_items.begin();
+
+	for( Item_Num_List::iterator itr = m_awake_items.begin(), itr_end = m_awake_items.end(); itr != itr_end; ++itr )
+	{
+		const unsigned int num = (*itr);
+
+		if( num >= objects.size() )
+		{
+			continue;
+		}
+
+		cSprite *obj = objects[num];
+
+		// replaced or already added
+		if( obj->m_can_sleep || obj->m_active_frame == m_active_frame )
+		{
+			continue;
+		}
+
+		obj->m_active_frame = m_active_frame;
+		m_active_items.push_back( num );
+
+		*valid_itr = num;
+		++valid_itr;
+	}
+
+	m_awake_items.erase( valid_itr, m_awake_items.end() );
+
+	// woken up items
+	valid_itr = m_woken_items.begin();
+
+	for( Item_Num_List::iterator itr = m_woken_items.begin(), itr_end = m_woken_items.end(); itr != itr_end; ++itr )
+	{
+		const unsigned int num = (*itr);
+
+		if( num >= objects.size() )
+		{
+			continue;
+		}
+
+		cSprite *obj = objects[num];
+
+		// replaced or already added
+		if( !obj->m_can_sleep || !obj->m_woken || obj->m_active_frame == m_active_frame )
+		{
+			continue;
+		}
+
+		// can sleep again
+		if( obj->m_auto_destroy || obj->Is_Sleep_Valid() )
+		{
+			obj->m_woken = 0;
+			continue;
+		}
+
+		if( obj->m_player_range > m_max_player_range )
+		{
+			m_max_player_range = obj->m_player_range;
+		}
+
+		obj->m_active_frame = m_active_frame;
+		m_active_items.push_back( num );
+
+		*valid_itr = num;
+		++valid_itr;
+	}
+
+	m_woken_items.erase( valid_itr, m_woken_items.end() );
+
+	// sleeping items in the active region
+	if( m_grid.m_rebuild )
+	{
+		m_grid.Rebuild( objects );
+	}
+
+	m_region_objects.clear();
+
+	if( pActive_Camera )
+	{
+		m_grid.Get_Objects( m_region_objects, GL_rect( pActive_Camera->x - sprite_wake_distance, pActive_Camera->y - sprite_wake_distance,
+			game_res_w + ( sprite_wake_distance * 2.0f ), game_res_h + ( sprite_wake_distance * 2.0f ) ) );
+	}
+
+	// player range is only used if at least 300
+	if( pPlayer && m_max_player_range >= 300 )
+	{
+		const float range = static_cast<float>(m_max_player_range) + sprite_wake_distance;
+
+		m_grid.Get_Objects( m_region_objects, GL_rect( pPlayer->m_pos_x - range, pPlayer->m_pos_y - range, range * 2.0f, range * 2.0f ) );
+	}
+
+	// load the unloaded textures of the sprites near the camera before they are drawn
+	if( pImage_Manager && pImage_Manager->m_texture_budget )
+	{
+		for( cSprite_List::iterator itr = m_region_objects.begin(), itr_end = m_region_objects.end(); itr != itr_end; ++itr )
+		{
+			if( (*itr)->m_image )
+			{
+				(*itr)->m_image->Prefetch_Texture();
+			}
+		}
+	}
+
+	for( cSprite_List::iterator itr = m_region_objects.begin(), itr_end = m_region_objects.end(); itr != itr_end; ++itr )
+	{
+		cSprite *obj = (*itr);
+
+		if( !obj->m_can_sleep || obj->m_auto_destroy || obj->m_active_frame == m_active_frame || !Is_In_Active_Region( obj ) )
+		{
+			continue;
+		}
+
+		const int num = Get_Array_Num( obj );
+
+		if( num < 0 )
+		{
+			continue;
+		}
+
+		// the range can change with the state
+		if( obj->m_player_range > m_max_player_range )
+		{
+			m_max_player_range = obj->m_player_range;
+		}
+
+		obj->m_active_frame = m_active_frame;
+		m_active_items.push_back( static_cast<unsigned int>(num) );
+
+		// keep updating it if it leaves the region
+		if( !obj->m_woken && !obj->Is_Sleep_Valid() )
+		{
+			obj->m_woken = 1;
+			m_woken_items.push_back( static_cast<unsigned int>(num) );
+		}
+	}
+
+	// update in array order
+	std::sort( m_active_items.begin(), m_active_items.end() );
+}
+
+bool cSprite_Manager :: Is_In_Active_Region( const cSprite *sprite ) const
+{
+	// near the camera
+	if( pActive_Camera && sprite->m_rect.m_x + sprite->m_rect.m_w >= pActive_Camera->x - sprite_wake_distance && sprite->m_rect.m_x <= pActive_Camera->x + game_res_w + sprite_wake_distance &&
+		sprite->m_rect.m_y + sprite->m_rect.m_h >= pActive_Camera->y - sprite_wake_distance && sprite->m_rect.m_y <= pActive_Camera->y + game_res_h + sprite_wake_distance )
+	{
+		return 1;
+	}
+
+	// near the player range ( see cSprite::Is_In_Player_Range )
+	if( pPlayer && sprite->m_player_range >= 300 )
+	{
+		const float range = static_cast<float>(sprite->m_player_range) + sprite_wake_distance;
+
+		if( sprite->m_pos_x >= pPlayer->m_pos_x - range && sprite->m_pos_x <= pPlayer->m_pos_x + range &&
+			sprite->m_pos_y >= pPlayer->m_pos_y - range && sprite->m_pos_y <= pPlayer->m_pos_y + range )
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
 void cSprite_Manager :: Update_Items_Valid_Draw( void )
 {
 	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
@@ -248,33 +765,89 @@ void cSprite_Manager :: Update_Items_Valid_Draw( void )
 
 void cSprite_Manager :: Update_Items( void )
 {
-	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	cProfiler_Zone zone( PERF_SPRITES_UPDATE );
+
+	Update_Active_Items();
+
+	/* items woken up while updating are updated in the same frame
+	 * items added while updating are updated in the next frame
+	*/
+	for( size_t i = 0, count = m_active_items.size(); i < m_active_items.size(); i++ )
 	{
-		(*itr)->Update();
+		// removed or added in this frame
+		if( m_active_items[i] >= objects.size() || ( i >= count && !objects[m_active_items[i]]->m_woken ) )
+		{
+			continue;
+		}
+
+		cSprite *obj = objects[m_active_items[i]];
+
+		obj->Update();
+		// the collision rect could have been changed directly
+		m_grid.Update( obj );
 	}
 }
 
 void cSprite_Manager :: Update_Items_Late( void )
 {
-	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	for( size_t i = 0, count = m_active_items.size(); i < m_active_items.size(); i++ )
 	{
-		(*itr)->Update_Late();
+		// removed or added in this frame
+		if( m_active_items[i] >= objects.size() || ( i >= count && !objects[m_active_items[i]]->m_woken ) )
+		{
+			continue;
+		}
+
+		cSprite *obj = objects[m_active_items[i]];
+
+		obj->Update_Late();
+		// the collision rect could have been changed directly
+		m_grid.Update( obj );
 	}
 }
 
 void cSprite_Manager :: Draw_Items( void )
 {
+	// debug drawing needs the sprites drawn by themselves
+	const bool use_chunks = !game_debug;
+
+	if( use_chunks )
+	{
+		m_chunks.Rebuild();
+	}
+
 	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
 	{
-		(*itr)->Draw();
+		cSprite *obj = (*itr);
+
+		// drawn from its chunk
+		if( use_chunks && obj->m_chunk_drawn )
+		{
+			continue;
+		}
+
+		obj->Draw();
+	}
+
+	if( use_chunks )
+	{
+		m_chunks.Draw();
 	}
 }
 
 void cSprite_Manager :: Handle_Collision_Items( void )
 {
-	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	cProfiler_Zone zone( PERF_SPRITES_COLLISIONS );
+
+	for( size_t i = 0, count = m_active_items.size(); i < m_active_items.size(); i++ )
 	{
-		cSprite *obj = (*itr);
+		// removed or added in this frame
+		if( m_active_items[i] >= objects.size() || ( i >= count && !objects[m_active_items[i]]->m_woken ) )
+		{
+			continue;
+		}
+
+		cSprite *obj = objects[m_active_items[i]];
 
 		// invalid
 		if( obj->m_auto_destroy )
@@ -295,6 +868,47 @@ void cSprite_Manager :: Handle_Collision_Items( void )
 	}
 }
 
+void cSprite_Manager :: Save_Tick_Positions( void )
+{
+	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	{
+		cSprite *obj = (*itr);
+
+		obj->m_tick_pos_x = obj->m_pos_x;
+		obj->m_tick_pos_y = obj->m_pos_y;
+	}
+}
+
+void cSprite_Manager :: Set_Interpolated_Positions( float alpha )
+{
+	m_draw_positions.resize( objects.size() * 2 );
+
+	vector<float>::iterator pos_itr = m_draw_positions.begin();
+
+	for( cSprite_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	{
+		cSprite *obj = (*itr);
+
+		// save the current position
+		*pos_itr++ = obj->m_pos_x;
+		*pos_itr++ = obj->m_pos_y;
+
+		obj->Set_Interpolated_Pos( alpha );
+	}
+}
+
+void cSprite_Manager :: Restore_Positions( void )
+{
+	// objects can not be added while drawing but stay safe
+	const size_t count = std::min( objects.size(), m_draw_positions.size() / 2 );
+
+	for( size_t i = 0; i < count; i++ )
+	{
+		objects[i]->m_pos_x = m_draw_positions[i * 2];
+		objects[i]->m_pos_y = m_draw_positions[( i * 2 ) + 1];
+	}
+}
+
 unsigned int cSprite_Manager :: Get_Size_Array( const ArrayType sprite_array )
 {
 	unsigned int count = 0;
@@ -19,10 +19,26 @@
 #include "../core/global_game.h"
 #include "../core/obj_manager.h"
 #include "../objects/movingsprite.h"
+#include "../core/sprite_grid.h"
+#include "../core/sprite_chunks.h"
 
 namespace SMC
 {
 
+/* *** *** *** *** *** cSprite_Handle *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Sprite array number with the generation of the sprite
+ * becomes invalid if the sprite is deleted, its slot is reused or the array numbers changed
+*/
+struct cSprite_Handle
+{
+	cSprite_Handle( void )
+	: m_array_num( -1 ), m_generation( 0 ) {};
+
+	int m_array_num;
+	unsigned int m_generation;
+};
+
 /* *** *** *** *** *** cSprite_Manager *** *** *** *** *** *** *** *** *** *** *** *** */
 
 class cSprite_Manager : public cObject_Manager<cSprite>
@@ -32,8 +48,19 @@ public:
 	virtual ~cSprite_Manager( void );
 
 	/* Add a sprite
+	 * replaces the last destroyed sprite from the free slots if available
 	 */
 	virtual void Add( cSprite *sprite );
+	// Add the array slot of the destroyed sprite to the free slots
+	void Add_Free_Slot( cSprite *sprite );
+
+	// Delete the object from given array number
+	virtual bool Delete( size_t array_num, bool delete_data = 1 );
+	/* Delete the given object
+	 * the last sprite is moved into its array number
+	 * which changes the order the editor saves the sprites in
+	*/
+	virtual bool Delete( cSprite *obj, bool delete_data = 1 );
 
 	// Return the copied sprite
 	cSprite *Copy( unsigned int identifier );
@@ -58,22 +85,67 @@ public:
 	*/
 	void Get_Objects_sorted( cSprite_List &new_objects, bool editor_sort = 0, bool with_player = 0 ) const;
 	/* Get objects colliding with the given rectangle
+	 * uses the collision grid and only checks objects near the rectangle
 	 * with_player : include player in check
 	 * exclude_sprite : exclude the given sprite from check
 	*/
 	void Get_Colliding_Objects( cSprite_List &col_objects, const GL_rect &rect, bool with_player = 0, const cSprite *exclude_sprite = NULL ) const;
 
+	// Update the collision grid cells and the static chunk of the given sprite if it moved or changed
+	virtual void Update_Grid( cSprite *sprite );
+
+	/* Wake up the given sleeping sprite
+	 * it is updated until sleeping is valid again
+	*/
+	void Wake( cSprite *sprite );
+	/* Set the active items from the sprites which can not sleep, the woken up sprites
+	 * and the sleeping sprites in the active region around the camera and player
+	*/
+	void Update_Active_Items( void );
+	// if the sprite is in the active region
+	bool Is_In_Active_Region( const cSprite *sprite ) const;
+	// Add the new sprite to the awake or active items
+	void Add_Active_Item( cSprite *sprite );
+
+	/* Return the sprite array number
+	 * if not added to this manager returns -1
+	*/
+	virtual int Get_Array_Num( cSprite *obj ) const;
+	/* Set the sprite array numbers and free slots from the given array number
+	 * must be called if the objects array is changed directly
+	*/
+	void Renumber( size_t start = 0 );
+
+	// Return the handle of the sprite
+	cSprite_Handle Get_Handle( cSprite *obj ) const;
+	/* Return the sprite of the handle
+	 * if not valid anymore returns NULL
+	*/
+	cSprite *Get_From_Handle( const cSprite_Handle &handle ) const;
+
 	// Update items drawing validation
 	void Update_Items_Valid_Draw( void );
-	// Update items
+	// Update the active items
 	void Update_Items( void );
-	// Update_Late items
+	// Update_Late the active items
 	void Update_Items_Late( void );
-	// Draw items
+	/* Draw items
+	 * static items are drawn from their chunks
+	*/
 	void Draw_Items( void );
-	// Create Collision data and Handle the collisions
+	// Create Collision data and Handle the collisions of the active items
 	void Handle_Collision_Items( void );
 
+	// Save the item positions before the next fixed timestep update
+	void Save_Tick_Positions( void );
+	/* Set the item positions between the position before the last fixed timestep update
+	 * and the current position for drawing
+	 * alpha : 0 is the position before and 1 the position after the update
+	*/
+	void Set_Interpolated_Positions( float alpha );
+	// Restore the current positions after drawing
+	void Restore_Positions( void );
+
 
 	/* Return the current size
 	 * of the specified sprite array
@@ -104,6 +176,36 @@ public:
 		}
 	};
 
+	// collision grid of all objects
+	mutable cSprite_Grid m_grid;
+	// static objects drawn from vertex arrays
+	cSprite_Chunks m_chunks;
+	// number of collision queries and returned objects since the last reset ( used by the benchmark )
+	mutable unsigned int m_collision_queries;
+	mutable unsigned int m_collision_results;
+	// current item positions while drawing interpolated positions
+	vector<float> m_draw_positions;
+
+	typedef vector<unsigned int> Item_Num_List;
+	// array numbers of the items updated in the current frame
+	Item_Num_List m_active_items;
+	// array numbers of the items which can not sleep
+	Item_Num_List m_awake_items;
+	// array numbers of the woken up items
+	Item_Num_List m_woken_items;
+	// if set the awake and woken up items need to be rebuild
+	bool m_sleep_changed;
+	// current active items frame
+	unsigned int m_active_frame;
+	// biggest player range of the items which can sleep
+	unsigned int m_max_player_range;
+	// sleeping items found in the active region
+	cSprite_List m_region_objects;
+	// array numbers of the destroyed items which can be replaced
+	Item_Num_List m_free_slots;
+	// generation given to the next added sprite
+	unsigned int m_next_generation;
+
 	// Editor Z position sort
 	struct editor_zpos_sort
 	{
@@ -0,0 +1,185 @@
+/***************************************************************************
+ * worker_pool.cpp  -  worker threads for background jobs
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/worker_pool.h"
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <unistd.h>
+#endif
+
+namespace SMC
+{
+
+/* *** *** *** *** *** *** cWorker_Pool *** *** *** *** *** *** *** *** *** *** *** */
+
+cWorker_Pool :: cWorker_Pool( unsigned int thread_count /* = 0 */ )
+{
+	m_mutex = SDL_CreateMutex();
+	m_job_cond = SDL_CreateCond();
+	m_finished_cond = SDL_CreateCond();
+	m_added = 0;
+	m_finished = 0;
+	m_quit = 0;
+
+	if( !thread_count )
+	{
+		thread_count = Get_Processor_Count();
+	}
+
+	for( unsigned int i = 0; i < thread_count; i++ )
+	{
+		SDL_Thread *thread = SDL_CreateThread( &cWorker_Pool::Thread_Function, this );
+
+		if( !thread )
+		{
+			printf( "Warning : Could not create worker thread : %s\n", SDL_GetError() );
+			break;
+		}
+
+		m_threads.push_back( thread );
+	}
+}
+
+cWorker_Pool :: ~cWorker_Pool( void )
+{
+	Wait();
+
+	SDL_LockMutex( m_mutex );
+	m_quit = 1;
+	SDL_CondBroadcast( m_job_cond );
+	SDL_UnlockMutex( m_mutex );
+
+	for( vector<SDL_Thread *>::iterator itr = m_threads.begin(), itr_end = m_threads.end(); itr != itr_end; ++itr )
+	{
+		SDL_WaitThread( *itr, NULL );
+	}
+
+	m_threads.clear();
+
+	SDL_DestroyCond( m_finished_cond );
+	SDL_DestroyCond( m_job_cond );
+	SDL_DestroyMutex( m_mutex );
+}
+
+void cWorker_Pool :: Add( cWorker_Job *job )
+{
+	// no threads available
+	if( m_threads.empty() )
+	{
+		job->Run();
+		m_added++;
+		m_finished++;
+		return;
+	}
+
+	SDL_LockMutex( m_mutex );
+	m_jobs.push_back( job );
+	m_added++;
+	SDL_CondSignal( m_job_cond );
+	SDL_UnlockMutex( m_mutex );
+}
+
+void cWorker_Pool :: Wait( void )
+{
+	SDL_LockMutex( m_mutex );
+
+	while( m_finished < m_added )
+	{
+		SDL_CondWait( m_finished_cond, m_mutex );
+	}
+
+	SDL_UnlockMutex( m_mutex );
+}
+
+unsigned int cWorker_Pool :: Wait_Finished( unsigned int count )
+{
+	SDL_LockMutex( m_mutex );
+
+	while( m_finished <= count && m_finished < m_added )
+	{
+		SDL_CondWait( m_finished_cond, m_mutex );
+	}
+
+	const unsigned int finished = m_finished;
+	SDL_UnlockMutex( m_mutex );
+
+	return finished;
+}
+
+unsigned int cWorker_Pool :: Get_Processor_Count( void )
+{
+	int count;
+
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	count = info.dwNumberOfProcessors;
+#else
+	count = sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+
+	if( count < 1 )
+	{
+		return 1;
+	}
+	// more threads would only wait for the disk
+	if( count > 16 )
+	{
+		return 16;
+	}
+
+	return count;
+}
+
+int cWorker_Pool :: Thread_Function( void *data )
+{
+	static_cast<cWorker_Pool *>(data)->Run_Jobs();
+	return 0;
+}
+
+void cWorker_Pool :: Run_Jobs( void )
+{
+	SDL_LockMutex( m_mutex );
+
+	for( ;; )
+	{
+		while( m_jobs.empty() && !m_quit )
+		{
+			SDL_CondWait( m_job_cond, m_mutex );
+		}
+
+		if( m_jobs.empty() )
+		{
+			break;
+		}
+
+		cWorker_Job *job = m_jobs.front();
+		m_jobs.pop_front();
+
+		SDL_UnlockMutex( m_mutex );
+		job->Run();
+		SDL_LockMutex( m_mutex );
+
+		m_finished++;
+		SDL_CondBroadcast( m_finished_cond );
+	}
+
+	SDL_UnlockMutex( m_mutex );
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
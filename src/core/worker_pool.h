@@ -0,0 +1,97 @@
+/***************************************************************************
+ * worker_pool.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_WORKER_POOL_H
+#define SMC_WORKER_POOL_H
+
+#include "../core/global_basic.h"
+#include <deque>
+// SDL
+#include "SDL.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cWorker_Job *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Job run by a worker thread
+ * Jobs may not use OpenGL, CEGUI or any other not thread safe game data.
+*/
+class cWorker_Job
+{
+public:
+	virtual ~cWorker_Job( void ) {};
+
+	// Run the job
+	virtual void Run( void ) = 0;
+};
+
+/* *** *** *** *** *** cWorker_Pool *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Runs jobs in worker threads
+ * Jobs are started in the order they were added.
+ * If no thread could be created the jobs are run directly.
+*/
+class cWorker_Pool
+{
+public:
+	// if thread count is not set the processor count is used
+	cWorker_Pool( unsigned int thread_count = 0 );
+	// waits for all jobs to finish
+	~cWorker_Pool( void );
+
+	/* Add a job
+	 * the job is not deleted by the pool
+	*/
+	void Add( cWorker_Job *job );
+	// Wait until all jobs are finished
+	void Wait( void );
+	/* Wait until more than the given number of jobs are finished
+	 * returns the finished job count
+	*/
+	unsigned int Wait_Finished( unsigned int count );
+
+	// Return the number of available processors
+	static unsigned int Get_Processor_Count( void );
+
+private:
+	// Thread entry point
+	static int Thread_Function( void *data );
+	// Run jobs until the pool gets deleted
+	void Run_Jobs( void );
+
+	// worker threads
+	vector<SDL_Thread *> m_threads;
+	// locks the job data
+	SDL_mutex *m_mutex;
+	// signaled if a job is added or the pool quits
+	SDL_cond *m_job_cond;
+	// signaled if a job is finished
+	SDL_cond *m_finished_cond;
+
+	// waiting jobs
+	std::deque<cWorker_Job *> m_jobs;
+	// added and finished job count
+	unsigned int m_added;
+	unsigned int m_finished;
+	// if set the threads exit
+	bool m_quit;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
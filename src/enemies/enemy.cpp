@@ -32,6 +32,8 @@ cEnemy :: cEnemy( float x /* = 0.0f */, float y /* = 0.0f */ )
 	m_type = TYPE_ENEMY;
 
 	m_player_range = 1500;
+	// updates only in player range
+	m_can_sleep = 1;
 
 	m_massive_type = MASS_MASSIVE;
 	m_state = STA_FALL;
@@ -231,6 +233,17 @@ void cEnemy :: Update_Gravity( void )
 	}
 }
 
+bool cEnemy :: Is_Sleep_Valid( void ) const
+{
+	// dying, frozen or controlled by another object
+	if( ( m_dead && m_active ) || m_freeze_counter > 0.0f || m_state == STA_OBJ_LINKED )
+	{
+		return 0;
+	}
+
+	return cAnimated_Sprite::Is_Sleep_Valid();
+}
+
 void cEnemy :: Generate_Hit_Animation( cParticle_Emitter *anim /* = NULL */ ) const
 {
 	bool create_anim = 0;
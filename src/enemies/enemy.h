@@ -51,6 +51,8 @@ public:
 	virtual void Update_Late( void );
 	// update gravity velocity
 	virtual void Update_Gravity( void );
+	// if sleeping is valid
+	virtual bool Is_Sleep_Valid( void ) const;
 	
 	// Generates the default Hit Animation Particles
 	void Generate_Hit_Animation( cParticle_Emitter *anim = NULL ) const;
@@ -19,6 +19,7 @@
 #include "../audio/audio.h"
 #include "../video/font.h"
 #include "../core/framerate.h"
+#include "../core/profiler.h"
 #include "../level/level.h"
 #include "../core/sprite_manager.h"
 #include "../objects/bonusbox.h"
@@ -56,9 +57,64 @@ cHudSprite *cHudSprite :: Copy( void )
 	hud_sprite->Set_Shadow_Pos( m_shadow_pos );
 	hud_sprite->Set_Shadow_Color( m_shadow_color );
 
+	if( !m_font_text.Is_Empty() )
+	{
+		hud_sprite->Set_Font_Text( m_font_text.m_font, m_font_text.m_text, m_font_text_color );
+	}
+
 	return hud_sprite;
 }
 
+void cHudSprite :: Set_Font_Text( TTF_Font *font, const std::string &text, const Color &color /* = static_cast<Uint8>(255) */ )
+{
+	Set_Image( NULL );
+
+	pFont->Layout_Text( m_font_text, font, text );
+	m_font_text_color = color;
+
+	// size
+	m_rect.m_w = static_cast<float>(m_font_text.m_width);
+	m_rect.m_h = static_cast<float>(m_font_text.m_height);
+	m_col_rect.m_w = m_rect.m_w;
+	m_col_rect.m_h = m_rect.m_h;
+
+	Update_Valid_Draw();
+}
+
+void cHudSprite :: Clear_Font_Text( void )
+{
+	m_font_text.Clear();
+	Set_Image( NULL );
+}
+
+void cHudSprite :: Draw( cSurface_Request *request /* = NULL */ )
+{
+	if( !m_valid_draw )
+	{
+		return;
+	}
+
+	// text
+	if( !m_font_text.Is_Empty() )
+	{
+		m_font_text.Draw( m_pos_x, m_pos_y, m_pos_z, m_font_text_color, m_shadow_pos, m_shadow_color, m_no_camera );
+		return;
+	}
+
+	cSprite::Draw( request );
+}
+
+bool cHudSprite :: Is_Draw_Valid( void )
+{
+	// text has no image
+	if( !m_font_text.Is_Empty() )
+	{
+		return m_active;
+	}
+
+	return cSprite::Is_Draw_Valid();
+}
+
 /* *** *** *** *** *** *** *** cHud_Manager *** *** *** *** *** *** *** *** *** *** */
 
 cHud_Manager :: cHud_Manager( void )
@@ -415,7 +471,7 @@ void cPlayerPoints :: Draw( cSurface_Request *request /* = NULL */ )
 		PointsText *obj = (*itr);
 		
 		// if finished
-		if( !obj->m_image )
+		if( obj->m_font_text.Is_Empty() )
 		{
 			itr = m_points_objects.erase( itr );
 			delete obj;
@@ -428,7 +484,7 @@ void cPlayerPoints :: Draw( cSurface_Request *request /* = NULL */ )
 
 			if( obj->m_vely > -1.0f )
 			{
-				obj->Set_Image( NULL );
+				obj->Clear_Font_Text();
 				continue;
 			}
 
@@ -457,19 +513,13 @@ void cPlayerPoints :: Draw( cSurface_Request *request /* = NULL */ )
 				y = game_res_h - obj->m_col_rect.m_h - 20.0f;
 			}
 
-			// create request
-			cSurface_Request *request = new cSurface_Request();
-			obj->m_image->Blit( x, y, m_pos_z, request );
-
-			// shadow
-			request->shadow_color = black;
-			request->shadow_pos = 1;
-
-			// color
-			request->color = Color( static_cast<Uint8>( 255 - ( obj->m_points / 150 ) ), static_cast<Uint8>( 255 - ( obj->m_points / 150 ) ), static_cast<Uint8>( 255 - ( obj->m_points / 30 ) ) );
+			// text color darkened by the points
+			Color color = obj->m_font_text_color;
+			color.red = static_cast<Uint8>( ( color.red * ( 255 - ( obj->m_points / 150 ) ) ) / 255 );
+			color.green = static_cast<Uint8>( ( color.green * ( 255 - ( obj->m_points / 150 ) ) ) / 255 );
+			color.blue = static_cast<Uint8>( ( color.blue * ( 255 - ( obj->m_points / 30 ) ) ) / 255 );
 
-			// add request
-			pRenderer->Add( request );
+			obj->m_font_text.Draw( x, y, m_pos_z, color, 1.0f, black );
 
 			++itr;
 		}
@@ -482,7 +532,7 @@ void cPlayerPoints :: Set_Points( long points )
 
 	char text[70];
 	sprintf( text, _("Points %08d"), static_cast<int>(pPlayer->points) );
-	Set_Image( pFont->Render_Text( pFont->m_font_normal, text, white ), 0, 1 );
+	Set_Font_Text( pFont->m_font_normal, text, white );
 }
 
 void cPlayerPoints :: Add_Points( unsigned int points, float x /* = 0.0f */, float y /* = 0.0f */, std::string strtext /* = "" */, const Color &color /* = static_cast<Uint8>(255) */, bool allow_multiplier /* = 0 */ )
@@ -506,7 +556,7 @@ void cPlayerPoints :: Add_Points( unsigned int points, float x /* = 0.0f */, flo
 	}
 
 	PointsText *new_obj = new PointsText();
-	new_obj->Set_Image( pFont->Render_Text( pFont->m_font_small, strtext, color ), 1, 1 );
+	new_obj->Set_Font_Text( pFont->m_font_small, strtext, color );
 
 	new_obj->Set_Pos( x, y );
 	new_obj->m_vely = -1.4f;
@@ -580,7 +630,7 @@ void cGoldDisplay :: Set_Gold( int gold )
 
 	Color color = Color( static_cast<Uint8>(255), 255, 255 - ( gold * 2 ) );
 
-	Set_Image( pFont->Render_Text( pFont->m_font_normal, text, color ), 0, 1 );
+	Set_Font_Text( pFont->m_font_normal, text, color );
 }
 
 void cGoldDisplay :: Add_Gold( int gold )
@@ -599,7 +649,7 @@ cLiveDisplay :: cLiveDisplay( float x /* = 0.0f */, float y /* = 0.0f */ )
 
 	Set_Lives( pPlayer->lives );
 
-	Set_Image( NULL );
+	Clear_Font_Text();
 }
 
 cLiveDisplay :: ~cLiveDisplay( void )
@@ -638,15 +688,10 @@ void cLiveDisplay :: Set_Lives( int lives )
 		text = _("Lives : ") + int_to_string( pPlayer->lives );
 	}
 
-	Set_Image( pFont->Render_Text( pFont->m_font_normal, text, green ), 0, 1 );
+	Set_Font_Text( pFont->m_font_normal, text, green );
 
 	// set position
-	int w, h;
-
-	if( TTF_SizeText( pFont->m_font_normal, text.c_str(), &w, &h ) == 0 )
-	{
-		Set_Pos_X( (game_res_w * 0.94f) - w );
-	}
+	Set_Pos_X( (game_res_w * 0.94f) - m_font_text.m_width );
 }
 
 void cLiveDisplay :: Add_Lives( int lives )
@@ -700,7 +745,7 @@ void cTimeDisplay :: Update( void )
 
 	// Set new time
 	sprintf( m_text, _("Time %02d:%02d"), minutes, seconds - ( minutes * 60 ) );
-	Set_Image( pFont->Render_Text( pFont->m_font_normal, m_text, white ), 0, 1 );
+	Set_Font_Text( pFont->m_font_normal, m_text, white );
 }
 
 void cTimeDisplay :: Draw( cSurface_Request *request /* = NULL */ )
@@ -1661,8 +1706,8 @@ cDebugDisplay :: cDebugDisplay( float x /* = 0.0f */, float y /* = 0.0f */ )
 	m_sprites[2]->Set_Pos( 480.0f, 5.0f, 1 );
 
 	// Debug type text
-	m_sprites[4]->Set_Image( pFont->Render_Text( pFont->m_font_small, _("Level"), lightblue ), 0, 1 );
-	m_sprites[16]->Set_Image( pFont->Render_Text( pFont->m_font_small, _("Player"), lightblue ), 0, 1 );
+	m_sprites[4]->Set_Font_Text( pFont->m_font_small, _("Level"), lightblue );
+	m_sprites[16]->Set_Font_Text( pFont->m_font_small, _("Player"), lightblue );
 
 	m_counter = 0.0f;
 }
@@ -1751,11 +1796,11 @@ void cDebugDisplay :: Set_Text( const std::string &ntext, float display_time /*
 void cDebugDisplay :: Draw_fps( void )
 {
 	// ### Frames per Second
-	m_sprites[0]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, _("FPS : best ") + int_to_string( static_cast<int>(pFramerate->m_fps_best) ) + _(", worst ") + int_to_string( static_cast<int>(pFramerate->m_fps_worst) ) + _(", current ") + int_to_string( static_cast<int>(pFramerate->m_fps) ), white ), 0, 1 );
+	m_sprites[0]->Set_Font_Text( pFont->m_font_very_small, _("FPS : best ") + int_to_string( static_cast<int>(pFramerate->m_fps_best) ) + _(", worst ") + int_to_string( static_cast<int>(pFramerate->m_fps_worst) ) + _(", current ") + int_to_string( static_cast<int>(pFramerate->m_fps) ), white );
 	// average
-	m_sprites[1]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, _("average ") + int_to_string( static_cast<int>(pFramerate->m_fps_average) ), white ), 0, 1 );
+	m_sprites[1]->Set_Font_Text( pFont->m_font_very_small, _("average ") + int_to_string( static_cast<int>(pFramerate->m_fps_average) ), white );
 	// speed factor
-	m_sprites[2]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, _("Speed factor ") + float_to_string( pFramerate->m_speed_factor, 4 ), white ), 0, 1 );
+	m_sprites[2]->Set_Font_Text( pFont->m_font_very_small, _("Speed factor ") + float_to_string( pFramerate->m_speed_factor, 4 ), white );
 }
 
 void cDebugDisplay :: Draw_Debug_Mode( void )
@@ -1792,7 +1837,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 
 	// Camera position
 	temp_text = _("Camera : X ") + int_to_string( static_cast<int>(pActive_Camera->x) ) + ", Y " + int_to_string( static_cast<int>(pActive_Camera->y) );
-	m_sprites[3]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+	m_sprites[3]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 
 	// Level information
 	if( pActive_Level->m_level_filename.compare( m_level_old ) != 0 ) 
@@ -1800,7 +1845,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		std::string lvl_text = _("Name : ") + Trim_Filename( pActive_Level->m_level_filename, 0, 0 );
 		m_level_old = pActive_Level->m_level_filename;
 
-		m_sprites[5]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, lvl_text, white ), 0, 1 );
+		m_sprites[5]->Set_Font_Text( pFont->m_font_very_small, lvl_text, white );
 	}
 
 	// Level objects
@@ -1809,7 +1854,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		m_obj_counter = pActive_Sprite_Manager->size();
 
 		temp_text = _("Objects : ") + int_to_string( m_obj_counter );
-		m_sprites[6]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[6]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	}
 	// Passive
 	if( m_pass_counter != static_cast<int>(pActive_Sprite_Manager->Get_Size_Array( ARRAY_PASSIVE )) )
@@ -1817,7 +1862,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		m_pass_counter = pActive_Sprite_Manager->Get_Size_Array( ARRAY_PASSIVE );
 
 		temp_text = _("Passive : ") + int_to_string( m_pass_counter );
-		m_sprites[7]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[7]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	}
 	// Massive
 	if( m_mass_counter != static_cast<int>(pActive_Sprite_Manager->Get_Size_Array( ARRAY_MASSIVE )) )
@@ -1825,7 +1870,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		m_mass_counter = pActive_Sprite_Manager->Get_Size_Array( ARRAY_MASSIVE );
 
 		temp_text = _("Massive : ") + int_to_string( m_mass_counter );
-		m_sprites[8]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[8]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	}
 	// Enemy
 	if( m_enemy_counter != static_cast<int>(pActive_Sprite_Manager->Get_Size_Array( ARRAY_ENEMY )) ) 
@@ -1833,7 +1878,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		m_enemy_counter = pActive_Sprite_Manager->Get_Size_Array( ARRAY_ENEMY );
 
 		temp_text = _("Enemy : ") + int_to_string( m_enemy_counter );
-		m_sprites[9]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[9]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	}
 	// Active
 	if( m_active_counter != static_cast<int>(pActive_Sprite_Manager->Get_Size_Array( ARRAY_ACTIVE )) )
@@ -1841,7 +1886,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		m_active_counter = pActive_Sprite_Manager->Get_Size_Array( ARRAY_ACTIVE );
 
 		temp_text = _("Active : ") + int_to_string( m_active_counter );
-		m_sprites[10]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[10]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 
 		// Halfmassive
 		unsigned int halfmassive = 0;
@@ -1858,7 +1903,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		}
 
 		temp_text = _("Halfmassive : ") + int_to_string( halfmassive );
-		m_sprites[11]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[11]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 
 		// Moving Platform
 		unsigned int moving_platform = 0;
@@ -1875,7 +1920,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		}
 
 		temp_text = _("Moving Platform : ") + int_to_string( moving_platform );
-		m_sprites[12]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[12]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 
 		// Goldbox
 		unsigned int goldbox = 0;
@@ -1897,7 +1942,7 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		}
 
 		temp_text = _("Goldbox : ") + int_to_string( goldbox );
-		m_sprites[13]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[13]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 
 		// Bonusbox
 		unsigned int bonusbox_count = 0;
@@ -1919,28 +1964,28 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		}
 
 		temp_text = _("Bonusbox : ") + int_to_string( bonusbox_count );
-		m_sprites[14]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[14]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 
 		// Other
 		unsigned int active_other = m_active_counter - halfmassive - moving_platform - goldbox - bonusbox_count;
 
 		temp_text = _("Other : ") + int_to_string( active_other );
-		m_sprites[15]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+		m_sprites[15]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	}
 
 	// Player information
 	// position x
 	temp_text = "X1 " + float_to_string( pActive_Player->m_pos_x, 4 ) + "  X2 " + float_to_string( pPlayer->m_col_rect.m_x + pPlayer->m_col_rect.m_w, 4 );
-	m_sprites[17]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+	m_sprites[17]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	// position y
 	temp_text = "Y1 " + float_to_string( pActive_Player->m_pos_y, 4 ) + "  Y2 " + float_to_string( pPlayer->m_col_rect.m_y + pPlayer->m_col_rect.m_h, 4 );
-	m_sprites[18]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+	m_sprites[18]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	// velocity
 	temp_text = _("Velocity X ") + float_to_string( pPlayer->m_velx, 2 ) + " ,Y " + float_to_string( pPlayer->m_vely, 2 );
-	m_sprites[19]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+	m_sprites[19]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	// moving state
 	temp_text = _("Moving State ") + int_to_string( static_cast<int>(pPlayer->m_state) );
-	m_sprites[20]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+	m_sprites[20]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	// ground type
 	std::string ground_type;
 	if( pPlayer->m_ground_object )
@@ -1948,11 +1993,11 @@ void cDebugDisplay :: Draw_Debug_Mode( void )
 		ground_type = int_to_string( pPlayer->m_ground_object->m_massive_type ) + " (" + Get_Massive_Type_Name( pPlayer->m_ground_object->m_massive_type ) + ")";
 	}
 	temp_text = _("Ground ") + ground_type;
-	m_sprites[21]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, temp_text, white ), 0, 1 );
+	m_sprites[21]->Set_Font_Text( pFont->m_font_very_small, temp_text, white );
 	// game mode
 	if( Game_Mode != m_game_mode_last )
 	{
-		m_sprites[22]->Set_Image( pFont->Render_Text( pFont->m_font_very_small, _("Game Mode : ") + int_to_string( Game_Mode ), white ), 0, 1 );
+		m_sprites[22]->Set_Font_Text( pFont->m_font_very_small, _("Game Mode : ") + int_to_string( Game_Mode ), white );
 	}
 
 	// draw text
@@ -1993,7 +2038,7 @@ void cDebugDisplay :: Draw_Performance_Debug_Mode( void )
 	// overworld
 	if( Game_Mode == MODE_OVERWORLD )
 	{
-		text_strings.push_back( _("World : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_OVERWORLD]->ms ) );
+		text_strings.push_back( _("World : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_OVERWORLD ), 3 ) );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
@@ -2002,7 +2047,7 @@ void cDebugDisplay :: Draw_Performance_Debug_Mode( void )
 	// menu
 	else if( Game_Mode == MODE_MENU )
 	{
-		text_strings.push_back( _("Menu : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_MENU]->ms ) );
+		text_strings.push_back( _("Menu : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_MENU ), 3 ) );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
@@ -2011,7 +2056,7 @@ void cDebugDisplay :: Draw_Performance_Debug_Mode( void )
 	// level settings
 	else if( Game_Mode == MODE_LEVEL_SETTINGS )
 	{
-		text_strings.push_back( _("Level Settings : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_LEVEL_SETTINGS]->ms ) );
+		text_strings.push_back( _("Level Settings : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_LEVEL_SETTINGS ), 3 ) );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
@@ -2020,19 +2065,19 @@ void cDebugDisplay :: Draw_Performance_Debug_Mode( void )
 	// level (default)
 	else
 	{
-		text_strings.push_back( _("Level Layer 1 : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_LEVEL_LAYER1]->ms ) );
-		text_strings.push_back( _("Level Player : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_LEVEL_PLAYER]->ms ) );
-		text_strings.push_back( _("Level Layer 2 : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_LEVEL_LAYER2]->ms ) );
-		text_strings.push_back( _("Level Hud : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_LEVEL_HUD]->ms ) );
-		text_strings.push_back( _("Level Editor : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_LEVEL_EDITOR]->ms ) );
+		text_strings.push_back( _("Level Layer 1 : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_LEVEL_LAYER1 ), 3 ) );
+		text_strings.push_back( _("Level Player : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_LEVEL_PLAYER ), 3 ) );
+		text_strings.push_back( _("Level Layer 2 : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_LEVEL_LAYER2 ), 3 ) );
+		text_strings.push_back( _("Level Hud : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_LEVEL_HUD ), 3 ) );
+		text_strings.push_back( _("Level Editor : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_LEVEL_EDITOR ), 3 ) );
 	}
-	text_strings.push_back( _("Mouse : ") + int_to_string( pFramerate->m_perf_timer[PERF_DRAW_MOUSE]->ms ) );
+	text_strings.push_back( _("Mouse : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_DRAW_MOUSE ), 3 ) );
 	// update
 	text_strings.push_back( _("Update") );
 	// overworld
 	if( Game_Mode == MODE_OVERWORLD )
 	{
-		text_strings.push_back( _("World : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_OVERWORLD]->ms ) );
+		text_strings.push_back( _("World : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_OVERWORLD ), 3 ) );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
@@ -2045,7 +2090,7 @@ void cDebugDisplay :: Draw_Performance_Debug_Mode( void )
 	// menu
 	else if( Game_Mode == MODE_MENU )
 	{
-		text_strings.push_back( _("Menu : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_MENU]->ms ) );
+		text_strings.push_back( _("Menu : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_MENU ), 3 ) );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
@@ -2058,7 +2103,7 @@ void cDebugDisplay :: Draw_Performance_Debug_Mode( void )
 	// level settings
 	else if( Game_Mode == MODE_LEVEL_SETTINGS )
 	{
-		text_strings.push_back( _("Level Settings : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_LEVEL_SETTINGS]->ms ) );
+		text_strings.push_back( _("Level Settings : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_LEVEL_SETTINGS ), 3 ) );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
 		text_strings.push_back( "- " );
@@ -2071,22 +2116,22 @@ void cDebugDisplay :: Draw_Performance_Debug_Mode( void )
 	// level (default)
 	else
 	{
-		text_strings.push_back( _("process input : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_PROCESS_INPUT]->ms ) );
-		text_strings.push_back( _("level : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_LEVEL]->ms ) );
-		text_strings.push_back( _("level editor : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_LEVEL_EDITOR]->ms ) );
-		text_strings.push_back( _("hud : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_HUD]->ms ) );
-		text_strings.push_back( _("player : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_PLAYER]->ms ) );
-		text_strings.push_back( _("player collisions : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_PLAYER_COLLISIONS]->ms ) );
-		text_strings.push_back( _("level late : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_LATE_LEVEL]->ms ) );
-		text_strings.push_back( _("level collisions : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_LEVEL_COLLISIONS]->ms ) );
-		text_strings.push_back( _("camera : ") + int_to_string( pFramerate->m_perf_timer[PERF_UPDATE_CAMERA]->ms ) );
+		text_strings.push_back( _("process input : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_PROCESS_INPUT ), 3 ) );
+		text_strings.push_back( _("level : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_LEVEL ), 3 ) );
+		text_strings.push_back( _("level editor : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_LEVEL_EDITOR ), 3 ) );
+		text_strings.push_back( _("hud : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_HUD ), 3 ) );
+		text_strings.push_back( _("player : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_PLAYER ), 3 ) );
+		text_strings.push_back( _("player collisions : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_PLAYER_COLLISIONS ), 3 ) );
+		text_strings.push_back( _("level late : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_LATE_LEVEL ), 3 ) );
+		text_strings.push_back( _("level collisions : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_LEVEL_COLLISIONS ), 3 ) );
+		text_strings.push_back( _("camera : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_UPDATE_CAMERA ), 3 ) );
 	}
 
 	// render
 	text_strings.push_back( _("Render") );
-	text_strings.push_back( _("Game : ") + int_to_string( pFramerate->m_perf_timer[PERF_RENDER_GAME]->ms ) );
-	text_strings.push_back( _("Gui : ") + int_to_string( pFramerate->m_perf_timer[PERF_RENDER_GUI]->ms ) );
-	text_strings.push_back( _("Buffer : ") + int_to_string( pFramerate->m_perf_timer[PERF_RENDER_BUFFER]->ms ) );
+	text_strings.push_back( _("Game : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_RENDER_GAME ), 3 ) );
+	text_strings.push_back( _("Gui : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_RENDER_GUI ), 3 ) );
+	text_strings.push_back( _("Buffer : ") + float_to_string( pProfiler->Get_Zone_Time( PERF_RENDER_BUFFER ), 3 ) );
 
 	unsigned int pos = 0;
 
@@ -18,6 +18,7 @@
 
 #include "../objects/movingsprite.h"
 #include "../core/obj_manager.h"
+#include "../video/font.h"
 
 namespace SMC
 {
@@ -32,6 +33,23 @@ public:
 	
 	// copy this sprite
 	virtual cHudSprite *Copy( void );
+
+	/* Draw the text from the glyph atlas instead of an image
+	 * the layout is kept if the font and text did not change
+	*/
+	void Set_Font_Text( TTF_Font *font, const std::string &text, const Color &color = static_cast<Uint8>(255) );
+	// Remove the text
+	void Clear_Font_Text( void );
+
+	// draw
+	virtual void Draw( cSurface_Request *request = NULL );
+	// if draw is valid for the current state
+	virtual bool Is_Draw_Valid( void );
+
+	// laid out text
+	cText_Layout m_font_text;
+	// text color
+	Color m_font_text_color;
 };
 
 /* *** *** *** *** *** *** *** cHud_Manager *** *** *** *** *** *** *** *** *** *** */
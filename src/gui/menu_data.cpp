@@ -33,6 +33,7 @@
 #include "../core/math/size.h"
 #include "../core/filesystem/filesystem.h"
 #include "../core/filesystem/resource_manager.h"
+#include "../level/level_binary.h"
 // boost filesystem
 #include "boost/filesystem/convenience.hpp"
 namespace fs = boost::filesystem;
@@ -502,6 +503,12 @@ void cMenu_Start :: Get_Levels( std::string dir, CEGUI::colour color )
 		// remove base directory
 		lvl_name.erase( 0, dir_length );
 
+		// ignore compiled levels
+		if( lvl_name.rfind( ".smclvlb" ) != std::string::npos )
+		{
+			continue;
+		}
+
 		// erase file type only if smclvl
 		if( lvl_name.rfind( ".smclvl" ) != std::string::npos )
 		{
@@ -982,6 +989,7 @@ bool cMenu_Start :: Button_Level_Delete_Clicked( const CEGUI::EventArgs &event )
 		if( pActive_Level->Get_Path( filename, 1 ) )
 		{
 			Delete_File( filename );
+			Delete_File( Get_Level_Binary_Filename( filename ) );
 			listbox_levels->removeItem( item );
 		}
 	}
@@ -21,6 +21,7 @@
 #include "../gui/menu.h"
 #include "../overworld/overworld.h"
 #include "../core/framerate.h"
+#include "../core/profiler.h"
 #include "../audio/audio.h"
 #include "../level/level.h"
 #include "../user/preferences.h"
@@ -291,11 +292,15 @@ bool cKeyboard :: Key_Down( SDLKey key )
 		if( game_debug_performance )
 		{
 			pHud_Debug->Set_Text( "Performance debug mode disabled" );
+			// save the recorded frames
+			pProfiler->Save();
 		}
 		else
 		{
 			pFramerate->m_fps_worst = 1000;
 			pFramerate->m_fps_best = 0;
+			// start a new recording
+			pProfiler->Reset();
 			pHud_Debug->Set_Text( "Performance debug mode  enabled" );
 		}
 
@@ -0,0 +1,475 @@
+/***************************************************************************
+ * replay.cpp  -  input recording and replay
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../input/replay.h"
+#include "../core/game_core.h"
+
+namespace SMC
+{
+
+// file identifier
+static const char replay_magic[4] = { 'S', 'M', 'C', 'R' };
+
+/* *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** *** */
+
+// Add the value in little endian byte order with the given number of bytes
+static void Write_Uint( std::string &data, unsigned int value, unsigned int bytes = 4 )
+{
+	for( unsigned int i = 0; i < bytes; i++ )
+	{
+		data += static_cast<char>(( value >> ( i * 8 ) ) & 0xFF);
+	}
+}
+
+/* Read a little endian value with the given number of bytes and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Uint( const std::string &data, size_t &pos, unsigned int &value, unsigned int bytes = 4 )
+{
+	if( pos + bytes > data.size() )
+	{
+		return 0;
+	}
+
+	value = 0;
+
+	for( unsigned int i = 0; i < bytes; i++ )
+	{
+		value |= static_cast<unsigned int>(static_cast<unsigned char>(data[pos + i])) << ( i * 8 );
+	}
+
+	pos += bytes;
+
+	return 1;
+}
+
+/* *** *** *** *** *** *** cReplay *** *** *** *** *** *** *** *** *** *** *** */
+
+cReplay :: cReplay( void )
+{
+	m_mode = REPLAY_NONE;
+	m_seed = 0;
+	m_frame_count = 0;
+	m_pos = 0;
+	m_frame_event_count = 0;
+	m_frame_speed_factor = 1.0f;
+	m_frame_elapsed_ticks = 1;
+}
+
+cReplay :: ~cReplay( void )
+{
+	Stop();
+}
+
+void cReplay :: Start_Recording( const std::string &filename, const std::string &level /* = "" */ )
+{
+	Stop();
+
+	m_mode = REPLAY_RECORD;
+	m_filename = filename;
+	m_level = level;
+	m_seed = static_cast<unsigned int>(time( NULL ));
+	m_frame_count = 0;
+	m_frame_events.clear();
+	m_frame_event_count = 0;
+
+	// header
+	m_data.assign( replay_magic, sizeof(replay_magic) );
+	Write_Uint( m_data, replay_version );
+	Write_Uint( m_data, m_seed );
+	Write_Uint( m_data, m_level.length() );
+	m_data += m_level;
+
+	srand( m_seed );
+
+	printf( "Recording input to %s\n", m_filename.c_str() );
+}
+
+bool cReplay :: Start_Replay( const std::string &filename )
+{
+	Stop();
+
+	ifstream ifs( filename.c_str(), ios::in | ios::binary );
+
+	if( !ifs )
+	{
+		printf( "Error : Couldn't open replay file %s\n", filename.c_str() );
+		return 0;
+	}
+
+	// read the whole file
+	std::string data;
+	ifs.seekg( 0, ios::end );
+	data.resize( static_cast<size_t>(ifs.tellg()) );
+	ifs.seekg( 0, ios::beg );
+
+	if( data.size() < sizeof(replay_magic) || !ifs.read( &data[0], data.size() ) || data.compare( 0, sizeof(replay_magic), replay_magic, sizeof(replay_magic) ) != 0 )
+	{
+		printf( "Error : Replay file %s is not valid\n", filename.c_str() );
+		return 0;
+	}
+
+	ifs.close();
+
+	size_t pos = sizeof(replay_magic);
+	unsigned int version, seed, level_length;
+
+	if( !Read_Uint( data, pos, version ) || version != replay_version || !Read_Uint( data, pos, seed ) || !Read_Uint( data, pos, level_length ) || pos + level_length > data.size() )
+	{
+		printf( "Error : Replay file %s is not valid or from another version\n", filename.c_str() );
+		return 0;
+	}
+
+	m_mode = REPLAY_PLAY;
+	m_filename = filename;
+	m_seed = seed;
+	m_level = data.substr( pos, level_length );
+	m_data = data;
+	m_pos = pos + level_length;
+	m_frame_count = 0;
+	m_events.clear();
+
+	// events of the first frame
+	if( !Read_Frame() )
+	{
+		printf( "Error : Replay file %s has no frames\n", filename.c_str() );
+		Stop();
+		return 0;
+	}
+
+	srand( m_seed );
+
+	printf( "Replaying input from %s\n", m_filename.c_str() );
+
+	return 1;
+}
+
+void cReplay :: Stop( void )
+{
+	if( m_mode == REPLAY_RECORD )
+	{
+		// events polled after the last finished frame are not saved
+		ofstream file( m_filename.c_str(), ios::out | ios::trunc | ios::binary );
+
+		if( file )
+		{
+			file.write( m_data.c_str(), m_data.length() );
+			file.close();
+
+			printf( "Saved %u recorded frames to %s\n", m_frame_count, m_filename.c_str() );
+		}
+		else
+		{
+			printf( "Error : Couldn't open replay file for saving. Is the file read-only ? %s\n", m_filename.c_str() );
+		}
+	}
+	else if( m_mode == REPLAY_PLAY )
+	{
+		printf( "Replayed %u frames from %s\n", m_frame_count, m_filename.c_str() );
+	}
+
+	m_mode = REPLAY_NONE;
+	m_data.clear();
+	m_pos = 0;
+	m_frame_events.clear();
+	m_frame_event_count = 0;
+	m_events.clear();
+}
+
+bool cReplay :: Is_Active( void ) const
+{
+	return m_mode != REPLAY_NONE;
+}
+
+bool cReplay :: Poll_Event( SDL_Event *ev )
+{
+	if( m_mode == REPLAY_PLAY )
+	{
+		// only allow to quit
+		SDL_Event sdl_event;
+
+		while( SDL_PollEvent( &sdl_event ) )
+		{
+			if( sdl_event.type == SDL_QUIT )
+			{
+				*ev = sdl_event;
+				return 1;
+			}
+		}
+
+		if( m_events.empty() )
+		{
+			return 0;
+		}
+
+		*ev = m_events.front();
+		m_events.pop_front();
+
+		return 1;
+	}
+
+	if( !SDL_PollEvent( ev ) )
+	{
+		return 0;
+	}
+
+	if( m_mode == REPLAY_RECORD )
+	{
+		Record_Event( *ev );
+	}
+
+	return 1;
+}
+
+void cReplay :: Update_Frame( float &speed_factor, Uint32 &elapsed_ticks )
+{
+	if( m_mode == REPLAY_RECORD )
+	{
+		// frame : event count, events, speed factor and elapsed ticks
+		Write_Uint( m_data, m_frame_event_count, 2 );
+		m_data += m_frame_events;
+
+		unsigned int speed_factor_bits;
+		memcpy( &speed_factor_bits, &speed_factor, sizeof(speed_factor_bits) );
+		Write_Uint( m_data, speed_factor_bits );
+		Write_Uint( m_data, elapsed_ticks, 2 );
+
+		m_frame_events.clear();
+		m_frame_event_count = 0;
+		m_frame_count++;
+	}
+	else if( m_mode == REPLAY_PLAY )
+	{
+		speed_factor = m_frame_speed_factor;
+		elapsed_ticks = m_frame_elapsed_ticks;
+		m_frame_count++;
+
+		// events not polled in the frame are dropped
+		m_events.clear();
+
+		if( !Read_Frame() )
+		{
+			Stop();
+			game_exit = 1;
+		}
+	}
+}
+
+void cReplay :: Record_Event( const SDL_Event &ev )
+{
+	std::string data;
+	Write_Uint( data, ev.type, 1 );
+
+	switch( ev.type )
+	{
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+		{
+			Write_Uint( data, ev.key.keysym.sym, 2 );
+			Write_Uint( data, ev.key.keysym.mod, 2 );
+			Write_Uint( data, ev.key.keysym.unicode, 2 );
+			break;
+		}
+		case SDL_MOUSEMOTION:
+		{
+			Write_Uint( data, ev.motion.state, 1 );
+			Write_Uint( data, ev.motion.x, 2 );
+			Write_Uint( data, ev.motion.y, 2 );
+			Write_Uint( data, static_cast<Uint16>(ev.motion.xrel), 2 );
+			Write_Uint( data, static_cast<Uint16>(ev.motion.yrel), 2 );
+			break;
+		}
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+		{
+			Write_Uint( data, ev.button.button, 1 );
+			Write_Uint( data, ev.button.x, 2 );
+			Write_Uint( data, ev.button.y, 2 );
+			break;
+		}
+		case SDL_JOYAXISMOTION:
+		{
+			Write_Uint( data, ev.jaxis.which, 1 );
+			Write_Uint( data, ev.jaxis.axis, 1 );
+			Write_Uint( data, static_cast<Uint16>(ev.jaxis.value), 2 );
+			break;
+		}
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+		{
+			Write_Uint( data, ev.jbutton.which, 1 );
+			Write_Uint( data, ev.jbutton.button, 1 );
+			break;
+		}
+		case SDL_JOYHATMOTION:
+		{
+			Write_Uint( data, ev.jhat.which, 1 );
+			Write_Uint( data, ev.jhat.hat, 1 );
+			Write_Uint( data, ev.jhat.value, 1 );
+			break;
+		}
+		case SDL_QUIT:
+		{
+			break;
+		}
+		// not game input
+		default:
+		{
+			return;
+		}
+	}
+
+	m_frame_events += data;
+	m_frame_event_count++;
+}
+
+bool cReplay :: Read_Frame( void )
+{
+	unsigned int event_count;
+
+	if( !Read_Uint( m_data, m_pos, event_count, 2 ) )
+	{
+		return 0;
+	}
+
+	for( unsigned int i = 0; i < event_count; i++ )
+	{
+		SDL_Event ev;
+		memset( &ev, 0, sizeof(ev) );
+
+		unsigned int type, a, b, c, d, e;
+
+		if( !Read_Uint( m_data, m_pos, type, 1 ) )
+		{
+			return 0;
+		}
+
+		ev.type = static_cast<Uint8>(type);
+
+		switch( ev.type )
+		{
+			case SDL_KEYDOWN:
+			case SDL_KEYUP:
+			{
+				if( !Read_Uint( m_data, m_pos, a, 2 ) || !Read_Uint( m_data, m_pos, b, 2 ) || !Read_Uint( m_data, m_pos, c, 2 ) )
+				{
+					return 0;
+				}
+
+				ev.key.state = ( ev.type == SDL_KEYDOWN ) ? SDL_PRESSED : SDL_RELEASED;
+				ev.key.keysym.sym = static_cast<SDLKey>(a);
+				ev.key.keysym.mod = static_cast<SDLMod>(b);
+				ev.key.keysym.unicode = static_cast<Uint16>(c);
+				break;
+			}
+			case SDL_MOUSEMOTION:
+			{
+				if( !Read_Uint( m_data, m_pos, a, 1 ) || !Read_Uint( m_data, m_pos, b, 2 ) || !Read_Uint( m_data, m_pos, c, 2 ) || !Read_Uint( m_data, m_pos, d, 2 ) || !Read_Uint( m_data, m_pos, e, 2 ) )
+				{
+					return 0;
+				}
+
+				ev.motion.state = static_cast<Uint8>(a);
+				ev.motion.x = static_cast<Uint16>(b);
+				ev.motion.y = static_cast<Uint16>(c);
+				ev.motion.xrel = static_cast<Sint16>(d);
+				ev.motion.yrel = static_cast<Sint16>(e);
+				break;
+			}
+			case SDL_MOUSEBUTTONDOWN:
+			case SDL_MOUSEBUTTONUP:
+			{
+				if( !Read_Uint( m_data, m_pos, a, 1 ) || !Read_Uint( m_data, m_pos, b, 2 ) || !Read_Uint( m_data, m_pos, c, 2 ) )
+				{
+					return 0;
+				}
+
+				ev.button.state = ( ev.type == SDL_MOUSEBUTTONDOWN ) ? SDL_PRESSED : SDL_RELEASED;
+				ev.button.button = static_cast<Uint8>(a);
+				ev.button.x = static_cast<Uint16>(b);
+				ev.button.y = static_cast<Uint16>(c);
+				break;
+			}
+			case SDL_JOYAXISMOTION:
+			{
+				if( !Read_Uint( m_data, m_pos, a, 1 ) || !Read_Uint( m_data, m_pos, b, 1 ) || !Read_Uint( m_data, m_pos, c, 2 ) )
+				{
+					return 0;
+				}
+
+				ev.jaxis.which = static_cast<Uint8>(a);
+				ev.jaxis.axis = static_cast<Uint8>(b);
+				ev.jaxis.value = static_cast<Sint16>(c);
+				break;
+			}
+			case SDL_JOYBUTTONDOWN:
+			case SDL_JOYBUTTONUP:
+			{
+				if( !Read_Uint( m_data, m_pos, a, 1 ) || !Read_Uint( m_data, m_pos, b, 1 ) )
+				{
+					return 0;
+				}
+
+				ev.jbutton.state = ( ev.type == SDL_JOYBUTTONDOWN ) ? SDL_PRESSED : SDL_RELEASED;
+				ev.jbutton.which = static_cast<Uint8>(a);
+				ev.jbutton.button = static_cast<Uint8>(b);
+				break;
+			}
+			case SDL_JOYHATMOTION:
+			{
+				if( !Read_Uint( m_data, m_pos, a, 1 ) || !Read_Uint( m_data, m_pos, b, 1 ) || !Read_Uint( m_data, m_pos, c, 1 ) )
+				{
+					return 0;
+				}
+
+				ev.jhat.which = static_cast<Uint8>(a);
+				ev.jhat.hat = static_cast<Uint8>(b);
+				ev.jhat.value = static_cast<Uint8>(c);
+				break;
+			}
+			case SDL_QUIT:
+			{
+				break;
+			}
+			default:
+			{
+				printf( "Warning : Unknown event type %d in replay file %s\n", ev.type, m_filename.c_str() );
+				return 0;
+			}
+		}
+
+		m_events.push_back( ev );
+	}
+
+	unsigned int speed_factor_bits, elapsed_ticks;
+
+	if( !Read_Uint( m_data, m_pos, speed_factor_bits ) || !Read_Uint( m_data, m_pos, elapsed_ticks, 2 ) )
+	{
+		return 0;
+	}
+
+	memcpy( &m_frame_speed_factor, &speed_factor_bits, sizeof(m_frame_speed_factor) );
+	m_frame_elapsed_ticks = elapsed_ticks;
+
+	return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cReplay *pReplay = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,122 @@
+/***************************************************************************
+ * replay.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_REPLAY_H
+#define SMC_REPLAY_H
+
+#include "../core/globals.h"
+#include <deque>
+// SDL
+#include "SDL.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** *** cReplay *** *** *** *** *** *** *** *** *** *** *** */
+
+// replay file version
+static const unsigned int replay_version = 1;
+
+enum Replay_Mode
+{
+	REPLAY_NONE,
+	REPLAY_RECORD,
+	REPLAY_PLAY
+};
+
+/* Input recording and replay
+ * Records the random number seed and for each frame the speed factor
+ * and the input events polled in it.
+ * Replaying the file with the same game data and preferences reproduces the session.
+ * Recorded are keyboard, mouse button and motion, joystick and quit events.
+*/
+class cReplay
+{
+public:
+	cReplay( void );
+	~cReplay( void );
+
+	/* Start recording and seed the random number generator
+	 * level : level the session starts with or empty for the menu
+	*/
+	void Start_Recording( const std::string &filename, const std::string &level = "" );
+	/* Load the replay file and seed the random number generator with the recorded seed
+	 * the game exits after the last recorded frame
+	 * returns false if the file is not valid
+	*/
+	bool Start_Replay( const std::string &filename );
+	// Stop and save the recording or stop replaying
+	void Stop( void );
+
+	// Return true if recording or replaying
+	bool Is_Active( void ) const;
+
+	/* Get the next input event like SDL_PollEvent
+	 * while replaying the recorded events of the frame and only quit events from SDL are returned
+	 * returns false if no event is left
+	*/
+	bool Poll_Event( SDL_Event *ev );
+	/* Finish the frame with its speed factor and elapsed ticks
+	 * while replaying they are set to the recorded values
+	*/
+	void Update_Frame( float &speed_factor, Uint32 &elapsed_ticks );
+
+	// level the session started with
+	std::string m_level;
+
+private:
+	// Add the event to the recorded frame
+	void Record_Event( const SDL_Event &ev );
+	/* Read the events of the next recorded frame
+	 * returns false if the replay ended
+	*/
+	bool Read_Frame( void );
+
+	// current mode
+	Replay_Mode m_mode;
+	// replay filename
+	std::string m_filename;
+	// random number seed
+	unsigned int m_seed;
+	// number of finished frames
+	unsigned int m_frame_count;
+
+	// recorded or loaded file data
+	std::string m_data;
+	// read position in the loaded data
+	size_t m_pos;
+
+	// recorded events of the current frame
+	std::string m_frame_events;
+	// number of recorded events of the current frame
+	unsigned int m_frame_event_count;
+
+	// replayed events of the current frame
+	std::deque<SDL_Event> m_events;
+	// replayed speed factor and elapsed ticks of the current frame
+	float m_frame_speed_factor;
+	Uint32 m_frame_elapsed_ticks;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Input recording and replay
+extern cReplay *pReplay;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
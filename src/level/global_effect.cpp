@@ -224,17 +224,19 @@ void cGlobal_effect :: Update( void )
 
 void cGlobal_effect :: Update_Particles( void )
 {
+	if( !m_image )
+	{
+		return;
+	}
+
 	GL_rect camera_rect = GL_rect( pActive_Camera->x, pActive_Camera->y, static_cast<float>(game_res_w), static_cast<float>(game_res_h) );
 	// temporary animation rect
 	GL_rect anim_rect;
 
-	for( ParticleList::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	for( unsigned int i = 0; i < m_particles.m_count; i++ )
 	{
-		// get animation particle pointer
-		cParticle *obj = static_cast<cParticle *>(*itr);
-		
 		// set rectangle
-		anim_rect = GL_rect( obj->m_pos_x, obj->m_pos_y, obj->m_rect.m_w, obj->m_rect.m_h );
+		anim_rect = GL_rect( m_particles.m_pos_x[i], m_particles.m_pos_y[i], m_image->m_w, m_image->m_h );
 		
 		// if on screen
 		if( camera_rect.Intersects( anim_rect ) )
@@ -246,25 +248,25 @@ void cGlobal_effect :: Update_Particles( void )
 		if( anim_rect.m_x + anim_rect.m_w < camera_rect.m_x )
 		{
 			// move to right
-			obj->Set_Pos_X( camera_rect.m_x + camera_rect.m_w - 1 );
+			m_particles.m_pos_x[i] = camera_rect.m_x + camera_rect.m_w - 1;
 		}
 		// out in right
 		else if( anim_rect.m_x > camera_rect.m_x + camera_rect.m_w )
 		{
 			// move to left
-			obj->Set_Pos_X( camera_rect.m_x + 1 );
+			m_particles.m_pos_x[i] = camera_rect.m_x + 1;
 		}
 		// out on top
 		else if( anim_rect.m_y + anim_rect.m_h < camera_rect.m_y )
 		{
 			// move to bottom
-			obj->Set_Pos_Y( camera_rect.m_y + camera_rect.m_h - 1 );
+			m_particles.m_pos_y[i] = camera_rect.m_y + camera_rect.m_h - 1;
 		}
 		// out on bottom
 		else if( anim_rect.m_y > camera_rect.m_y + camera_rect.m_h )
 		{
 			// move to top
-			obj->Set_Pos_Y( camera_rect.m_y + 1 );
+			m_particles.m_pos_y[i] = camera_rect.m_y + 1;
 		}
 	}
 }
@@ -54,6 +54,10 @@
 #include "../objects/path.h"
 #include "../core/filesystem/filesystem.h"
 #include "../core/filesystem/resource_manager.h"
+#include "../level/level_binary.h"
+#include "../level/level_preloader.h"
+#include "../level/level_snapshot.h"
+#include "../core/profiler.h"
 // CEGUI
 #include "CEGUIXMLParser.h"
 
@@ -73,6 +77,7 @@ cLevel :: cLevel( void )
 	m_background_manager = new cBackground_Manager();
 	m_global_effect = new cGlobal_effect();
 	m_sprite_manager = new cSprite_Manager();
+	m_snapshot = new cLevel_Snapshot();
 
 	// add default gradient layer
 	cBackground *gradient_background = new cBackground();
@@ -89,6 +94,7 @@ cLevel :: ~cLevel( void )
 	delete m_background_manager;
 	delete m_global_effect;
 	delete m_sprite_manager;
+	delete m_snapshot;
 }
 
 bool cLevel :: New( std::string filename )
@@ -178,6 +184,8 @@ bool cLevel :: Load( std::string filename, bool delayed /* = 0 */ )
 		return 1;
 	}
 
+	cProfiler_Zone zone( PERF_LEVEL_LOAD );
+
 	Unload();
 
 	m_level_filename = filename;
@@ -185,16 +193,64 @@ bool cLevel :: Load( std::string filename, bool delayed /* = 0 */ )
 	// new level format
 	if( filename.rfind( ".smclvl" ) != std::string::npos )
 	{
-		try
+		// create from the snapshot if loaded before
+		if( m_snapshot->Is_Valid( filename ) )
 		{
-			CEGUI::System::getSingleton().getXMLParser()->parseXMLFile( *this, filename.c_str(), DATA_DIR "/" GAME_SCHEMA_DIR "/Level.xsd", "" );
+			Restore_Snapshot();
 		}
-		// catch CEGUI Exceptions
-		catch( CEGUI::Exception &ex )
+		else
 		{
-			printf( "Loading Level %s CEGUI Exception %s\n", filename.c_str(), ex.getMessage().c_str() );
-			pHud_Debug->Set_Text( _("Loading Level failed : ") + (const std::string)ex.getMessage().c_str() );
-			return 0;
+			// record the level settings
+			m_snapshot->Begin( filename );
+
+			// use the preloaded compiled level
+			cLevel_Binary *binary = NULL;
+
+			if( pLevel_Preloader )
+			{
+				binary = pLevel_Preloader->Get_Level_Binary( filename );
+			}
+
+			// use the compiled level if up to date
+			if( !binary )
+			{
+				binary = new cLevel_Binary();
+
+				if( !binary->Load( filename ) )
+				{
+					delete binary;
+					binary = NULL;
+				}
+			}
+
+			if( binary )
+			{
+				for( unsigned int i = 0; i < binary->Get_Element_Count(); i++ )
+				{
+					binary->Get_Element_Attributes( i, m_xml_attributes );
+					elementEnd( binary->Get_Element_Name( i ) );
+				}
+
+				delete binary;
+			}
+			else
+			{
+				try
+				{
+					CEGUI::System::getSingleton().getXMLParser()->parseXMLFile( *this, filename.c_str(), DATA_DIR "/" GAME_SCHEMA_DIR "/Level.xsd", "" );
+				}
+				// catch CEGUI Exceptions
+				catch( CEGUI::Exception &ex )
+				{
+					printf( "Loading Level %s CEGUI Exception %s\n", filename.c_str(), ex.getMessage().c_str() );
+					pHud_Debug->Set_Text( _("Loading Level failed : ") + (const std::string)ex.getMessage().c_str() );
+					m_snapshot->Clear();
+					return 0;
+				}
+			}
+
+			// copy the sprite start state
+			m_snapshot->Finish( m_sprite_manager->objects );
 		}
 
 		// set parser filename for compatibility
@@ -213,9 +269,16 @@ bool cLevel :: Load( std::string filename, bool delayed /* = 0 */ )
 	// parse old level format
 	else
 	{
+		m_snapshot->Clear();
 		Parse( filename );
 	}
 
+	// delete the unused preloaded data
+	if( pLevel_Preloader )
+	{
+		pLevel_Preloader->Clear();
+	}
+
 	// engine version entry not set
 	if( m_engine_version < 0 )
 	{
@@ -294,6 +357,9 @@ void cLevel :: Save( void )
 {
 	pAudio->Play_Sound( "editor/save.ogg" );
 
+	// the start state changes
+	m_snapshot->Clear();
+
 	// check if old filename ending
 	if( m_level_filename.rfind( ".txt" ) != std::string::npos )
 	{
@@ -318,6 +384,9 @@ void cLevel :: Save( void )
 		return;
 	}
 
+	// the compiled level is outdated
+	Delete_File( Get_Level_Binary_Filename( m_level_filename ) );
+
 	// xml info
 	file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
 	// begin level
@@ -397,6 +466,7 @@ void cLevel :: Save( void )
 void cLevel :: Delete( void )
 {
 	Delete_File( m_level_filename );
+	Delete_File( Get_Level_Binary_Filename( m_level_filename ) );
 
 	Unload();
 }
@@ -968,6 +1038,7 @@ void cLevel :: Set_Levelfile( std::string filename, bool delete_old /* = 1 */ )
 	if( delete_old )
 	{
 		Delete_File( m_level_filename );
+		Delete_File( Get_Level_Binary_Filename( m_level_filename ) );
 	}
 
 	Convert_Path_Separators( filename );
@@ -2350,6 +2421,12 @@ void cLevel :: elementEnd( const CEGUI::String &element )
 {
 	if( element != "Property" )
 	{
+		// keep the level settings for the snapshot
+		if( element == "information" || element == "settings" || element == "background" || element == "global_effect" || element == "player" )
+		{
+			m_snapshot->Add_Element( element, m_xml_attributes );
+		}
+
 		if( element == "information" )
 		{
 			// support 1.7 and lower which used float
@@ -2449,6 +2526,27 @@ void cLevel :: elementEnd( const CEGUI::String &element )
 	}
 }
 
+void cLevel :: Restore_Snapshot( void )
+{
+	// level settings
+	for( cLevel_Snapshot::ElementList::iterator itr = m_snapshot->m_elements.begin(), itr_end = m_snapshot->m_elements.end(); itr != itr_end; ++itr )
+	{
+		m_xml_attributes = (*itr).m_attributes;
+		elementEnd( (*itr).m_name );
+	}
+
+	// sprites
+	for( cSprite_List::iterator itr = m_snapshot->m_sprites.begin(), itr_end = m_snapshot->m_sprites.end(); itr != itr_end; ++itr )
+	{
+		cSprite *obj = (*itr)->Copy();
+
+		if( obj )
+		{
+			m_sprite_manager->Add( obj );
+		}
+	}
+}
+
 cSprite *Get_Level_Object( const CEGUI::String &xml_element, CEGUI::XMLAttributes &attributes, int engine_version /* = level_engine_version */, cSprite_Manager *sprite_manager /* = NULL */ )
 {
 	// element could change
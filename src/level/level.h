@@ -143,6 +143,8 @@ public:
 	cGlobal_effect *m_global_effect;
 	// sprite manager
 	cSprite_Manager *m_sprite_manager;
+	// start state of the loaded level
+	cLevel_Snapshot *m_snapshot;
 
 	/* *** *** *** Settings *** *** *** *** */
 
@@ -176,6 +178,8 @@ private:
 	virtual void elementStart( const CEGUI::String &element, const CEGUI::XMLAttributes &attributes );
 	// XML element end
 	virtual void elementEnd( const CEGUI::String &element );
+	// Create the level settings and sprites from the snapshot
+	void Restore_Snapshot( void );
 
 	// XML element Item Tag list
 	CEGUI::XMLAttributes m_xml_attributes;
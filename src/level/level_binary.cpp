@@ -0,0 +1,591 @@
+/***************************************************************************
+ * level_binary.cpp  -  compiled level file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../level/level_binary.h"
+#include "../core/global_game.h"
+#include "../core/filesystem/filesystem.h"
+#include "../core/sprite_manager.h"
+#include "../level/level.h"
+#include <cstring>
+// CEGUI
+#include "CEGUISystem.h"
+#include "CEGUIExceptions.h"
+#include "CEGUIXMLParser.h"
+
+namespace SMC
+{
+
+// file identifier
+static const char level_binary_magic[4] = { 'S', 'M', 'C', 'B' };
+
+/* *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** *** */
+
+// Add the value in little endian byte order
+static void Write_Uint( std::string &data, unsigned int value )
+{
+	data += static_cast<char>(value & 0xFF);
+	data += static_cast<char>(( value >> 8 ) & 0xFF);
+	data += static_cast<char>(( value >> 16 ) & 0xFF);
+	data += static_cast<char>(( value >> 24 ) & 0xFF);
+}
+
+/* Read a little endian value and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Uint( const vector<char> &data, size_t &pos, unsigned int &value )
+{
+	if( pos + 4 > data.size() )
+	{
+		return 0;
+	}
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&data[pos]);
+	value = bytes[0] | ( bytes[1] << 8 ) | ( bytes[2] << 16 ) | ( static_cast<unsigned int>(bytes[3]) << 24 );
+	pos += 4;
+
+	return 1;
+}
+
+/* *** *** *** *** *** *** cLevel_Verify_Loader *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Keeps the elements and creates the sprites like the level does
+ * Used to compare the level file with its compiled level file.
+*/
+class cLevel_Verify_Loader : public CEGUI::XMLHandler
+{
+public:
+	cLevel_Verify_Loader( void )
+	{
+		m_engine_version = level_engine_version;
+	}
+
+	// XML element start
+	virtual void elementStart( const CEGUI::String &element, const CEGUI::XMLAttributes &attributes )
+	{
+		if( element == "Property" )
+		{
+			m_attributes.add( attributes.getValueAsString( "name" ), attributes.getValueAsString( "value" ) );
+		}
+	}
+
+	// XML element end
+	virtual void elementEnd( const CEGUI::String &element )
+	{
+		if( element == "Property" )
+		{
+			return;
+		}
+
+		// element name with all attributes
+		std::string data = element.c_str();
+
+		for( size_t i = 0; i < m_attributes.getCount(); i++ )
+		{
+			data += "\n";
+			data += m_attributes.getName( i ).c_str();
+			data += "=";
+			data += m_attributes.getValueAt( i ).c_str();
+		}
+
+		m_elements.push_back( data );
+
+		if( element == "information" )
+		{
+			// support 1.7 and lower which used float
+			float engine_version_float = m_attributes.getValueAsFloat( "engine_version" );
+
+			if( engine_version_float < 3 )
+			{
+				engine_version_float *= 10;
+			}
+
+			m_engine_version = static_cast<int>(engine_version_float);
+		}
+		else if( element != "settings" && element != "background" && element != "global_effect" && element != "player" )
+		{
+			cSprite *object = Get_Level_Object( element, m_attributes, m_engine_version, &m_sprite_manager );
+
+			if( object )
+			{
+				m_sprite_manager.Add( object );
+			}
+		}
+
+		m_attributes = CEGUI::XMLAttributes();
+	}
+
+	// attributes of the current element
+	CEGUI::XMLAttributes m_attributes;
+	// name and attributes of all elements
+	vector<std::string> m_elements;
+	// created sprites
+	cSprite_Manager m_sprite_manager;
+private:
+	int m_engine_version;
+};
+
+/* *** *** *** *** *** *** cLevel_Binary *** *** *** *** *** *** *** *** *** *** *** */
+
+cLevel_Binary :: cLevel_Binary( void )
+{
+	m_level_size = 0;
+	m_level_time = 0;
+	m_element_attributes = 0;
+}
+
+cLevel_Binary :: ~cLevel_Binary( void )
+{
+	//
+}
+
+void cLevel_Binary :: Clear( void )
+{
+	m_level_filename.clear();
+	m_level_size = 0;
+	m_level_time = 0;
+
+	m_strings.clear();
+	m_string_index.Clear();
+	m_string_numbers.clear();
+	m_elements.clear();
+	m_attributes.clear();
+	m_element_attributes = 0;
+}
+
+bool cLevel_Binary :: Parse_XML( const std::string &filename )
+{
+	Clear();
+
+	m_level_filename = filename;
+	m_level_size = static_cast<unsigned int>(Get_File_Size( filename ));
+	m_level_time = static_cast<unsigned int>(Get_File_Modification_Time( filename ));
+
+	try
+	{
+		CEGUI::System::getSingleton().getXMLParser()->parseXMLFile( *this, filename.c_str(), DATA_DIR "/" GAME_SCHEMA_DIR "/Level.xsd", "" );
+	}
+	// catch CEGUI Exceptions
+	catch( CEGUI::Exception &ex )
+	{
+		printf( "Parsing Level %s CEGUI Exception %s\n", filename.c_str(), ex.getMessage().c_str() );
+		Clear();
+		return 0;
+	}
+
+	return 1;
+}
+
+bool cLevel_Binary :: Load( const std::string &level_filename )
+{
+	Clear();
+
+	ifstream ifs( Get_Level_Binary_Filename( level_filename ).c_str(), ios::in | ios::binary );
+
+	if( !ifs )
+	{
+		return 0;
+	}
+
+	// read the whole file
+	vector<char> data;
+	ifs.seekg( 0, ios::end );
+	data.resize( static_cast<size_t>(ifs.tellg()) );
+	ifs.seekg( 0, ios::beg );
+
+	if( data.size() < sizeof(level_binary_magic) || !ifs.read( &data[0], data.size() ) )
+	{
+		return 0;
+	}
+
+	ifs.close();
+
+	// check identifier
+	if( memcmp( &data[0], level_binary_magic, sizeof(level_binary_magic) ) != 0 )
+	{
+		printf( "Warning : Compiled level %s is not valid\n", Get_Level_Binary_Filename( level_filename ).c_str() );
+		return 0;
+	}
+
+	size_t pos = sizeof(level_binary_magic);
+	unsigned int version, level_size, level_time;
+
+	if( !Read_Uint( data, pos, version ) || !Read_Uint( data, pos, level_size ) || !Read_Uint( data, pos, level_time ) )
+	{
+		return 0;
+	}
+
+	// outdated
+	if( version != level_binary_version || level_size != static_cast<unsigned int>(Get_File_Size( level_filename )) || level_time != static_cast<unsigned int>(Get_File_Modification_Time( level_filename )) )
+	{
+		return 0;
+	}
+
+	// string table
+	unsigned int string_count;
+
+	if( !Read_Uint( data, pos, string_count ) )
+	{
+		return 0;
+	}
+
+	m_strings.reserve( string_count );
+
+	for( unsigned int i = 0; i < string_count; i++ )
+	{
+		unsigned int length;
+
+		if( !Read_Uint( data, pos, length ) || pos + length > data.size() )
+		{
+			Clear();
+			return 0;
+		}
+
+		m_strings.push_back( std::string( data.begin() + pos, data.begin() + pos + length ) );
+		pos += length;
+	}
+
+	// elements
+	unsigned int element_count;
+
+	if( !Read_Uint( data, pos, element_count ) )
+	{
+		Clear();
+		return 0;
+	}
+
+	m_elements.reserve( element_count );
+
+	for( unsigned int i = 0; i < element_count; i++ )
+	{
+		cElement element;
+		element.first_attribute = m_attributes.size();
+
+		if( !Read_Uint( data, pos, element.name ) || !Read_Uint( data, pos, element.attribute_count ) || element.name >= string_count )
+		{
+			Clear();
+			return 0;
+		}
+
+		for( unsigned int j = 0; j < element.attribute_count * 2; j++ )
+		{
+			unsigned int str;
+
+			if( !Read_Uint( data, pos, str ) || str >= string_count )
+			{
+				Clear();
+				return 0;
+			}
+
+			m_attributes.push_back( str );
+		}
+
+		m_elements.push_back( element );
+	}
+
+	m_level_filename = level_filename;
+	m_level_size = level_size;
+	m_level_time = level_time;
+
+	return 1;
+}
+
+bool cLevel_Binary :: Save( void ) const
+{
+	if( m_level_filename.empty() )
+	{
+		return 0;
+	}
+
+	std::string data( level_binary_magic, sizeof(level_binary_magic) );
+
+	Write_Uint( data, level_binary_version );
+	Write_Uint( data, m_level_size );
+	Write_Uint( data, m_level_time );
+
+	// string table
+	Write_Uint( data, m_strings.size() );
+
+	for( vector<std::string>::const_iterator itr = m_strings.begin(), itr_end = m_strings.end(); itr != itr_end; ++itr )
+	{
+		Write_Uint( data, (*itr).length() );
+		data += (*itr);
+	}
+
+	// elements
+	Write_Uint( data, m_elements.size() );
+
+	for( ElementList::const_iterator itr = m_elements.begin(), itr_end = m_elements.end(); itr != itr_end; ++itr )
+	{
+		const cElement &element = (*itr);
+
+		Write_Uint( data, element.name );
+		Write_Uint( data, element.attribute_count );
+
+		for( unsigned int i = 0; i < element.attribute_count * 2; i++ )
+		{
+			Write_Uint( data, m_attributes[element.first_attribute + i] );
+		}
+	}
+
+	std::string filename = Get_Level_Binary_Filename( m_level_filename );
+	ofstream file( filename.c_str(), ios::out | ios::trunc | ios::binary );
+
+	if( !file )
+	{
+		printf( "Error : Couldn't open compiled level file for saving. Is the file read-only ? %s\n", filename.c_str() );
+		return 0;
+	}
+
+	file.write( data.c_str(), data.length() );
+	file.close();
+
+	return 1;
+}
+
+unsigned int cLevel_Binary :: Get_Element_Count( void ) const
+{
+	return m_elements.size();
+}
+
+const std::string &cLevel_Binary :: Get_Element_Name( unsigned int element ) const
+{
+	return m_strings[m_elements[element].name];
+}
+
+void cLevel_Binary :: Get_Element_Attributes( unsigned int element, CEGUI::XMLAttributes &attributes ) const
+{
+	const cElement &obj = m_elements[element];
+
+	for( unsigned int i = obj.first_attribute, i_end = obj.first_attribute + ( obj.attribute_count * 2 ); i < i_end; i += 2 )
+	{
+		attributes.add( reinterpret_cast<const CEGUI::utf8*>(m_strings[m_attributes[i]].c_str()), reinterpret_cast<const CEGUI::utf8*>(m_strings[m_attributes[i + 1]].c_str()) );
+	}
+}
+
+const vector<std::string> &cLevel_Binary :: Get_Strings( void ) const
+{
+	return m_strings;
+}
+
+void cLevel_Binary :: elementStart( const CEGUI::String &element, const CEGUI::XMLAttributes &attributes )
+{
+	// Property/Item/Tag of an Element
+	if( element == "Property" )
+	{
+		m_attributes.push_back( Get_String_Index( attributes.getValueAsString( "name" ).c_str() ) );
+		m_attributes.push_back( Get_String_Index( attributes.getValueAsString( "value" ).c_str() ) );
+		m_element_attributes++;
+	}
+}
+
+void cLevel_Binary :: elementEnd( const CEGUI::String &element )
+{
+	if( element == "Property" )
+	{
+		return;
+	}
+
+	// same elements as handled by the level
+	cElement obj;
+	obj.name = Get_String_Index( element.c_str() );
+	obj.first_attribute = m_attributes.size() - ( m_element_attributes * 2 );
+	obj.attribute_count = m_element_attributes;
+	m_elements.push_back( obj );
+
+	m_element_attributes = 0;
+}
+
+unsigned int cLevel_Binary :: Get_String_Index( const std::string &str )
+{
+	unsigned int *index = m_string_index.Get( str );
+
+	if( index )
+	{
+		return *index;
+	}
+
+	m_string_numbers.push_back( m_strings.size() );
+	m_string_index.Add( str, &m_string_numbers.back() );
+	m_strings.push_back( str );
+
+	return m_strings.size() - 1;
+}
+
+/* *** *** *** *** *** *** *** Functions *** *** *** *** *** *** *** *** *** *** */
+
+std::string Get_Level_Binary_Filename( const std::string &level_filename )
+{
+	return level_filename + "b";
+}
+
+bool Convert_Level_To_Binary( const std::string &level_filename )
+{
+	cLevel_Binary binary;
+
+	if( !binary.Parse_XML( level_filename ) )
+	{
+		return 0;
+	}
+
+	return binary.Save();
+}
+
+unsigned int Convert_Level_Directory( const std::string &dir )
+{
+	if( !Dir_Exists( dir ) )
+	{
+		return 0;
+	}
+
+	vector<std::string> level_files = Get_Directory_Files( dir, ".smclvl" );
+	unsigned int count = 0;
+
+	for( vector<std::string>::iterator itr = level_files.begin(), itr_end = level_files.end(); itr != itr_end; ++itr )
+	{
+		const std::string &filename = (*itr);
+
+		// only level files
+		if( filename.length() < 7 || filename.compare( filename.length() - 7, 7, ".smclvl" ) != 0 )
+		{
+			continue;
+		}
+
+		if( Convert_Level_To_Binary( filename ) )
+		{
+			printf( "Compiled level %s\n", filename.c_str() );
+			count++;
+		}
+		else
+		{
+			printf( "Warning : Could not compile level %s\n", filename.c_str() );
+		}
+	}
+
+	return count;
+}
+
+bool Verify_Level_Binary( const std::string &level_filename )
+{
+	cLevel_Binary binary;
+
+	if( !binary.Load( level_filename ) )
+	{
+		printf( "Error : Compiled level of %s is missing or outdated\n", level_filename.c_str() );
+		return 0;
+	}
+
+	// level file
+	cLevel_Verify_Loader xml_loader;
+
+	try
+	{
+		CEGUI::System::getSingleton().getXMLParser()->parseXMLFile( xml_loader, level_filename.c_str(), DATA_DIR "/" GAME_SCHEMA_DIR "/Level.xsd", "" );
+	}
+	// catch CEGUI Exceptions
+	catch( CEGUI::Exception &ex )
+	{
+		printf( "Parsing Level %s CEGUI Exception %s\n", level_filename.c_str(), ex.getMessage().c_str() );
+		return 0;
+	}
+
+	// compiled level file
+	cLevel_Verify_Loader binary_loader;
+
+	for( unsigned int i = 0; i < binary.Get_Element_Count(); i++ )
+	{
+		binary.Get_Element_Attributes( i, binary_loader.m_attributes );
+		binary_loader.elementEnd( binary.Get_Element_Name( i ) );
+	}
+
+	// elements
+	if( xml_loader.m_elements.size() != binary_loader.m_elements.size() )
+	{
+		printf( "Error : Level %s has %u elements but the compiled level %u\n", level_filename.c_str(), static_cast<unsigned int>(xml_loader.m_elements.size()), static_cast<unsigned int>(binary_loader.m_elements.size()) );
+		return 0;
+	}
+
+	bool valid = 1;
+
+	for( unsigned int i = 0; i < xml_loader.m_elements.size(); i++ )
+	{
+		if( xml_loader.m_elements[i] != binary_loader.m_elements[i] )
+		{
+			printf( "Error : Level %s element %u differs in the compiled level\n%s\n%s\n", level_filename.c_str(), i, xml_loader.m_elements[i].c_str(), binary_loader.m_elements[i].c_str() );
+			valid = 0;
+		}
+	}
+
+	// sprites
+	const cSprite_List &xml_sprites = xml_loader.m_sprite_manager.objects;
+	const cSprite_List &binary_sprites = binary_loader.m_sprite_manager.objects;
+
+	if( xml_sprites.size() != binary_sprites.size() )
+	{
+		printf( "Error : Level %s has %u sprites but the compiled level %u\n", level_filename.c_str(), static_cast<unsigned int>(xml_sprites.size()), static_cast<unsigned int>(binary_sprites.size()) );
+		return 0;
+	}
+
+	for( unsigned int i = 0; i < xml_sprites.size(); i++ )
+	{
+		const cSprite *xml_obj = xml_sprites[i];
+		const cSprite *binary_obj = binary_sprites[i];
+
+		if( xml_obj->m_type != binary_obj->m_type || xml_obj->m_start_pos_x != binary_obj->m_start_pos_x || xml_obj->m_start_pos_y != binary_obj->m_start_pos_y )
+		{
+			printf( "Error : Level %s sprite %u is type %d at %g,%g but in the compiled level type %d at %g,%g\n", level_filename.c_str(), i,
+				static_cast<int>(xml_obj->m_type), xml_obj->m_start_pos_x, xml_obj->m_start_pos_y, static_cast<int>(binary_obj->m_type), binary_obj->m_start_pos_x, binary_obj->m_start_pos_y );
+			valid = 0;
+		}
+	}
+
+	return valid;
+}
+
+unsigned int Verify_Level_Directory( const std::string &dir )
+{
+	if( !Dir_Exists( dir ) )
+	{
+		return 0;
+	}
+
+	vector<std::string> level_files = Get_Directory_Files( dir, ".smclvl" );
+	unsigned int failed = 0;
+
+	for( vector<std::string>::iterator itr = level_files.begin(), itr_end = level_files.end(); itr != itr_end; ++itr )
+	{
+		const std::string &filename = (*itr);
+
+		// only level files
+		if( filename.length() < 7 || filename.compare( filename.length() - 7, 7, ".smclvl" ) != 0 )
+		{
+			continue;
+		}
+
+		if( Verify_Level_Binary( filename ) )
+		{
+			printf( "Verified level %s\n", filename.c_str() );
+		}
+		else
+		{
+			failed++;
+		}
+	}
+
+	return failed;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,139 @@
+/***************************************************************************
+ * level_binary.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_LEVEL_BINARY_H
+#define SMC_LEVEL_BINARY_H
+
+#include "../core/global_basic.h"
+#include "../core/hash_index.h"
+#include <deque>
+// CEGUI
+#include "CEGUIXMLHandler.h"
+#include "CEGUIXMLAttributes.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cLevel_Binary *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// compiled level file version
+static const unsigned int level_binary_version = 3;
+
+/* Compiled level file
+ * Stores the elements of a parsed level file with all strings in a table.
+ * Loading it needs no XML parsing and schema validation.
+ * The size and modification time of the level file are stored and
+ * if they changed the compiled level file is not used.
+*/
+class cLevel_Binary : public CEGUI::XMLHandler
+{
+public:
+	cLevel_Binary( void );
+	virtual ~cLevel_Binary( void );
+
+	// Remove all elements and strings
+	void Clear( void );
+
+	/* Parse the given level file
+	 * returns true if successful
+	*/
+	bool Parse_XML( const std::string &filename );
+	/* Load the compiled level file of the given level file
+	 * returns false if not available or outdated
+	*/
+	bool Load( const std::string &level_filename );
+	/* Save as compiled level file of the parsed level file
+	 * returns true if successful
+	*/
+	bool Save( void ) const;
+
+	// Return the element count
+	unsigned int Get_Element_Count( void ) const;
+	// Return the element name
+	const std::string &Get_Element_Name( unsigned int element ) const;
+	// Add the element attributes
+	void Get_Element_Attributes( unsigned int element, CEGUI::XMLAttributes &attributes ) const;
+	// Return the string table with all element names and attribute names and values
+	const vector<std::string> &Get_Strings( void ) const;
+
+	// level filename
+	std::string m_level_filename;
+
+private:
+	// XML element start
+	virtual void elementStart( const CEGUI::String &element, const CEGUI::XMLAttributes &attributes );
+	// XML element end
+	virtual void elementEnd( const CEGUI::String &element );
+
+	// Return the string table index and add it if new
+	unsigned int Get_String_Index( const std::string &str );
+
+	// level file size and modification time
+	unsigned int m_level_size;
+	unsigned int m_level_time;
+
+	// string table
+	vector<std::string> m_strings;
+	// string table index by string
+	cHash_Index<unsigned int> m_string_index;
+	// string table indexes used by the hash index
+	std::deque<unsigned int> m_string_numbers;
+
+	// level element
+	struct cElement
+	{
+		// name string index
+		unsigned int name;
+		// first attribute in the attribute list
+		unsigned int first_attribute;
+		// attribute count
+		unsigned int attribute_count;
+	};
+
+	typedef vector<cElement> ElementList;
+	ElementList m_elements;
+	// attribute name and value string indexes of all elements
+	vector<unsigned int> m_attributes;
+	// attributes of the current XML element
+	unsigned int m_element_attributes;
+};
+
+// Return the compiled level filename of the given level file
+std::string Get_Level_Binary_Filename( const std::string &level_filename );
+
+/* Compile the given level file
+ * returns true if successful
+*/
+bool Convert_Level_To_Binary( const std::string &level_filename );
+/* Compile all level files in the directory and its sub-directories
+ * returns the number of compiled levels
+*/
+unsigned int Convert_Level_Directory( const std::string &dir );
+
+/* Compare the level file with its compiled level file
+ * compares the element names and attributes and the type and position of the created sprites
+ * returns true if the compiled level file is up to date and the same
+*/
+bool Verify_Level_Binary( const std::string &level_filename );
+/* Verify the compiled levels of all level files in the directory and its sub-directories
+ * returns the number of levels which failed
+*/
+unsigned int Verify_Level_Directory( const std::string &dir );
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
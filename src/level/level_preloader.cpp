@@ -0,0 +1,383 @@
+/***************************************************************************
+ * level_preloader.cpp  -  background level loading
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../level/level_preloader.h"
+#include "../level/level.h"
+#include "../core/game_core.h"
+#include "../core/filesystem/filesystem.h"
+#include "../video/video.h"
+#include "../video/img_manager.h"
+#include <algorithm>
+// SDL
+#include "SDL_image.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** *** cLevel_Preloader *** *** *** *** *** *** *** *** *** *** *** */
+
+cLevel_Preloader :: cLevel_Preloader( void )
+{
+	m_thread = NULL;
+	m_mutex = SDL_CreateMutex();
+	m_cancel = 0;
+	m_finished = 0;
+	m_binary = NULL;
+}
+
+cLevel_Preloader :: ~cLevel_Preloader( void )
+{
+	Clear();
+
+	SDL_DestroyMutex( m_mutex );
+}
+
+void cLevel_Preloader :: Preload( std::string level_name, bool cancel_running /* = 1 */ )
+{
+	// already preloading
+	if( !m_level_name.empty() && m_level_name.compare( level_name ) == 0 )
+	{
+		return;
+	}
+
+	if( !pActive_Level )
+	{
+		return;
+	}
+
+	// rejected before from the same level
+	if( m_rejected_active_level.compare( pActive_Level->m_level_filename ) != 0 )
+	{
+		m_rejected_levels.clear();
+		m_rejected_active_level = pActive_Level->m_level_filename;
+	}
+	else if( std::find( m_rejected_levels.begin(), m_rejected_levels.end(), level_name ) != m_rejected_levels.end() )
+	{
+		return;
+	}
+
+	// keep the running preloading
+	if( !cancel_running && Is_Running() )
+	{
+		return;
+	}
+
+	const std::string requested_name = level_name;
+
+	// not found or already loaded
+	if( !pActive_Level->Get_Path( level_name ) || pActive_Level->m_level_filename.compare( level_name ) == 0 )
+	{
+		m_rejected_levels.push_back( requested_name );
+		return;
+	}
+
+	Clear();
+
+	m_level_name = requested_name;
+	m_level_filename = level_name;
+	m_imgcache_dir = pVideo->m_imgcache_dir;
+
+	// images already available don't need to be preloaded
+	for( vector<cGL_Surface *>::iterator itr = pImage_Manager->objects.begin(), itr_end = pImage_Manager->objects.end(); itr != itr_end; ++itr )
+	{
+		m_loaded_images.push_back( (*itr)->m_filename );
+	}
+
+	std::sort( m_loaded_images.begin(), m_loaded_images.end() );
+
+	m_thread = SDL_CreateThread( &cLevel_Preloader::Thread_Function, this );
+
+	if( !m_thread )
+	{
+		printf( "Warning : Could not create level preloading thread : %s\n", SDL_GetError() );
+		m_level_name.clear();
+		m_level_filename.clear();
+		m_loaded_images.clear();
+	}
+}
+
+void cLevel_Preloader :: Wait( void )
+{
+	if( !m_thread )
+	{
+		return;
+	}
+
+	SDL_WaitThread( m_thread, NULL );
+	m_thread = NULL;
+}
+
+void cLevel_Preloader :: Clear( void )
+{
+	// stop thread
+	SDL_LockMutex( m_mutex );
+	m_cancel = 1;
+	SDL_UnlockMutex( m_mutex );
+
+	Wait();
+
+	m_cancel = 0;
+	m_finished = 0;
+	m_level_name.clear();
+	m_level_filename.clear();
+	m_loaded_images.clear();
+
+	if( m_binary )
+	{
+		delete m_binary;
+		m_binary = NULL;
+	}
+
+	for( SurfaceList::iterator itr = m_surface_list.begin(), itr_end = m_surface_list.end(); itr != itr_end; ++itr )
+	{
+		SDL_FreeSurface( *itr );
+	}
+
+	m_surface_list.clear();
+	m_surfaces.Clear();
+}
+
+cLevel_Binary *cLevel_Preloader :: Get_Level_Binary( const std::string &level_filename )
+{
+	// preloading a different level
+	if( m_level_filename.compare( level_filename ) != 0 )
+	{
+		Clear();
+		return NULL;
+	}
+
+	Wait();
+
+	cLevel_Binary *binary = m_binary;
+	m_binary = NULL;
+
+	return binary;
+}
+
+SDL_Surface *cLevel_Preloader :: Get_Surface( const std::string &filename )
+{
+	// only available if finished
+	if( m_thread || m_surface_list.empty() )
+	{
+		return NULL;
+	}
+
+	SDL_Surface *surface = m_surfaces.Get( filename );
+
+	if( !surface )
+	{
+		return NULL;
+	}
+
+	m_surfaces.Remove( filename, surface );
+	m_surface_list.erase( std::find( m_surface_list.begin(), m_surface_list.end(), surface ) );
+
+	return surface;
+}
+
+int cLevel_Preloader :: Thread_Function( void *data )
+{
+	cLevel_Preloader *preloader = static_cast<cLevel_Preloader *>(data);
+	preloader->Run();
+
+	SDL_LockMutex( preloader->m_mutex );
+	preloader->m_finished = 1;
+	SDL_UnlockMutex( preloader->m_mutex );
+
+	return 0;
+}
+
+void cLevel_Preloader :: Run( void )
+{
+	// compiled level
+	if( m_level_filename.rfind( ".smclvl" ) != std::string::npos )
+	{
+		cLevel_Binary *binary = new cLevel_Binary();
+
+		if( binary->Load( m_level_filename ) )
+		{
+			SDL_LockMutex( m_mutex );
+			m_binary = binary;
+			SDL_UnlockMutex( m_mutex );
+		}
+		else
+		{
+			delete binary;
+		}
+	}
+
+	vector<std::string> images;
+	Get_Level_Images( images );
+
+	for( vector<std::string>::iterator itr = images.begin(), itr_end = images.end(); itr != itr_end; ++itr )
+	{
+		if( Is_Cancelled() )
+		{
+			return;
+		}
+
+		const std::string &filename = (*itr);
+
+		// already loaded
+		if( std::binary_search( m_loaded_images.begin(), m_loaded_images.end(), filename ) )
+		{
+			continue;
+		}
+
+		// use the same file as cVideo::Load_Image
+		std::string image_file;
+		std::string settings_file = filename.substr( 0, filename.rfind( "." ) ) + ".settings";
+
+		if( File_Exists( settings_file ) )
+		{
+			std::string img_filename_cache = m_imgcache_dir + "/" + settings_file.substr( strlen( DATA_DIR "/" ) ) + ".png";
+
+			// base images without an image cache file are loaded with the settings
+			if( File_Exists( img_filename_cache ) )
+			{
+				image_file = img_filename_cache;
+			}
+		}
+		else if( File_Exists( filename ) )
+		{
+			image_file = filename;
+		}
+
+		if( image_file.empty() )
+		{
+			continue;
+		}
+
+		SDL_Surface *surface = IMG_Load( image_file.c_str() );
+
+		if( !surface )
+		{
+			continue;
+		}
+
+		SDL_LockMutex( m_mutex );
+
+		if( m_surfaces.Add( image_file, surface ) )
+		{
+			m_surface_list.push_back( surface );
+		}
+		else
+		{
+			SDL_FreeSurface( surface );
+		}
+
+		SDL_UnlockMutex( m_mutex );
+	}
+}
+
+bool cLevel_Preloader :: Is_Cancelled( void )
+{
+	SDL_LockMutex( m_mutex );
+	bool cancel = m_cancel;
+	SDL_UnlockMutex( m_mutex );
+
+	return cancel;
+}
+
+bool cLevel_Preloader :: Is_Running( void )
+{
+	if( !m_thread )
+	{
+		return 0;
+	}
+
+	SDL_LockMutex( m_mutex );
+	bool finished = m_finished;
+	SDL_UnlockMutex( m_mutex );
+
+	return !finished;
+}
+
+void cLevel_Preloader :: Get_Level_Images( vector<std::string> &images ) const
+{
+	vector<std::string> values;
+
+	if( m_binary )
+	{
+		values = m_binary->Get_Strings();
+	}
+	// get the attribute values from the level file
+	else
+	{
+		ifstream ifs( m_level_filename.c_str(), ios::in );
+
+		if( !ifs )
+		{
+			return;
+		}
+
+		stringstream content;
+		content << ifs.rdbuf();
+		ifs.close();
+
+		const std::string data = content.str();
+		std::string::size_type pos = 0;
+
+		while( ( pos = data.find( "value=\"", pos ) ) != std::string::npos )
+		{
+			pos += 7;
+			std::string::size_type end = data.find( '"', pos );
+
+			if( end == std::string::npos )
+			{
+				break;
+			}
+
+			values.push_back( data.substr( pos, end - pos ) );
+			pos = end + 1;
+		}
+	}
+
+	for( vector<std::string>::iterator itr = values.begin(), itr_end = values.end(); itr != itr_end; ++itr )
+	{
+		std::string filename = (*itr);
+
+		// .settings file type can't be used directly
+		if( filename.length() > 9 && filename.compare( filename.length() - 9, 9, ".settings" ) == 0 )
+		{
+			filename.replace( filename.length() - 9, 9, ".png" );
+		}
+		// not an image
+		else if( filename.length() < 4 || filename.compare( filename.length() - 4, 4, ".png" ) != 0 )
+		{
+			continue;
+		}
+
+		// pixmaps dir must be given
+		if( filename.find( DATA_DIR "/" GAME_PIXMAPS_DIR "/" ) == std::string::npos )
+		{
+			filename.insert( 0, DATA_DIR "/" GAME_PIXMAPS_DIR "/" );
+		}
+
+		images.push_back( filename );
+	}
+
+	// remove duplicates
+	std::sort( images.begin(), images.end() );
+	images.erase( std::unique( images.begin(), images.end() ), images.end() );
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cLevel_Preloader *pLevel_Preloader = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
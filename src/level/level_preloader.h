@@ -0,0 +1,117 @@
+/***************************************************************************
+ * level_preloader.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_LEVEL_PRELOADER_H
+#define SMC_LEVEL_PRELOADER_H
+
+#include "../core/global_basic.h"
+#include "../core/hash_index.h"
+#include "../level/level_binary.h"
+// SDL
+#include "SDL.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cLevel_Preloader *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Loads a level file and decodes its images in a thread
+ * When the level gets loaded the main thread takes the preloaded data
+ * and only needs to create the objects and textures.
+ * Images created in code and images using a settings base image without
+ * an image cache file are not preloaded.
+*/
+class cLevel_Preloader
+{
+public:
+	cLevel_Preloader( void );
+	~cLevel_Preloader( void );
+
+	/* Start preloading the given level
+	 * does nothing if the level is already preloading, not found or the active level
+	 * a different preloading level is cancelled
+	 * but kept if it is still running and cancel_running is not set
+	*/
+	void Preload( std::string level_name, bool cancel_running = 1 );
+	// Wait until the preloading thread is finished
+	void Wait( void );
+	// Cancel preloading and delete all preloaded data
+	void Clear( void );
+
+	/* Return the preloaded compiled level and remove it
+	 * waits for the preloading if it is the given level or else cancels it
+	 * returns NULL if not available
+	*/
+	cLevel_Binary *Get_Level_Binary( const std::string &level_filename );
+	/* Return the preloaded image surface and remove it
+	 * the surface must be freed by the caller
+	 * returns NULL if not available
+	*/
+	SDL_Surface *Get_Surface( const std::string &filename );
+
+	// preloading level name as requested
+	std::string m_level_name;
+	// preloading level filename
+	std::string m_level_filename;
+
+private:
+	// Thread entry point
+	static int Thread_Function( void *data );
+	// Load the level and its images
+	void Run( void );
+	// Return true if cancelled
+	bool Is_Cancelled( void );
+	// Return true if the thread is still preloading
+	bool Is_Running( void );
+	// Return all image filenames used in the level
+	void Get_Level_Images( vector<std::string> &images ) const;
+
+	// preloading thread
+	SDL_Thread *m_thread;
+	// locks the data shared with the thread
+	SDL_mutex *m_mutex;
+	// if set the thread stops
+	bool m_cancel;
+	// set by the thread if finished
+	bool m_finished;
+
+	// level names which can not be preloaded from the active level
+	vector<std::string> m_rejected_levels;
+	// active level filename of the rejected level names
+	std::string m_rejected_active_level;
+
+	// preloaded compiled level
+	cLevel_Binary *m_binary;
+	// preloaded image surfaces by filename
+	cHash_Index<SDL_Surface> m_surfaces;
+	typedef vector<SDL_Surface *> SurfaceList;
+	SurfaceList m_surface_list;
+
+	// image cache directory
+	std::string m_imgcache_dir;
+	// sorted filenames of the already loaded images
+	vector<std::string> m_loaded_images;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Level Preloader
+extern cLevel_Preloader *pLevel_Preloader;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
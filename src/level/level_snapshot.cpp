@@ -0,0 +1,125 @@
+/***************************************************************************
+ * level_snapshot.cpp  -  in memory start state of a loaded level
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../level/level_snapshot.h"
+#include "../core/filesystem/filesystem.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** *** cLevel_Snapshot *** *** *** *** *** *** *** *** *** *** *** */
+
+cLevel_Snapshot :: cLevel_Snapshot( void )
+{
+	m_modification_time = 0;
+	m_recording = 0;
+	m_finished = 0;
+}
+
+cLevel_Snapshot :: ~cLevel_Snapshot( void )
+{
+	Clear();
+}
+
+void cLevel_Snapshot :: Clear( void )
+{
+	for( cSprite_List::iterator itr = m_sprites.begin(), itr_end = m_sprites.end(); itr != itr_end; ++itr )
+	{
+		delete *itr;
+	}
+
+	m_sprites.clear();
+	m_elements.clear();
+	m_level_filename.clear();
+	m_modification_time = 0;
+	m_recording = 0;
+	m_finished = 0;
+}
+
+void cLevel_Snapshot :: Begin( const std::string &level_filename )
+{
+	Clear();
+
+	m_level_filename = level_filename;
+	m_modification_time = Get_File_Modification_Time( level_filename );
+	m_recording = 1;
+}
+
+void cLevel_Snapshot :: Add_Element( const CEGUI::String &name, const CEGUI::XMLAttributes &attributes )
+{
+	if( !m_recording )
+	{
+		return;
+	}
+
+	m_elements.push_back( cLevel_Snapshot_Element() );
+	m_elements.back().m_name = name;
+	m_elements.back().m_attributes = attributes;
+}
+
+void cLevel_Snapshot :: Finish( const cSprite_List &sprites )
+{
+	if( !m_recording )
+	{
+		return;
+	}
+
+	m_recording = 0;
+	m_sprites.reserve( sprites.size() );
+
+	for( cSprite_List::const_iterator itr = sprites.begin(), itr_end = sprites.end(); itr != itr_end; ++itr )
+	{
+		cSprite *obj = (*itr);
+
+		// not a level object
+		if( obj->m_spawned )
+		{
+			continue;
+		}
+
+		cSprite *copy = obj->Copy();
+
+		if( !copy )
+		{
+			debug_print( "Level snapshot : Could not copy sprite %s\n", obj->m_name.c_str() );
+			Clear();
+			return;
+		}
+
+		m_sprites.push_back( copy );
+	}
+
+	m_finished = 1;
+}
+
+bool cLevel_Snapshot :: Is_Valid( const std::string &level_filename ) const
+{
+	if( !m_finished || m_level_filename.compare( level_filename ) != 0 )
+	{
+		return 0;
+	}
+
+	// changed outside of the game
+	if( m_modification_time != Get_File_Modification_Time( level_filename ) )
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
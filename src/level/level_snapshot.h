@@ -0,0 +1,87 @@
+/***************************************************************************
+ * level_snapshot.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_LEVEL_SNAPSHOT_H
+#define SMC_LEVEL_SNAPSHOT_H
+
+#include "../core/global_basic.h"
+#include "../objects/sprite.h"
+// CEGUI
+#include "CEGUIXMLAttributes.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cLevel_Snapshot_Element *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// level settings element
+class cLevel_Snapshot_Element
+{
+public:
+	CEGUI::String m_name;
+	CEGUI::XMLAttributes m_attributes;
+};
+
+/* *** *** *** *** *** cLevel_Snapshot *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Start state of a loaded level
+ * Keeps the level settings elements and a copy of every level sprite
+ * taken directly after loading. If the same level gets loaded again
+ * it is created from the snapshot without reading and parsing the file.
+*/
+class cLevel_Snapshot
+{
+public:
+	cLevel_Snapshot( void );
+	~cLevel_Snapshot( void );
+
+	// Delete all data
+	void Clear( void );
+
+	// Start recording a new snapshot of the given level file
+	void Begin( const std::string &level_filename );
+	// Add a level settings element if recording
+	void Add_Element( const CEGUI::String &name, const CEGUI::XMLAttributes &attributes );
+	/* Copy the start state of the given sprites and finish recording
+	 * spawned sprites are ignored
+	 * if a sprite can not be copied the snapshot is cleared
+	*/
+	void Finish( const cSprite_List &sprites );
+
+	// Return true if finished for the given level file and the file was not modified since
+	bool Is_Valid( const std::string &level_filename ) const;
+
+	typedef vector<cLevel_Snapshot_Element> ElementList;
+	// level settings elements in the loaded order
+	ElementList m_elements;
+	// sprite copies in the loaded order
+	cSprite_List m_sprites;
+
+private:
+	// level filename
+	std::string m_level_filename;
+	// level file modification time
+	time_t m_modification_time;
+	// if set elements are added
+	bool m_recording;
+	// if set the snapshot can be used
+	bool m_finished;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -26,6 +26,7 @@
 #include "../level/level.h"
 #include "../core/i18n.h"
 #include "../core/filesystem/filesystem.h"
+#include "../level/level_preloader.h"
 // CEGUI
 #include "CEGUIXMLAttributes.h"
 
@@ -81,6 +82,8 @@ void cLevel_Exit :: Init( void )
 	editor_color.alpha = 128;
 
 	editor_entry_name = NULL;
+
+	m_preload_in_range = 0;
 }
 
 cLevel_Exit *cLevel_Exit :: Copy( void )
@@ -209,6 +212,27 @@ void cLevel_Exit :: Create_Name( void )
 	}
 }
 
+void cLevel_Exit :: Update( void )
+{
+	if( dest_level.empty() || editor_level_enabled || !pLevel_Preloader )
+	{
+		return;
+	}
+
+	// preload the destination level if the player gets near
+	const float dist_x = ( pPlayer->m_col_rect.m_x + ( pPlayer->m_col_rect.m_w * 0.5f ) ) - ( m_col_rect.m_x + ( m_col_rect.m_w * 0.5f ) );
+	const float dist_y = ( pPlayer->m_col_rect.m_y + ( pPlayer->m_col_rect.m_h * 0.5f ) ) - ( m_col_rect.m_y + ( m_col_rect.m_h * 0.5f ) );
+	const bool in_range = ( dist_x * dist_x ) + ( dist_y * dist_y ) < level_exit_preload_distance * level_exit_preload_distance;
+
+	// a different nearby exit keeps its running preloading
+	if( in_range && !m_preload_in_range )
+	{
+		pLevel_Preloader->Preload( dest_level, 0 );
+	}
+
+	m_preload_in_range = in_range;
+}
+
 void cLevel_Exit :: Draw( cSurface_Request *request /* = NULL */ )
 {
 	if( !m_valid_draw )
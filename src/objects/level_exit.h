@@ -44,6 +44,9 @@ enum Level_Exit_motion
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
+// distance from the player to start preloading the destination level
+static const float level_exit_preload_distance = 600.0f;
+
 /* Level exit
  * or if a destination or entry is given it gets you there
 */
@@ -69,6 +72,8 @@ public:
 	// Set direction
 	void Set_Direction( const ObjectDirection dir );
 
+	// update
+	virtual void Update( void );
 	// draw
 	virtual void Draw( cSurface_Request *request = NULL );
 
@@ -126,6 +131,9 @@ public:
 	// editor entry name text
 	cGL_Surface *editor_entry_name;
 
+	// if the player is in the preload distance
+	bool m_preload_in_range;
+
 private:
 	void Create_Name( void );
 };
@@ -26,6 +26,8 @@
 #include "../video/renderer.h"
 #include "../video/gl_surface.h"
 #include "../core/sprite_manager.h"
+// std::deque
+#include <deque>
 
 namespace SMC
 {
@@ -36,6 +38,70 @@ namespace SMC
 
 const float deg_to_rad = static_cast<float>(M_PI / 180.0f);
 
+/* *** *** *** *** *** *** *** cCollision_Step_Data *** *** *** *** *** *** *** *** *** *** */
+
+// Data for moving in steps
+struct cCollision_Step_Data
+{
+	// first step each object could be touched in
+	vector<unsigned int> m_touch_steps;
+	// objects which could be touched in the current step
+	cSprite_List m_check_list;
+	// object list number of the check list objects
+	vector<unsigned int> m_check_nums;
+};
+
+// Clear the buffer for the next use but keep its capacity
+static void Clear_Buffer( cSprite_List &buffer )
+{
+	buffer.clear();
+}
+
+static void Clear_Buffer( cCollision_Step_Data &buffer )
+{
+	buffer.m_touch_steps.clear();
+	buffer.m_check_list.clear();
+	buffer.m_check_nums.clear();
+}
+
+/* *** *** *** *** *** *** *** cNested_Buffer *** *** *** *** *** *** *** *** *** *** */
+
+/* Reused buffer for collision checks and moves
+ * each nesting depth gets its own buffer
+ * which keeps its capacity for the next use
+*/
+template <class T> class cNested_Buffer
+{
+public:
+	cNested_Buffer( void )
+	{
+		// a deque keeps the references to the other buffers valid
+		if( m_depth >= m_buffers.size() )
+		{
+			m_buffers.push_back( T() );
+		}
+
+		m_buffer = &m_buffers[m_depth];
+		m_depth++;
+	}
+
+	~cNested_Buffer( void )
+	{
+		Clear_Buffer( *m_buffer );
+		m_depth--;
+	}
+
+	// buffer of this nesting depth
+	T *m_buffer;
+
+private:
+	static std::deque<T> m_buffers;
+	static size_t m_depth;
+};
+
+template <class T> std::deque<T> cNested_Buffer<T> :: m_buffers;
+template <class T> size_t cNested_Buffer<T> :: m_depth = 0;
+
 /* *** *** *** *** *** *** *** cMovingSprite *** *** *** *** *** *** *** *** *** *** */
 
 cMovingSprite :: cMovingSprite( cGL_Surface *new_image /* = NULL */, float x /* = 0 */, float y /* = 0 */, bool del_img /* = 0 */ )
@@ -197,7 +263,111 @@ void cMovingSprite :: Move( float move_x, float move_y, bool real /* = 0 */ )
 	Check_Out_Of_Level_Ver( move_y, 1 );
 }
 
-cObjectCollisionType *cMovingSprite :: Col_Move_in_Steps( float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List sprite_list, bool stop_on_internal /* = 0 */ )
+// step of objects which can not be touched
+static const unsigned int col_step_untouchable = static_cast<unsigned int>(-1);
+
+/* Return the steps needed on one axis until the moving range could touch the object range
+ * returns -1 if it can never touch it
+*/
+static float Get_Touch_Steps( float pos, float size, float obj_pos, float obj_size, float step_size )
+{
+	float gap;
+
+	// object is after
+	if( pos + size < obj_pos )
+	{
+		if( step_size <= 0.0f )
+		{
+			return -1.0f;
+		}
+
+		gap = obj_pos - ( pos + size );
+	}
+	// object is before
+	else if( pos > obj_pos + obj_size )
+	{
+		if( step_size >= 0.0f )
+		{
+			return -1.0f;
+		}
+
+		gap = pos - ( obj_pos + obj_size );
+	}
+	// already touching
+	else
+	{
+		return 0.0f;
+	}
+
+	// tolerance for the rounding of the added steps
+	gap -= 1.0f;
+
+	if( gap <= 0.0f )
+	{
+		return 0.0f;
+	}
+
+	return gap / fabs( step_size );
+}
+
+/* Remove the objects with an internal collision from the check list and set them untouchable
+ * the collisions must be in the check list order
+ * returns the number of removed objects
+*/
+static size_t Remove_Internal_Collisions( const cObjectCollisionType *col_list, cCollision_Step_Data *data )
+{
+	cSprite_List &check_list = data->m_check_list;
+	vector<unsigned int> &check_nums = data->m_check_nums;
+
+	size_t removed = 0;
+	size_t check_pos = 0;
+	size_t valid_pos = 0;
+
+	for( cObjectCollision_List::const_iterator itr = col_list->objects.begin(), itr_end = col_list->objects.end(); itr != itr_end; ++itr )
+	{
+		const cObjectCollision *col = (*itr);
+
+		if( col->valid_type != COL_VTYPE_INTERNAL )
+		{
+			continue;
+		}
+
+		// keep the objects before it
+		while( check_pos < check_list.size() && check_list[check_pos] != col->obj )
+		{
+			check_list[valid_pos] = check_list[check_pos];
+			check_nums[valid_pos] = check_nums[check_pos];
+			valid_pos++;
+			check_pos++;
+		}
+
+		// not found
+		if( check_pos >= check_list.size() )
+		{
+			break;
+		}
+
+		data->m_touch_steps[check_nums[check_pos]] = col_step_untouchable;
+		check_pos++;
+		removed++;
+	}
+
+	// keep the objects after the last one
+	while( check_pos < check_list.size() )
+	{
+		check_list[valid_pos] = check_list[check_pos];
+		check_nums[valid_pos] = check_nums[check_pos];
+		valid_pos++;
+		check_pos++;
+	}
+
+	check_list.resize( valid_pos );
+	check_nums.resize( valid_pos );
+
+	return removed;
+}
+
+cObjectCollisionType *cMovingSprite :: Col_Move_in_Steps( float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, const cSprite_List &sprite_list, bool stop_on_internal /* = 0 */ )
 {
 	if( sprite_list.empty() )
 	{
@@ -208,6 +378,52 @@ cObjectCollisionType *cMovingSprite :: Col_Move_in_Steps( float move_x, float mo
 	// collision list
 	cObjectCollisionType *col_list = new cObjectCollisionType();
 
+	/* Swept collision rect
+	 * every step moves at most the step size on each axis
+	 * and with the gap to the object on both axes this gives the first step it could be touched in
+	*/
+	cNested_Buffer<cCollision_Step_Data> step_data;
+	vector<unsigned int> &touch_steps = step_data.m_buffer->m_touch_steps;
+	touch_steps.assign( sprite_list.size(), col_step_untouchable );
+	unsigned int next_touch_step = col_step_untouchable;
+
+	for( size_t i = 0; i < sprite_list.size(); i++ )
+	{
+		const GL_rect &obj_rect = sprite_list[i]->m_col_rect;
+
+		const float steps_x = Get_Touch_Steps( m_col_rect.m_x, m_col_rect.m_w, obj_rect.m_x, obj_rect.m_w, step_size_x );
+		const float steps_y = Get_Touch_Steps( m_col_rect.m_y, m_col_rect.m_h, obj_rect.m_y, obj_rect.m_h, step_size_y );
+
+		// moving away or not moving on an axis
+		if( steps_x < 0.0f || steps_y < 0.0f )
+		{
+			continue;
+		}
+
+		const float steps = ( steps_x > steps_y ) ? steps_x : steps_y;
+
+		// too far away
+		if( steps >= 1000000.0f )
+		{
+			continue;
+		}
+
+		// steps are counted from 1
+		touch_steps[i] = static_cast<unsigned int>(steps) + 1;
+
+		if( touch_steps[i] < next_touch_step )
+		{
+			next_touch_step = touch_steps[i];
+		}
+	}
+
+	// objects which could be touched in the current step
+	cSprite_List &check_list = step_data.m_buffer->m_check_list;
+	vector<unsigned int> &check_nums = step_data.m_buffer->m_check_nums;
+	// objects not removed as internal collision
+	size_t objects_left = sprite_list.size();
+	unsigned int step = 0;
+
 	bool move_x_valid = 1;
 	bool move_y_valid = 1;
 
@@ -216,6 +432,29 @@ cObjectCollisionType *cMovingSprite :: Col_Move_in_Steps( float move_x, float mo
 	*/
 	while( move_x_valid || move_y_valid )
 	{
+		step++;
+
+		// add the objects which could be touched from now on
+		if( step >= next_touch_step )
+		{
+			check_list.clear();
+			check_nums.clear();
+			next_touch_step = col_step_untouchable;
+
+			for( size_t i = 0; i < sprite_list.size(); i++ )
+			{
+				if( touch_steps[i] <= step )
+				{
+					check_list.push_back( sprite_list[i] );
+					check_nums.push_back( static_cast<unsigned int>(i) );
+				}
+				else if( touch_steps[i] < next_touch_step )
+				{
+					next_touch_step = touch_steps[i];
+				}
+			}
+		}
+
 		if( move_x_valid )
 		{
 			// nothing to do
@@ -225,66 +464,51 @@ cObjectCollisionType *cMovingSprite :: Col_Move_in_Steps( float move_x, float mo
 				continue;
 			}
 
-			// collision check
-			cObjectCollisionType *col_list_temp = Collision_Check_Relative( step_size_x, 0.0f, 0.0f, 0.0f, COLLIDE_COMPLETE, &sprite_list );
-			
 			bool collision_found = 0;
 
-			// stop on everything
-			if( stop_on_internal )
-			{
-				if( col_list_temp->size() )
-				{
-					collision_found = 1;
-				}
-			}
-			// stop only on blocking
-			else
+			// no object can be touched
+			if( !check_list.empty() )
 			{
-				if( col_list_temp->Is_Included( COL_VTYPE_BLOCKING ) )
+				// collision check
+				cObjectCollisionType *col_list_temp = Collision_Check_Relative( step_size_x, 0.0f, 0.0f, 0.0f, COLLIDE_COMPLETE, &check_list );
+
+				// stop on everything
+				if( stop_on_internal )
 				{
-					collision_found = 1;
+					if( col_list_temp->size() )
+					{
+						collision_found = 1;
+					}
 				}
-				// remove internal collision from further checks
-				else if( col_list_temp->objects.size() )
+				// stop only on blocking
+				else
 				{
-					for( cObjectCollision_List::iterator itr = col_list_temp->objects.begin(), itr_end = col_list_temp->objects.end(); itr != itr_end; ++itr )
+					if( col_list_temp->Is_Included( COL_VTYPE_BLOCKING ) )
 					{
-						cObjectCollision *col = (*itr);
-
-						if( col->valid_type != COL_VTYPE_INTERNAL )
-						{
-							continue;
-						}
-
-						// find in sprite list
-						cSprite_List::iterator sprite_itr = std::find( sprite_list.begin(), sprite_list.end(), col->obj );
+						collision_found = 1;
+					}
+					// remove internal collision from further checks
+					else if( col_list_temp->objects.size() )
+					{
+						objects_left -= Remove_Internal_Collisions( col_list_temp, step_data.m_buffer );
 
-						// not found
-						if( sprite_itr == sprite_list.end() )
+						// if no objects left
+						if( !objects_left )
 						{
-							continue;
+							// move to final position
+							m_pos_x = final_pos_x;
 						}
-
-						sprite_list.erase( sprite_itr );
 					}
+				}
 
-					// if no objects left
-					if( sprite_list.empty() )
-					{
-						// move to final position
-						m_pos_x = final_pos_x;
-					}
+				if( col_list_temp->size() )
+				{
+					col_list->objects.insert( col_list->objects.end(), col_list_temp->objects.begin(), col_list_temp->objects.end() );
+					col_list_temp->objects.clear();
 				}
-			}
-			
-			if( col_list_temp->size() )
-			{
-				col_list->objects.insert( col_list->objects.end(), col_list_temp->objects.begin(), col_list_temp->objects.end() );
-				col_list_temp->objects.clear();
-			}
 
-			delete col_list_temp;
+				delete col_list_temp;
+			}
 
 			if( !collision_found )
 			{
@@ -317,66 +541,72 @@ cObjectCollisionType *cMovingSprite :: Col_Move_in_Steps( float move_x, float mo
 				continue;
 			}
 
-			// collision check
-			cObjectCollisionType *col_list_temp = Collision_Check_Relative( 0.0f, step_size_y, 0.0f, 0.0f, COLLIDE_COMPLETE, &sprite_list );
-
 			bool collision_found = 0;
 
-			// stop on everything
-			if( stop_on_internal )
+			// no object can be touched
+			if( !check_list.empty() )
 			{
-				if( col_list_temp->size() )
-				{
-					collision_found = 1;
-				}
-			}
-			// stop only on blocking
-			else
-			{
-				if( col_list_temp->Is_Included( COL_VTYPE_BLOCKING ) )
+				// collision check
+				cObjectCollisionType *col_list_temp = Collision_Check_Relative( 0.0f, step_size_y, 0.0f, 0.0f, COLLIDE_COMPLETE, &check_list );
+
+				// stop on everything
+				if( stop_on_internal )
 				{
-					collision_found = 1;
+					if( col_list_temp->size() )
+					{
+						collision_found = 1;
+					}
 				}
-				// remove internal collision from further checks
-				else if( col_list_temp->objects.size() )
+				// stop only on blocking
+				else
 				{
-					for( cObjectCollision_List::iterator itr = col_list_temp->objects.begin(), itr_end = col_list_temp->objects.end(); itr != itr_end; ++itr )
+					if( col_list_temp->Is_Included( COL_VTYPE_BLOCKING ) )
 					{
-						cObjectCollision *col = (*itr);
-
-						if( col->valid_type != COL_VTYPE_INTERNAL )
-						{
-							continue;
-						}
-
-						// find in sprite list
-						cSprite_List::iterator sprite_itr = std::find( sprite_list.begin(), sprite_list.end(), col->obj );
-
-						// not found
-						if( sprite_itr == sprite_list.end() )
-						{
-							continue;
-						}
-
-						sprite_list.erase( sprite_itr );
-
-						// if no objects left
-						if( sprite_list.empty() )
+						collision_found = 1;
+					}
+					// remove internal collision from further checks
+					else if( col_list_temp->objects.size() )
+					{
+						for( cObjectCollision_List::iterator itr = col_list_temp->objects.begin(), itr_end = col_list_temp->objects.end(); itr != itr_end; ++itr )
 						{
-							// move to final position
-							m_pos_y = final_pos_y;
+							cObjectCollision *col = (*itr);
+
+							if( col->valid_type != COL_VTYPE_INTERNAL )
+							{
+								continue;
+							}
+
+							// find in check list
+							cSprite_List::iterator sprite_itr = std::find( check_list.begin(), check_list.end(), col->obj );
+
+							// not found
+							if( sprite_itr == check_list.end() )
+							{
+								continue;
+							}
+
+							check_list.erase( sprite_itr );
+							touch_steps[std::find( sprite_list.begin(), sprite_list.end(), col->obj ) - sprite_list.begin()] = col_step_untouchable;
+							objects_left--;
+
+							// if no objects left
+							if( !objects_left )
+							{
+								// move to final position
+								m_pos_y = final_pos_y;
+							}
 						}
 					}
 				}
-			}
-			
-			if( col_list_temp->size() )
-			{
-				col_list->objects.insert( col_list->objects.end(), col_list_temp->objects.begin(), col_list_temp->objects.end() );
-				col_list_temp->objects.clear();
-			}
 
-			delete col_list_temp;
+				if( col_list_temp->size() )
+				{
+					col_list->objects.insert( col_list->objects.end(), col_list_temp->objects.begin(), col_list_temp->objects.end() );
+					col_list_temp->objects.clear();
+				}
+
+				delete col_list_temp;
+			}
 
 			if( !collision_found )
 			{
@@ -451,8 +681,9 @@ void cMovingSprite :: Col_Move( float move_x, float move_y, bool real /* = 0 */,
 			complete_rect.m_h -= move_y;
 		}
 
-		cSprite_List sprite_list;
-		pActive_Sprite_Manager->Get_Colliding_Objects( sprite_list, complete_rect, 1, this );
+		cNested_Buffer<cSprite_List> candidates;
+		const cSprite_List &sprite_list = *candidates.m_buffer;
+		pActive_Sprite_Manager->Get_Colliding_Objects( *candidates.m_buffer, complete_rect, 1, this );
 
 		// step size
 		float step_size_x = move_x;
@@ -641,6 +872,11 @@ void cMovingSprite :: Draw( cSurface_Request *request /* = NULL */ )
 	}
 }
 
+bool cMovingSprite :: Is_Chunk_Draw_Valid( void ) const
+{
+	return 0;
+}
+
 cObjectCollisionType *cMovingSprite :: Collision_Check_Relative( const float x, const float y, const float w /* = 0 */, const float h /* = 0 */, const ColCheckType check_type /* = COLLIDE_COMPLETE */, cSprite_List *objects /* = NULL */ )
 {
 	return Collision_Check_Absolute( m_col_rect.m_x + x, m_col_rect.m_y + y, w, h, check_type, objects );
@@ -723,10 +959,14 @@ cObjectCollisionType *cMovingSprite :: Collision_Check( const GL_rect &new_rect,
 		return col_list;
 	}
 
-	// if no object list is given get all objects available
+	// objects near the collision rect
+	cNested_Buffer<cSprite_List> candidates;
+
+	// if no object list is given get all objects touching the rect
 	if( !objects )
 	{
-		objects = &pActive_Sprite_Manager->objects;
+		pActive_Sprite_Manager->Get_Colliding_Objects( *candidates.m_buffer, new_rect, 0, this );
+		objects = candidates.m_buffer;
 
 		// Player
 		if( m_type != TYPE_PLAYER && new_rect.Intersects( pActive_Player->m_col_rect ) )
@@ -1414,6 +1654,12 @@ void cMovingSprite :: Send_Collision( const cObjectCollision *collision, bool ha
 	else
 	{
 		target_obj->Add_Collision( new_collision );
+
+		// handle it even if sleeping
+		if( target_obj->m_sprite_manager )
+		{
+			target_obj->m_sprite_manager->Wake( target_obj );
+		}
 	}
 }
 
@@ -113,10 +113,12 @@ public:
 	* if request is NULL automatically creates the request
 	*/
 	virtual void Draw( cSurface_Request *request = NULL );
+	// moving sprites are never drawn from a static chunk
+	virtual bool Is_Chunk_Draw_Valid( void ) const;
 
 	/* Check if moving the current collision rect position with the given values is valid
 	 * check_type : set which collision types are added to the list
-	 * objects : if set check these object instead of all
+	 * objects : if set check these object instead of all from the sprite manager collision grid
 	 * The collision data should be deleted if not used anymore
 	*/
 	cObjectCollisionType *Collision_Check_Relative( const float x, const float y, const float w = 0, const float h = 0, const ColCheckType check_type = COLLIDE_COMPLETE, cSprite_List *objects = NULL );
@@ -229,11 +231,12 @@ public:
 
 private:
 	/* moves in steps and checks in both directions simultaneous
+	 * objects are only checked from the first step their collision rect could be touched in
 	 * returns the found collisions
 	 * sprite_list : objects to check
 	 * stop_on_internal : if set stops moving if internal collision was found
 	*/
-	cObjectCollisionType *Col_Move_in_Steps( float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List sprite_list, bool stop_on_internal = 0 );
+	cObjectCollisionType *Col_Move_in_Steps( float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, const cSprite_List &sprite_list, bool stop_on_internal = 0 );
 };
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
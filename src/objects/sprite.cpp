@@ -60,6 +60,12 @@ void cCollidingSprite :: Handle_Collisions( void )
 	}
 
 	col_list.clear();
+
+	// keep the allocated list if no new collisions were added
+	if( collisions.empty() )
+	{
+		collisions.swap( col_list );
+	}
 }
 
 cObjectCollision *cCollidingSprite :: Create_Collision_Object( const cSprite *base, cSprite *col, Col_Valid_Type valid_type ) const
@@ -389,6 +395,8 @@ void cSprite :: Init( void )
 	m_pos_y = 0;
 	m_pos_z = 0;
 	m_editor_pos_z = 0;
+	m_tick_pos_x = 0;
+	m_tick_pos_y = 0;
 
 	m_massive_type = MASS_PASSIVE;
 	m_active = 1;
@@ -418,6 +426,20 @@ void cSprite :: Init( void )
 	m_valid_draw = 1;
 	m_valid_update = 1;
 
+	m_sprite_manager = NULL;
+	m_grid_x1 = -1;
+	m_grid_y1 = -1;
+	m_grid_x2 = -1;
+	m_grid_y2 = -1;
+	m_grid_query_id = 0;
+	m_array_num = -1;
+	m_generation = 0;
+	m_can_sleep = 0;
+	m_woken = 0;
+	m_active_frame = 0;
+	m_chunk_num = -1;
+	m_chunk_drawn = 0;
+
 	m_editor_window_name_width = 0;
 }
 
@@ -434,6 +456,7 @@ cSprite *cSprite :: Copy( void )
 	basic_sprite->m_sprite_array = m_sprite_array;
 	basic_sprite->Set_Massive_Type( m_massive_type );
 	basic_sprite->m_can_be_ground = m_can_be_ground;
+	basic_sprite->m_can_sleep = m_can_sleep;
 	basic_sprite->Set_Rotation_Affects_Rect( m_rotation_affects_rect );
 	basic_sprite->Set_Scale_Affects_Rect( m_scale_affects_rect );
 	basic_sprite->Set_Scale_Directions( m_scale_up, m_scale_down, m_scale_left, m_scale_right );
@@ -630,6 +653,16 @@ void cSprite :: Set_Sprite_Type( SpriteType ntype )
 		Set_Massive_Type( MASS_CLIMBABLE );
 		m_can_be_ground = 0;
 	}
+
+	// static sprites have no updates
+	m_can_sleep = ( ntype == TYPE_MASSIVE || ntype == TYPE_PASSIVE || ntype == TYPE_FRONT_PASSIVE || ntype == TYPE_HALFMASSIVE || ntype == TYPE_CLIMBABLE );
+
+	if( m_sprite_manager )
+	{
+		m_sprite_manager->m_sleep_changed = 1;
+	}
+
+	Update_Chunk();
 }
 
 std::string cSprite :: Get_Sprite_Type_String( void ) const
@@ -694,6 +727,7 @@ void cSprite :: Set_Ignore_Camera( bool enable /* = 0 */ )
 	m_no_camera = enable;
 
 	Update_Valid_Draw();
+	Update_Chunk();
 }
 
 void cSprite :: Set_Pos( float x, float y, bool new_startpos /* = 0 */ )
@@ -734,6 +768,21 @@ void cSprite :: Set_Pos_Y( float y, bool new_startpos /* = 0 */ )
 	Update_Position_Rect();
 }
 
+void cSprite :: Set_Interpolated_Pos( float alpha )
+{
+	const float diff_x = m_pos_x - m_tick_pos_x;
+	const float diff_y = m_pos_y - m_tick_pos_y;
+
+	// set to a new position
+	if( fabs( diff_x ) > fixed_timestep_interpolation_distance || fabs( diff_y ) > fixed_timestep_interpolation_distance )
+	{
+		return;
+	}
+
+	m_pos_x = m_tick_pos_x + ( diff_x * alpha );
+	m_pos_y = m_tick_pos_y + ( diff_y * alpha );
+}
+
 void cSprite :: Set_Active( bool enabled )
 {
 	// already set
@@ -746,6 +795,7 @@ void cSprite :: Set_Active( bool enabled )
 
 	Update_Valid_Draw();
 	Update_Valid_Update();
+	Update_Chunk();
 }
 
 void cSprite :: Set_Shadow( const Color &shadow, float pos )
@@ -757,6 +807,8 @@ void cSprite :: Set_Shadow( const Color &shadow, float pos )
 void cSprite :: Set_Shadow_Pos( float pos )
 {
 	m_shadow_pos = pos;
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Shadow_Color( const Color &shadow )
@@ -770,11 +822,15 @@ void cSprite :: Set_Color( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha /* =
 	m_color.green = green;
 	m_color.blue = blue;
 	m_color.alpha = alpha;
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Color( const Color &col )
 {
 	m_color = col;
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Color_Combine( float red, float green, float blue, GLint com_type )
@@ -811,6 +867,8 @@ void cSprite :: Set_Color_Combine( float red, float green, float blue, GLint com
 	{
 		m_combine_color[2] = 0.000001f;
 	}
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Rotation_Affects_Rect( bool enable /* = 0 */ )
@@ -901,6 +959,8 @@ void cSprite :: Set_Rotation_X( float rot, bool new_start_rot /* = 0 */ )
 	{
 		Update_Rect_Rotation_X();
 	}
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Rotation_Y( float rot, bool new_start_rot /* = 0 */ )
@@ -916,6 +976,8 @@ void cSprite :: Set_Rotation_Y( float rot, bool new_start_rot /* = 0 */ )
 	{
 		Update_Rect_Rotation_Y();
 	}
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Rotation_Z( float rot, bool new_start_rot /* = 0 */ )
@@ -931,6 +993,8 @@ void cSprite :: Set_Rotation_Z( float rot, bool new_start_rot /* = 0 */ )
 	{
 		Update_Rect_Rotation_Z();
 	}
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Rotation( float x, float y, float z, bool new_start_rot /* = 0 */ )
@@ -1003,6 +1067,8 @@ void cSprite :: Set_Scale_X( const float scale, const bool new_startscale /* = 0
 	{
 		m_start_scale_x = m_scale_x;
 	}
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Scale_Y( const float scale, const bool new_startscale /* = 0 */ )
@@ -1033,6 +1099,8 @@ void cSprite :: Set_Scale_Y( const float scale, const bool new_startscale /* = 0
 	{
 		m_start_scale_y = m_scale_y;
 	}
+
+	Update_Chunk();
 }
 
 void cSprite :: Set_Scale( const float scale, const bool new_startscale /* = 0 */ )
@@ -1121,6 +1189,12 @@ void cSprite :: Update_Position_Rect( void )
 		m_col_rect.m_y = m_pos_y + m_col_pos.m_y;
 	}
 
+	// update collision grid cells
+	if( m_sprite_manager )
+	{
+		m_sprite_manager->Update_Grid( this );
+	}
+
 	Update_Valid_Draw();
 }
 
@@ -1142,6 +1216,12 @@ void cSprite :: Update_Valid_Draw( void )
 void cSprite :: Update_Valid_Update( void )
 {
 	m_valid_update = Is_Update_Valid();
+
+	// the state changed
+	if( m_sprite_manager )
+	{
+		m_sprite_manager->Wake( this );
+	}
 }
 
 void cSprite :: Draw( cSurface_Request *request /* = NULL */ )
@@ -1273,11 +1353,22 @@ void cSprite :: Draw_Image( cSurface_Request *request /* = NULL */ ) const
 		request = new cSurface_Request();
 	}
 
+	Draw_Image_Data( request );
+
+	if( create_request )
+	{
+		// add request
+		pRenderer->Add( request );
+	}
+}
+
+void cSprite :: Draw_Image_Data( cSurface_Request *request ) const
+{
 	// editor
 	if( editor_enabled )
 	{
-		// texture id
-		request->texture_id = m_start_image->m_image;
+		// texture
+		m_start_image->Set_Texture_Data( request );
 
 		// size
 		request->w = m_start_image->m_start_w;
@@ -1369,8 +1460,8 @@ void cSprite :: Draw_Image( cSurface_Request *request /* = NULL */ ) const
 	// no editor
 	else
 	{
-		// texture id
-		request->texture_id = m_image->m_image;
+		// texture
+		m_image->Set_Texture_Data( request );
 
 		// size
 		request->w = m_image->m_start_w;
@@ -1472,11 +1563,13 @@ void cSprite :: Draw_Image( cSurface_Request *request /* = NULL */ ) const
 		request->shadow_pos = m_shadow_pos;
 		request->shadow_color = m_shadow_color;
 	}
+}
 
-	if( create_request )
+void cSprite :: Update_Chunk( void )
+{
+	if( m_sprite_manager )
 	{
-		// add request
-		pRenderer->Add( request );
+		m_sprite_manager->m_chunks.Update( this );
 	}
 }
 
@@ -1593,6 +1686,17 @@ bool cSprite :: Is_Update_Valid( void )
 	return 1;
 }
 
+bool cSprite :: Is_Sleep_Valid( void ) const
+{
+	// received collisions need to be handled
+	if( !collisions.empty() )
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
 bool cSprite :: Is_Draw_Valid( void )
 {
 	// if editor not enabled
@@ -1629,6 +1733,42 @@ bool cSprite :: Is_Draw_Valid( void )
 	return 1;
 }
 
+bool cSprite :: Is_Chunk_Draw_Valid( void ) const
+{
+	// only static sprites
+	if( m_type != TYPE_MASSIVE && m_type != TYPE_PASSIVE && m_type != TYPE_FRONT_PASSIVE && m_type != TYPE_HALFMASSIVE && m_type != TYPE_CLIMBABLE )
+	{
+		return 0;
+	}
+
+	// if editor not enabled
+	if( !editor_enabled )
+	{
+		// if not active or no image is set
+		if( !m_active || !m_image )
+		{
+			return 0;
+		}
+	}
+	// editor enabled
+	else
+	{
+		// destroyed, no image or obsolete image marked
+		if( m_auto_destroy || !m_start_image || m_start_image->m_obsolete )
+		{
+			return 0;
+		}
+	}
+
+	// drawn with its own render state
+	if( m_no_camera || m_shadow_pos || m_combine_type )
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
 void cSprite :: Destroy( void )
 {
 	// already destroyed
@@ -1644,6 +1784,12 @@ void cSprite :: Destroy( void )
 	Set_Image( NULL, 1 );
 
 	Clear_Collisions();
+
+	// the array slot can be reused
+	if( m_sprite_manager )
+	{
+		m_sprite_manager->Add_Free_Slot( this );
+	}
 }
 
 void cSprite :: Editor_Add( const CEGUI::String &name, const CEGUI::String &tooltip, CEGUI::Window *window_setting, float obj_width, float obj_height /* = 28 */, bool advance_row /* = 1 */ )
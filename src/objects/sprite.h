@@ -137,6 +137,11 @@ public:
 	void Set_Pos( float x, float y, bool new_startpos = 0 );
 	void Set_Pos_X( float x, bool new_startpos = 0 );
 	void Set_Pos_Y( float y, bool new_startpos = 0 );
+	/* Set the position between the position before the last fixed timestep update and the current position
+	 * only changes the drawing position and not the rectangles
+	 * if it moved too far it was set to a new position and is not interpolated
+	*/
+	void Set_Interpolated_Pos( float alpha );
 	// Set if active
 	void Set_Active( bool enabled );
 	/* Set the shadow
@@ -252,6 +257,10 @@ public:
 	 * no position nor debug updates
 	*/
 	void Draw_Image( cSurface_Request *request = NULL ) const;
+	// Set the image drawing data of the request
+	void Draw_Image_Data( cSurface_Request *request ) const;
+	// Rebuild the static chunk of this sprite after its drawing changed
+	void Update_Chunk( void );
 
 	/* Set the massive type
 	 * should be called after setting the new array
@@ -267,8 +276,16 @@ public:
 	bool Is_In_Player_Range( void ) const;
 	// if update is valid for the current state
 	virtual bool Is_Update_Valid( void );
+	/* if the sprite can sleep outside of the active region in the current state
+	 * only used if m_can_sleep is set
+	*/
+	virtual bool Is_Sleep_Valid( void ) const;
 	// if draw is valid for the current state and position
 	virtual bool Is_Draw_Valid( void );
+	/* if the sprite can be drawn from a static chunk in the current state
+	 * the sprite must not move nor change its image by itself
+	*/
+	virtual bool Is_Chunk_Draw_Valid( void ) const;
 
 	/* set this sprite to destroyed and completely disable it
 	 * sprite is still in the sprite manager but only to get possibly replaced
@@ -306,6 +323,8 @@ public:
 	float m_pos_x, m_pos_y, m_pos_z;
 	// start position
 	float m_start_pos_x, m_start_pos_y;
+	// position before the last fixed timestep update
+	float m_tick_pos_x, m_tick_pos_y;
 	/* editor z position
 	 * it's only used if not 0
 	*/
@@ -375,6 +394,30 @@ public:
 	// if updating is valid
 	bool m_valid_update;
 
+	// sprite manager this sprite is added to
+	cSprite_Manager *m_sprite_manager;
+	// collision grid cell range ( m_grid_x1 is -1 if not in a grid )
+	int m_grid_x1, m_grid_y1, m_grid_x2, m_grid_y2;
+	// last collision grid query this sprite was returned from
+	unsigned int m_grid_query_id;
+	// array number in the sprite manager ( -1 if not added )
+	int m_array_num;
+	// sprite manager generation set when added ( used to validate handles )
+	unsigned int m_generation;
+	/* if set the sprite manager only updates this sprite in the active region around the camera and player
+	 * or while it is woken up
+	 * should only be set if the updates do nothing outside of the player range
+	*/
+	bool m_can_sleep;
+	// if woken up it is updated until sleeping is valid again
+	bool m_woken;
+	// last sprite manager frame this sprite was added to the active items
+	unsigned int m_active_frame;
+	// static chunk number in the sprite manager ( -1 if not in a chunk )
+	int m_chunk_num;
+	// if set drawn from the static chunk
+	bool m_chunk_drawn;
+
 	// editor active window list
 	typedef vector<cEditor_Object_Settings_Item *> Editor_Object_Settings_List;
 	Editor_Object_Settings_List m_editor_windows;
@@ -20,6 +20,7 @@
 #include "../input/joystick.h"
 #include "../core/main.h"
 #include "../input/keyboard.h"
+#include "../input/replay.h"
 #include "../core/i18n.h"
 #include "../audio/audio.h"
 #include "../level/level.h"
@@ -141,7 +142,7 @@ void cText_Box :: Activate( void )
 
 	while( display )
 	{
-		while( SDL_PollEvent( &input_event ) )
+		while( pReplay->Poll_Event( &input_event ) )
 		{
 			if( input_event.type == SDL_KEYDOWN )
 			{
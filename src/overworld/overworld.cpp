@@ -153,6 +153,13 @@ void cOverworld_description :: handle_world( const CEGUI::XMLAttributes &attribu
 	visible = attributes.getValueAsBool( "visible", 1 );
 }
 
+/* *** *** *** *** *** *** *** *** cOverworld_Waypoint_Access *** *** *** *** *** *** *** *** *** */
+
+cOverworld_Waypoint_Access :: cOverworld_Waypoint_Access( void )
+{
+	m_access = 0;
+}
+
 /* *** *** *** *** *** *** *** *** cOverworld *** *** *** *** *** *** *** *** *** */
 
 cOverworld :: cOverworld( void )
@@ -171,6 +178,7 @@ cOverworld :: cOverworld( void )
 	m_hud_level_name->Set_Shadow( black, 1.5f );
 
 	m_next_level = 0;
+	m_waypoints_changed = 1;
 
 	m_player_start_waypoint = 0;
 	m_player_moving_state = STA_STAY;
@@ -291,6 +299,17 @@ bool cOverworld :: Load( void )
 		m_engine_version = 0;
 	}
 
+	// restore the access from before unloading
+	for( OverworldWaypointAccessList::iterator itr = m_stored_waypoint_access.begin(), itr_end = m_stored_waypoint_access.end(); itr != itr_end; ++itr )
+	{
+		if( !Set_Waypoint_Access( (*itr).m_destination, (*itr).m_access ) )
+		{
+			printf( "Warning : Overworld %s Waypoint %s not found\n", m_description->name.c_str(), (*itr).m_destination.c_str() );
+		}
+	}
+
+	m_stored_waypoint_access.clear();
+
 	m_hud_world_name->Set_Image( pFont->Render_Text( pFont->m_font_normal, m_description->name, yellow ), 1, 1 );
 
 	return 1;
@@ -307,8 +326,13 @@ void cOverworld :: Unload( void )
 	// set active for unloading
 	pActive_Overworld = this;
 
+	// keep the access until loaded again
+	m_stored_waypoint_access.clear();
+	Get_Waypoint_Access( m_stored_waypoint_access );
+
 	// Waypoints
 	m_waypoints.clear();
+	Set_Waypoints_Changed();
 	// Layer
 	m_layer->Delete_All();
 	// Objects
@@ -721,18 +745,17 @@ void cOverworld :: Set_Progress( unsigned int normal_level, bool force /* = 1 */
 
 cWaypoint *cOverworld :: Get_Waypoint( const std::string &name )
 {
-	for( WaypointList::iterator itr = m_waypoints.begin(), itr_end = m_waypoints.end(); itr != itr_end; ++itr )
-	{
-		cWaypoint *obj = (*itr);
+	Update_Waypoint_Index();
 
-		// accessible
-		if( obj->destination.compare( name ) == 0 )
-		{
-			return obj;
-		}
+	cWaypoint **entry = m_waypoint_names.Get( name );
+
+	// not found
+	if( !entry )
+	{
+		return NULL;
 	}
 
-	return NULL;
+	return *entry;
 }
 
 cWaypoint *cOverworld :: Get_Waypoint( unsigned int num )
@@ -760,43 +783,51 @@ int cOverworld :: Get_Level_Waypoint_Num( std::string level_name )
 
 int cOverworld :: Get_Waypoint_Num( const std::string &name )
 {
-	int count = 0;
+	Update_Waypoint_Index();
 
-	// search waypoint
-	for( WaypointList::iterator itr = m_waypoints.begin(), itr_end = m_waypoints.end(); itr != itr_end; ++itr )
-	{
-		cWaypoint *obj = (*itr);
+	cWaypoint **entry = m_waypoint_names.Get( name );
 
-		if( obj->destination.compare( name ) == 0 )
-		{
-			// found
-			return count;
-		}
-
-		count++;
+	// not found
+	if( !entry )
+	{
+		return -1;
 	}
 
-	// not found
-	return -1;
+	// found
+	return static_cast<int>(entry - &m_waypoints[0]);
 }
 
-int cOverworld :: Get_Waypoint_Collision( const GL_rect &rect_2 )
+int cOverworld :: Get_Waypoint_Collision( const GL_rect &rect_2, int exclude_num /* = -1 */ )
 {
-	int count = 0;
+	Update_Waypoint_Index();
 
-	for( WaypointList::iterator itr = m_waypoints.begin(), itr_end = m_waypoints.end(); itr != itr_end; ++itr )
+	m_waypoint_grid_nums.clear();
+	m_waypoint_grid.Get_Nums( m_waypoint_grid_nums, rect_2 );
+
+	int found_num = -1;
+
+	for( vector<unsigned int>::const_iterator itr = m_waypoint_grid_nums.begin(), itr_end = m_waypoint_grid_nums.end(); itr != itr_end; ++itr )
 	{
-		cWaypoint *obj = (*itr);
+		const int num = static_cast<int>(*itr);
 
-		if( rect_2.Intersects( obj->m_rect ) )
+		// ignored or the first waypoint is returned
+		if( num == exclude_num || ( found_num >= 0 && num >= found_num ) )
 		{
-			return count;
+			continue;
 		}
 
-		count++;
+		if( rect_2.Intersects( m_waypoints[num]->m_rect ) )
+		{
+			found_num = num;
+		}
 	}
 
-	return -1;
+	return found_num;
+}
+
+void cOverworld :: Set_Waypoints_Changed( void )
+{
+	m_waypoints_changed = 1;
 }
 
 int cOverworld :: Get_Last_Valid_Waypoint( void )
@@ -925,6 +956,70 @@ void cOverworld :: Reset_Waypoints( void )
 
 		obj->Set_Access( obj->access_default );
 	}
+
+	m_stored_waypoint_access.clear();
+}
+
+bool cOverworld :: Set_Waypoint_Access( const std::string &destination, bool access )
+{
+	// store until loaded
+	if( !Is_Loaded() )
+	{
+		for( OverworldWaypointAccessList::iterator itr = m_stored_waypoint_access.begin(), itr_end = m_stored_waypoint_access.end(); itr != itr_end; ++itr )
+		{
+			if( (*itr).m_destination.compare( destination ) == 0 )
+			{
+				(*itr).m_access = access;
+				return 1;
+			}
+		}
+
+		cOverworld_Waypoint_Access waypoint_access;
+		waypoint_access.m_destination = destination;
+		waypoint_access.m_access = access;
+		m_stored_waypoint_access.push_back( waypoint_access );
+
+		return 1;
+	}
+
+	cWaypoint *waypoint = Get_Waypoint( destination );
+
+	// not found
+	if( !waypoint )
+	{
+		return 0;
+	}
+
+	waypoint->Set_Access( access );
+
+	return 1;
+}
+
+void cOverworld :: Get_Waypoint_Access( OverworldWaypointAccessList &access_list ) const
+{
+	// stored access
+	if( !Is_Loaded() )
+	{
+		access_list.insert( access_list.end(), m_stored_waypoint_access.begin(), m_stored_waypoint_access.end() );
+		return;
+	}
+
+	for( cSprite_List::const_iterator itr = m_sprite_manager->objects.begin(), itr_end = m_sprite_manager->objects.end(); itr != itr_end; ++itr )
+	{
+		const cSprite *obj = (*itr);
+
+		if( obj->m_type != TYPE_OW_WAYPOINT )
+		{
+			continue;
+		}
+
+		const cWaypoint *waypoint = static_cast<const cWaypoint *>(obj);
+
+		cOverworld_Waypoint_Access waypoint_access;
+		waypoint_access.m_destination = waypoint->Get_Destination();
+		waypoint_access.m_access = waypoint->access;
+		access_list.push_back( waypoint_access );
+	}
 }
 
 bool cOverworld :: Is_Loaded( void ) const
@@ -938,6 +1033,31 @@ bool cOverworld :: Is_Loaded( void ) const
 	return 0;
 }
 
+void cOverworld :: Update_Waypoint_Index( void )
+{
+	if( !m_waypoints_changed )
+	{
+		return;
+	}
+
+	m_waypoints_changed = 0;
+	m_waypoint_names.Clear();
+
+	vector<GL_rect> rects;
+	rects.reserve( m_waypoints.size() );
+
+	for( WaypointList::iterator itr = m_waypoints.begin(), itr_end = m_waypoints.end(); itr != itr_end; ++itr )
+	{
+		cWaypoint *obj = (*itr);
+
+		// only the first waypoint with the name is added
+		m_waypoint_names.Add( obj->destination, &(*itr) );
+		rects.push_back( obj->m_rect );
+	}
+
+	m_waypoint_grid.Rebuild( rects );
+}
+
 // XML element start
 void cOverworld :: elementStart( const CEGUI::String &element, const CEGUI::XMLAttributes &attributes )
 {
@@ -23,6 +23,8 @@
 #include "../overworld/world_sprite_manager.h"
 #include "../gui/hud.h"
 #include "../audio/random_sound.h"
+#include "../core/hash_index.h"
+#include "../core/rect_grid.h"
 // CEGUI
 #include "CEGUIXMLHandler.h"
 #include "CEGUIXMLAttributes.h"
@@ -74,6 +76,18 @@ private:
 
 typedef vector<cWaypoint *> WaypointList;
 
+// Waypoint access by destination
+class cOverworld_Waypoint_Access
+{
+public:
+	cOverworld_Waypoint_Access( void );
+
+	std::string m_destination;
+	bool m_access;
+};
+
+typedef vector<cOverworld_Waypoint_Access> OverworldWaypointAccessList;
+
 class cOverworld : public CEGUI::XMLHandler
 {
 public:
@@ -84,9 +98,13 @@ public:
 	* if delayed is set this overworld will be entered on the next game update
 	*/
 	void Enter( bool delayed = 0 );
-	// Load
+	/* Load
+	 * the Waypoint access stored while not loaded is restored
+	*/
 	bool Load( void );
-	// Unload
+	/* Unload
+	 * the Waypoint access is stored until loaded again
+	*/
 	void Unload( void );
 	// Save
 	void Save( void );
@@ -148,9 +166,12 @@ public:
 	int Get_Waypoint_Num( const std::string &world_name );
 
 	/* Check if the rect collides with a Waypoint
+	 * exclude_num : ignore the Waypoint with this array number
 	 * if no collision found returns -1
 	*/
-	int Get_Waypoint_Collision( const GL_rect &rect_2 );
+	int Get_Waypoint_Collision( const GL_rect &rect_2, int exclude_num = -1 );
+	// Set the Waypoint name and collision index to be rebuild because a Waypoint was added, removed, renamed or moved
+	void Set_Waypoints_Changed( void );
 	// returns the last accessible Waypoint
 	int Get_Last_Valid_Waypoint( void );
 	// update the Waypoint text
@@ -161,6 +182,14 @@ public:
 	// Resets the Waypoint access to the default
 	void Reset_Waypoints( void );
 
+	/* Set the access of the Waypoint with the given destination
+	 * if not loaded it is stored and set when loaded
+	 * returns false if loaded and the Waypoint is not found
+	*/
+	bool Set_Waypoint_Access( const std::string &destination, bool access );
+	// Add the access of all Waypoints or the stored access if not loaded
+	void Get_Waypoint_Access( OverworldWaypointAccessList &access_list ) const;
+
 	// Return true if a world is loaded
 	bool Is_Loaded( void ) const;
 
@@ -200,6 +229,22 @@ public:
 	cHudSprite *m_hud_level_name;
 
 private:
+	// Rebuild the Waypoint name and collision index if changed
+	void Update_Waypoint_Index( void );
+
+	/* Waypoint array entries by destination name
+	 * the Waypoint array number is the difference to the first array entry
+	*/
+	cHash_Index<cWaypoint *> m_waypoint_names;
+	// grid of the Waypoint rects
+	cRect_Grid m_waypoint_grid;
+	// Waypoint numbers found in the grid
+	vector<unsigned int> m_waypoint_grid_nums;
+	// if set the Waypoint index needs to be rebuild
+	bool m_waypoints_changed;
+	// Waypoint access kept while not loaded
+	OverworldWaypointAccessList m_stored_waypoint_access;
+
 	// XML element start
 	virtual void elementStart( const CEGUI::String &element, const CEGUI::XMLAttributes &attributes );
 	// XML element end
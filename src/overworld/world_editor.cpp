@@ -260,6 +260,7 @@ void cEditor_World :: Function_Clear( void )
 
 	pActive_Sprite_Manager->Delete_All();
 	pActive_Overworld->m_waypoints.clear();
+	pActive_Overworld->Set_Waypoints_Changed();
 	pOverworld_Player->Reset();
 }
 
@@ -18,6 +18,7 @@
 #include "../core/game_core.h"
 #include "../overworld/overworld.h"
 #include "../core/i18n.h"
+#include <algorithm>
 // CEGUI
 #include "CEGUIXMLParser.h"
 
@@ -282,6 +283,7 @@ cNearLine_collision :: cNearLine_collision( void )
 cLayer :: cLayer( cOverworld *origin )
 {
 	n_origin = origin;
+	m_grid_changed = 1;
 }
 
 cLayer :: ~cLayer( void )
@@ -304,6 +306,7 @@ void cLayer :: Add( cLayer_Line_Point_Start *line_point )
 	}
 
 	cObject_Manager<cLayer_Line_Point_Start>::Add( line_point );
+	Set_Changed();
 
 	// check if in sprite manager
 	if( n_origin->m_sprite_manager->Get_Array_Num( line_point ) == -1 )
@@ -377,27 +380,64 @@ bool cLayer :: Save( const std::string &filename )
 	return 1;
 }
 
+bool cLayer :: Delete( size_t array_num, bool delete_data /* = 1 */ )
+{
+	Set_Changed();
+
+	return cObject_Manager<cLayer_Line_Point_Start>::Delete( array_num, delete_data );
+}
+
+bool cLayer :: Delete( cLayer_Line_Point_Start *obj, bool delete_data /* = 1 */ )
+{
+	Set_Changed();
+
+	return cObject_Manager<cLayer_Line_Point_Start>::Delete( obj, delete_data );
+}
+
 void cLayer :: Delete_All( void )
 {
 	// only clear array
 	objects.clear();
+	Set_Changed();
+}
+
+void cLayer :: Set_Changed( void )
+{
+	m_grid_changed = 1;
 }
 
 cLayer_Line_Point_Start *cLayer :: Get_Line_Collision_Start( const GL_rect &line_rect )
 {
-	for( LayerLineList::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	Update_Grid();
+
+	m_grid_nums.clear();
+	m_grid.Get_Nums( m_grid_nums, line_rect );
+
+	cLayer_Line_Point_Start *found_line = NULL;
+	unsigned int found_num = 0;
+
+	for( vector<unsigned int>::const_iterator itr = m_grid_nums.begin(), itr_end = m_grid_nums.end(); itr != itr_end; ++itr )
 	{
+		const unsigned int line_num = (*itr);
+
+		// the first line is returned
+		if( found_line && line_num >= found_num )
+		{
+			continue;
+		}
+
 		// get pointer
-		cLayer_Line_Point_Start *layer_line = (*itr);
+		cLayer_Line_Point_Start *layer_line = objects[line_num];
 
 		// check line 1
 		if( line_rect.Intersects( layer_line->m_col_rect ) )
 		{
-			return layer_line;
+			found_line = layer_line;
+			found_num = line_num;
 		}
 	}
 
-	return NULL;
+	return found_line;
 }
 
 cLine_collision cLayer :: Get_Line_Collision_Direction( float x, float y, ObjectDirection dir, float dir_size /* = 10 */, unsigned int check_size /* = 10 */ ) const
@@ -434,107 +474,225 @@ cLine_collision cLayer :: Get_Line_Collision_Direction( float x, float y, Object
 
 cLine_collision cLayer :: Get_Nearest( float x, float y, ObjectDirection dir /* = DIR_HORIZONTAL */, unsigned int check_size /* = 15 */, int only_origin_id /* = -1 */ ) const
 {
-	for( LayerLineList::const_iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	Update_Grid();
+
+	// debug drawing
+	if( pOverworld_Manager->debugmode && pOverworld_Manager->draw_layer )
 	{
+		Draw_Debug_Check( x, y, dir, check_size );
+	}
+
+	// both direction checking lines
+	GL_rect check_rect;
+
+	if( dir == DIR_HORIZONTAL )
+	{
+		check_rect = GL_rect( x - check_size, y, static_cast<float>(check_size * 2), 0 );
+	}
+	else // vertical
+	{
+		check_rect = GL_rect( x, y - check_size, 0, static_cast<float>(check_size * 2) );
+	}
+
+	m_grid_nums.clear();
+	m_grid.Get_Nums( m_grid_nums, check_rect );
+
+	cLine_collision col = cLine_collision();
+
+	for( vector<unsigned int>::const_iterator itr = m_grid_nums.begin(), itr_end = m_grid_nums.end(); itr != itr_end; ++itr )
+	{
+		const int line_num = static_cast<int>(*itr);
+
+		// already found from another cell
+		if( line_num == col.line_number )
+		{
+			continue;
+		}
+
 		// get pointer
-		cLayer_Line_Point_Start *layer_line = (*itr);
+		cLayer_Line_Point_Start *layer_line = objects[line_num];
 
 		// line is not from waypoint
-		if( only_origin_id >= 0 && only_origin_id != layer_line->origin )
+		if( only_origin_id >= 0 && only_origin_id != static_cast<int>(layer_line->origin) )
 		{
 			continue;
 		}
 
-		cLine_collision col = Get_Nearest_Line( layer_line, x, y, dir, check_size );
+		float difference;
 
-		// found
-		if( col.line )
+		// not found
+		if( !Get_Line_Difference( layer_line->Get_Line(), x, y, dir, check_size, difference ) )
 		{
-			return col;
+			continue;
 		}
+
+		// a nearer line or the same difference with a previous line is already found
+		if( col.line && ( fabs( difference ) > fabs( col.difference ) || ( fabs( difference ) == fabs( col.difference ) && line_num > col.line_number ) ) )
+		{
+			continue;
+		}
+
+		col.line = layer_line;
+		col.line_number = line_num;
+		col.difference = difference;
 	}
 
-	// none found
-	return cLine_collision();
+	return col;
 }
 
-cLine_collision cLayer :: Get_Nearest_Line( cLayer_Line_Point_Start *map_layer_line, float x, float y, ObjectDirection dir /* = DIR_HORIZONTAL */, unsigned int check_size /* = 15  */ ) const
+bool cLayer :: Get_Line_Difference( const GL_line &map_line, float x, float y, ObjectDirection dir, unsigned int check_size, float &difference ) const
 {
-	GL_line line_1, line_2;
-
-	// create map line
-	GL_line map_line = map_layer_line->Get_Line();
+	// position on the map line
+	float s;
+	// crossing position difference
+	float cross;
 
-	// check into both directions from inside
-	for( float csize = 0; csize < check_size; csize++ )
+	if( dir == DIR_HORIZONTAL )
 	{
-		line_1.m_x1 = x;
-		line_1.m_y1 = y;
-		line_1.m_x2 = x;
-		line_1.m_y2 = y;
-		line_2 = line_1;
-
-		// set line size
-		if( dir == DIR_HORIZONTAL )
+		// parallel lines never intersect
+		if( map_line.m_y1 == map_line.m_y2 )
 		{
-			line_1.m_x1 += csize;
-			line_2.m_x2 -= csize;
+			return 0;
 		}
-		else // vertical
+
+		s = ( y - map_line.m_y1 ) / ( map_line.m_y2 - map_line.m_y1 );
+		cross = map_line.m_x1 + ( s * ( map_line.m_x2 - map_line.m_x1 ) ) - x;
+	}
+	else // vertical
+	{
+		// parallel lines never intersect
+		if( map_line.m_x1 == map_line.m_x2 )
 		{
-			line_1.m_y1 += csize;
-			line_2.m_y2 -= csize;
+			return 0;
 		}
 
-		// debug drawing
-		if( pOverworld_Manager->debugmode && pOverworld_Manager->draw_layer )
+		s = ( x - map_line.m_x1 ) / ( map_line.m_x2 - map_line.m_x1 );
+		cross = map_line.m_y1 + ( s * ( map_line.m_y2 - map_line.m_y1 ) ) - y;
+	}
+
+	// the line end with the bigger y position is not included like in GL_line::Intersects
+	if( map_line.m_y1 < map_line.m_y2 )
+	{
+		if( s < 0.0f || s >= 1.0f )
 		{
-			// create request
-			cLine_Request *line_request = new cLine_Request();
-			pVideo->Draw_Line( line_1.m_x1 - pActive_Camera->x, line_1.m_y1 - pActive_Camera->y, line_1.m_x2 - pActive_Camera->x, line_1.m_y2 - pActive_Camera->y, map_layer_line->m_pos_z + 0.001f, &white, line_request );
-			line_request->line_width = 2;
-			line_request->render_count = 50;
-			// add request
-			pRenderer->Add( line_request );
-
-			// create request
-			line_request = new cLine_Request();
-			pVideo->Draw_Line( line_2.m_x1 - pActive_Camera->x, line_2.m_y1 - pActive_Camera->y, line_2.m_x2 - pActive_Camera->x, line_2.m_y2 - pActive_Camera->y, map_layer_line->m_pos_z + 0.001f, &black, line_request );
-			line_request->line_width = 2;
-			line_request->render_count = 50;
-			// add request
-			pRenderer->Add( line_request );
+			return 0;
 		}
-
-		// check direction line 1
-		if( line_1.Intersects( &map_line ) )
+	}
+	else
+	{
+		if( s <= 0.0f || s > 1.0f )
 		{
-			cLine_collision col = cLine_collision();
+			return 0;
+		}
+	}
 
-			col.line = map_layer_line;
-			col.line_number = Get_Array_Num( map_layer_line );
-			col.difference = csize;
+	/* the checking lines grow one step at a time
+	 * and the first step with a size is 1 which also finds a line at the position
+	*/
+	float csize = ceil( fabs( cross ) );
 
-			// found
-			return col;
-		}
+	if( csize < 1.0f )
+	{
+		csize = 1.0f;
+	}
+
+	if( csize >= check_size )
+	{
+		return 0;
+	}
+
+	if( cross < 0.0f )
+	{
+		difference = -csize;
+	}
+	else
+	{
+		difference = csize;
+	}
+
+	return 1;
+}
+
+void cLayer :: Draw_Debug_Check( float x, float y, ObjectDirection dir, unsigned int check_size ) const
+{
+	GL_line line_1( x, y, x, y );
+	GL_line line_2 = line_1;
+
+	// set line size
+	if( dir == DIR_HORIZONTAL )
+	{
+		line_1.m_x1 += check_size;
+		line_2.m_x2 -= check_size;
+	}
+	else // vertical
+	{
+		line_1.m_y1 += check_size;
+		line_2.m_y2 -= check_size;
+	}
+
+	// create request
+	cLine_Request *line_request = new cLine_Request();
+	pVideo->Draw_Line( line_1.m_x1 - pActive_Camera->x, line_1.m_y1 - pActive_Camera->y, line_1.m_x2 - pActive_Camera->x, line_1.m_y2 - pActive_Camera->y, 0.089f, &white, line_request );
+	line_request->line_width = 2;
+	line_request->render_count = 50;
+	// add request
+	pRenderer->Add( line_request );
 
-		// check direction line 2
-		if( line_2.Intersects( &map_line ) )
+	// create request
+	line_request = new cLine_Request();
+	pVideo->Draw_Line( line_2.m_x1 - pActive_Camera->x, line_2.m_y1 - pActive_Camera->y, line_2.m_x2 - pActive_Camera->x, line_2.m_y2 - pActive_Camera->y, 0.089f, &black, line_request );
+	line_request->line_width = 2;
+	line_request->render_count = 50;
+	// add request
+	pRenderer->Add( line_request );
+}
+
+void cLayer :: Update_Grid( void ) const
+{
+	if( !m_grid_changed )
+	{
+		return;
+	}
+
+	m_grid_changed = 0;
+
+	vector<GL_rect> rects;
+	rects.reserve( objects.size() );
+
+	for( LayerLineList::const_iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	{
+		// get pointer
+		const cLayer_Line_Point_Start *layer_line = (*itr);
+
+		// start point
+		float min_x = layer_line->m_col_rect.m_x;
+		float min_y = layer_line->m_col_rect.m_y;
+		float max_x = layer_line->m_col_rect.m_x + layer_line->m_col_rect.m_w;
+		float max_y = layer_line->m_col_rect.m_y + layer_line->m_col_rect.m_h;
+
+		// end point
+		if( layer_line->linked_point )
 		{
-			cLine_collision col = cLine_collision();
+			const GL_rect &end_rect = layer_line->linked_point->m_col_rect;
 
-			col.line = map_layer_line;
-			col.line_number = Get_Array_Num( map_layer_line );
-			col.difference = -csize;
+			min_x = std::min( min_x, end_rect.m_x );
+			min_y = std::min( min_y, end_rect.m_y );
+			max_x = std::max( max_x, end_rect.m_x + end_rect.m_w );
+			max_y = std::max( max_y, end_rect.m_y + end_rect.m_h );
 
-			// found
-			return col;
+			// line
+			const GL_line line = layer_line->Get_Line();
+
+			min_x = std::min( min_x, std::min( line.m_x1, line.m_x2 ) );
+			min_y = std::min( min_y, std::min( line.m_y1, line.m_y2 ) );
+			max_x = std::max( max_x, std::max( line.m_x1, line.m_x2 ) );
+			max_y = std::max( max_y, std::max( line.m_y1, line.m_y2 ) );
 		}
+
+		rects.push_back( GL_rect( min_x, min_y, max_x - min_x, max_y - min_y ) );
 	}
 
-	// not found
-	return cLine_collision();
+	m_grid.Rebuild( rects );
 }
 
 // XML element start
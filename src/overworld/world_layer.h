@@ -19,6 +19,7 @@
 #include "../core/globals.h"
 #include "../objects/movingsprite.h"
 #include "../core/obj_manager.h"
+#include "../core/rect_grid.h"
 #include "../overworld/world_waypoint.h"
 // CEGUI
 #include "CEGUIXMLHandler.h"
@@ -133,8 +134,10 @@ public:
 
 typedef vector<cLayer_Line_Point_Start *> LayerLineList;
 
-// Layer class
-// handles the line collision detection
+/* Layer class
+ * handles the line collision detection
+ * the lines are found with a grid of their bounds which is rebuild if a line changed
+*/
 class cLayer : public CEGUI::XMLHandler, public cObject_Manager<cLayer_Line_Point_Start>
 {
 public:
@@ -150,9 +153,16 @@ public:
 	// Save
 	bool Save( const std::string &filename );
 
+	// Delete the object from given array number
+	virtual bool Delete( size_t array_num, bool delete_data = 1 );
+	// Delete the given object
+	virtual bool Delete( cLayer_Line_Point_Start *obj, bool delete_data = 1 );
 	// Delete all objects
 	virtual void Delete_All( void );
 
+	// Set the line grid to be rebuild because a line was added, removed or moved
+	void Set_Changed( void );
+
 	/* Returns the colliding Line start point
 	 * if not found returns NULL
 	*/
@@ -165,10 +175,9 @@ public:
 	/* Return the collision data between the nearest line and the given position
 	 * check_size is maximum size for both direction checking lines
 	 * if only_origin_id is set only checks lines with the given id
+	 * if multiple lines have the same difference the first line is returned
 	*/
 	cLine_collision Get_Nearest( float x, float y, ObjectDirection dir = DIR_HORIZONTAL, unsigned int check_size = 15, int only_origin_id = -1 ) const;
-	// Return the collision data between the given line and position
-	cLine_collision Get_Nearest_Line( cLayer_Line_Point_Start *map_layer_line, float x, float y, ObjectDirection dir = DIR_HORIZONTAL, unsigned int check_size = 15 ) const;
 
 	// origin overworld
 	cOverworld *n_origin;
@@ -181,6 +190,23 @@ private:
 
 	// XML element Property list
 	CEGUI::XMLAttributes xml_attributes;
+
+	/* Set the difference from the given position to the line into the given direction
+	 * the difference is rounded up to the next full check size step
+	 * returns false if the line is not crossed within the check size
+	*/
+	bool Get_Line_Difference( const GL_line &map_line, float x, float y, ObjectDirection dir, unsigned int check_size, float &difference ) const;
+	// Draw the direction checking lines for debugging
+	void Draw_Debug_Check( float x, float y, ObjectDirection dir, unsigned int check_size ) const;
+	// Rebuild the line grid if changed
+	void Update_Grid( void ) const;
+
+	// grid of the line bounds including the line points
+	mutable cRect_Grid m_grid;
+	// if set the grid needs to be rebuild
+	mutable bool m_grid_changed;
+	// line numbers found in the grid
+	mutable vector<unsigned int> m_grid_nums;
 };
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
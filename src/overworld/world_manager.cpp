@@ -18,6 +18,7 @@
 #include "../overworld/overworld.h"
 #include "../core/filesystem/filesystem.h"
 #include "../core/filesystem/resource_manager.h"
+#include <algorithm>
 // boost filesystem
 #include "boost/filesystem/convenience.hpp"
 namespace fs = boost::filesystem;
@@ -27,6 +28,9 @@ namespace fs = boost::filesystem;
 namespace SMC
 {
 
+// maximum number of loaded overworlds
+static const unsigned int overworld_max_loaded = 3;
+
 /* *** *** *** *** *** *** *** *** cOverworld_Manager *** *** *** *** *** *** *** *** *** */
 
 cOverworld_Manager :: cOverworld_Manager( void )
@@ -88,6 +92,8 @@ void cOverworld_Manager :: Load( void )
 		Delete_All();
 	}
 
+	m_loaded_worlds.clear();
+
 	// Load Worlds
 	Load_Dir( pResource_Manager->user_data_dir + USER_WORLD_DIR, 1 );
 	Load_Dir( DATA_DIR "/" GAME_OVERWORLD_DIR );
@@ -140,7 +146,8 @@ void cOverworld_Manager :: Load_Dir( const std::string &dir, bool user_dir /* =
 
 				objects.push_back( overworld );
 
-				overworld->Load();
+				// the world is loaded when set active
+				overworld->m_description->Load();
 			}
 		}
 		catch( const std::exception &ex )
@@ -162,6 +169,25 @@ bool cOverworld_Manager :: Set_Active( cOverworld *world )
 		return 0;
 	}
 
+	// set as most recently used
+	OverworldList::iterator itr = std::find( m_loaded_worlds.begin(), m_loaded_worlds.end(), world );
+
+	if( itr != m_loaded_worlds.end() )
+	{
+		m_loaded_worlds.erase( itr );
+	}
+
+	m_loaded_worlds.insert( m_loaded_worlds.begin(), world );
+
+	// unloading sets the active overworld
+	Unload_Unused( world );
+
+	// load on first use
+	if( !world->Is_Loaded() )
+	{
+		world->Load();
+	}
+
 	pActive_Overworld = world;
 
 	// set player start waypoint
@@ -289,6 +315,29 @@ void cOverworld_Manager :: handle_world( const CEGUI::XMLAttributes &attributes
 	}
 }
 
+void cOverworld_Manager :: Unload_Unused( const cOverworld *keep_world )
+{
+	// unsaved changes would be lost
+	if( editor_world_enabled )
+	{
+		return;
+	}
+
+	while( m_loaded_worlds.size() > overworld_max_loaded )
+	{
+		cOverworld *world = m_loaded_worlds.back();
+
+		// keep
+		if( world == keep_world )
+		{
+			break;
+		}
+
+		m_loaded_worlds.pop_back();
+		world->Unload();
+	}
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 // Overworld information handler
@@ -41,16 +41,20 @@ public:
 	*/
 	bool New( const std::string &name );
 
-	// Load all overworlds
+	/* Load all overworld descriptions
+	 * an overworld is loaded when set active
+	*/
 	void Load( void );
-	/* Load overworlds from given directory
+	/* Load overworld descriptions from given directory
 	 * user_dir : if set overrides game worlds
 	*/
 	void Load_Dir( const std::string &dir, bool user_dir = 0 );
 
 	// Set Active Overworld from name or path
 	bool Set_Active( const std::string &str );
-	// Set Active Overworld
+	/* Set Active Overworld
+	 * loads it if not loaded and unloads the least recently used overworlds
+	*/
 	bool Set_Active( cOverworld *world );
 
 	// Reset to default world first Waypoint
@@ -85,6 +89,14 @@ private:
 	virtual void elementEnd( const CEGUI::String &element );
 	// handles a world
 	void handle_world( const CEGUI::XMLAttributes &attributes );
+	/* Unload the least recently used overworlds if too many are loaded
+	 * the given overworld is never unloaded
+	*/
+	void Unload_Unused( const cOverworld *keep_world );
+
+	typedef vector<cOverworld *> OverworldList;
+	// loaded overworlds from the most to the least recently used
+	OverworldList m_loaded_worlds;
 
 	// XML element Property list
 	CEGUI::XMLAttributes xml_attributes;
@@ -18,6 +18,7 @@
 #include "../core/framerate.h"
 #include "../overworld/overworld.h"
 #include "../level/level.h"
+#include "../level/level_preloader.h"
 #include "../video/font.h"
 #include "../audio/audio.h"
 #include "../gui/menu.h"
@@ -546,20 +547,12 @@ void cOverworld_Player :: Update_Walk( void )
 
 	Auto_Pos_Correction();
 
-	// check if a new waypoint is near maryo
-	for( unsigned int i = 0; i < pActive_Overworld->m_waypoints.size(); i++ )
-	{
-		// skip the start waypoint
-		if( static_cast<int>(i) == current_waypoint )
-		{
-			continue;
-		}
+	// check if a new waypoint is near maryo ( skip the start waypoint )
+	int new_waypoint = pActive_Overworld->Get_Waypoint_Collision( m_col_rect, current_waypoint );
 
-		if( pActive_Overworld->m_waypoints[i]->m_rect.Intersects( m_col_rect ) )
-		{
-			Start_Waypoint_Walk( i );
-			break;
-		}
+	if( new_waypoint >= 0 )
+	{
+		Start_Waypoint_Walk( new_waypoint );
 	}
 }
 
@@ -643,6 +636,12 @@ bool cOverworld_Player :: Set_Waypoint( int waypoint, bool new_startpos /* = 0 *
 	// Update Waypoint text
 	pActive_Overworld->Update_Waypoint_text();
 
+	// preload the level while standing on the waypoint
+	if( wp->waypoint_type == WAYPOINT_NORMAL && pLevel_Preloader )
+	{
+		pLevel_Preloader->Preload( wp->Get_Destination() );
+	}
+
 	return 1;
 }
 
@@ -50,6 +50,7 @@ void cWorld_Sprite_Manager :: Add( cSprite *sprite )
 	if( sprite->m_type == TYPE_OW_WAYPOINT )
 	{
 		n_origin->m_waypoints.push_back( static_cast<cWaypoint *>(sprite) );
+		n_origin->Set_Waypoints_Changed();
 	}
 	// Add layer line point start to the world layer
 	else if( sprite->m_type == TYPE_OW_LINE_START )
@@ -58,6 +59,20 @@ void cWorld_Sprite_Manager :: Add( cSprite *sprite )
 	}
 }
 
+void cWorld_Sprite_Manager :: Update_Grid( cSprite *sprite )
+{
+	cSprite_Manager::Update_Grid( sprite );
+
+	if( sprite->m_type == TYPE_OW_WAYPOINT )
+	{
+		n_origin->Set_Waypoints_Changed();
+	}
+	else if( sprite->m_type == TYPE_OW_LINE_START || sprite->m_type == TYPE_OW_LINE_END )
+	{
+		n_origin->m_layer->Set_Changed();
+	}
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace SMC
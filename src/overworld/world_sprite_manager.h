@@ -33,6 +33,8 @@ public:
 
 	// Add a sprite
 	virtual void Add( cSprite *sprite );
+	// Update the collision grid and set the Waypoint or line index to be rebuild if the sprite moved
+	virtual void Update_Grid( cSprite *sprite );
 
 	// origin overworld
 	cOverworld *n_origin;
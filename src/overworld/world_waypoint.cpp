@@ -360,6 +360,12 @@ void cWaypoint :: Set_Destination( std::string str )
 	}
 
 	destination = str;
+
+	// update the name index
+	if( m_sprite_manager )
+	{
+		static_cast<cWorld_Sprite_Manager *>(m_sprite_manager)->n_origin->Set_Waypoints_Changed();
+	}
 }
 
 std::string cWaypoint :: Get_Destination( bool with_dir /* = 0 */, bool with_end /* = 0 */ ) const
@@ -1038,7 +1038,7 @@ void cPlayer :: Start_Ducking( void )
 	Set_Image_Num( MARYO_IMG_DUCK + m_direction );
 
 	// fixme : should not be based on the current time
-	ducked = SDL_GetTicks();
+	ducked = pFramerate->m_game_ticks;
 	Set_Moving_State( STA_STAY );
 }
 
@@ -1058,7 +1058,7 @@ void cPlayer :: Stop_Ducking( void )
 	if( col_list->size() )
 	{
 		// set ducked time again to stop possible power jump while in air
-		ducked = SDL_GetTicks();
+		ducked = pFramerate->m_game_ticks;
 		delete col_list;
 		return;
 	}
@@ -1088,7 +1088,7 @@ void cPlayer :: Update_Ducking( void )
 		return;
 	}
 
-	if( SDL_GetTicks() - ducked > power_jump_delta )
+	if( pFramerate->m_game_ticks - ducked > power_jump_delta )
 	{
 		// particle animation
 		ducked_animation_counter += pFramerate->m_speed_factor * 2;
@@ -3559,7 +3559,7 @@ void cPlayer :: Action_Jump( bool enemy_jump /* = 0 */ )
 	if( ducked )
 	{
 		// power jump
-		if( SDL_GetTicks() - ducked > power_jump_delta )
+		if( pFramerate->m_game_ticks - ducked > power_jump_delta )
 		{
 			force_jump = 1;
 			next_jump_power += 2;
@@ -16,6 +16,7 @@
 #include "../user/preferences.h"
 #include "../audio/audio.h"
 #include "../video/video.h"
+#include "../video/img_manager.h"
 #include "../core/game_core.h"
 #include "../input/joystick.h"
 #include "../gui/hud.h"
@@ -23,6 +24,7 @@
 #include "../core/i18n.h"
 #include "../core/filesystem/resource_manager.h"
 #include "../core/filesystem/filesystem.h"
+#include "../core/framerate.h"
 // boost filesystem
 #include "boost/filesystem/convenience.hpp"
 namespace fs = boost::filesystem;
@@ -39,6 +41,7 @@ const bool cPreferences::m_always_run_default = 0;
 const std::string cPreferences::m_menu_level_default = "menu_green_1";
 const float cPreferences::m_camera_hor_speed_default = 0.3f;
 const float cPreferences::m_camera_ver_speed_default = 0.2f;
+const unsigned int cPreferences::m_fixed_timestep_rate_default = 0;
 // Video
 #ifdef _DEBUG
 const bool cPreferences::m_video_fullscreen_default = 0;
@@ -52,6 +55,8 @@ const Uint8 cPreferences::m_video_screen_bpp_default = 32;
  * which can't handle visual sync
 */
 const bool cPreferences::m_video_vsync_default = 0;
+// unlimited
+const unsigned int cPreferences::m_video_texture_budget_default = 0;
 // default geometry detail is medium
 const float cPreferences::m_geometry_quality_default = 0.5f;
 // default texture detail is high
@@ -188,12 +193,14 @@ void cPreferences :: Save( void )
 	file << "\t<Item Name=\"game_user_data_dir\" Value=\"" << m_force_user_data_dir << "\" />" << std::endl;
 	file << "\t<Item Name=\"game_camera_hor_speed\" Value=\"" << m_camera_hor_speed << "\" />" << std::endl;
 	file << "\t<Item Name=\"game_camera_ver_speed\" Value=\"" << m_camera_ver_speed << "\" />" << std::endl;
+	file << "\t<Item Name=\"game_fixed_timestep_rate\" Value=\"" << m_fixed_timestep_rate << "\" />" << std::endl;
 	// Video
 	file << "\t<Item Name=\"video_fullscreen\" Value=\"" << m_video_fullscreen << "\" />" << std::endl;
 	file << "\t<Item Name=\"video_screen_w\" Value=\"" << m_video_screen_w << "\" />" << std::endl;
 	file << "\t<Item Name=\"video_screen_h\" Value=\"" << m_video_screen_h << "\" />" << std::endl;
 	file << "\t<Item Name=\"video_screen_bpp\" Value=\"" << static_cast<int>(m_video_screen_bpp) << "\" />" << std::endl;
 	file << "\t<Item Name=\"video_vsync\" Value=\"" << m_video_vsync << "\" />" << std::endl;
+	file << "\t<Item Name=\"video_texture_budget\" Value=\"" << m_video_texture_budget << "\" />" << std::endl;
 	file << "\t<Item Name=\"video_geometry_quality\" Value=\"" << pVideo->m_geometry_quality << "\" />" << std::endl;
 	file << "\t<Item Name=\"video_texture_quality\" Value=\"" << pVideo->m_texture_quality << "\" />" << std::endl;
 	// Audio
@@ -264,6 +271,7 @@ void cPreferences :: Reset_Game( void )
 	m_menu_level = m_menu_level_default;
 	m_camera_hor_speed = m_camera_hor_speed_default;
 	m_camera_ver_speed = m_camera_ver_speed_default;
+	m_fixed_timestep_rate = m_fixed_timestep_rate_default;
 }
 
 void cPreferences :: Reset_Video( void )
@@ -273,6 +281,7 @@ void cPreferences :: Reset_Video( void )
 	m_video_screen_h = m_video_screen_h_default;
 	m_video_screen_bpp = m_video_screen_bpp_default;
 	m_video_vsync = m_video_vsync_default;
+	m_video_texture_budget = m_video_texture_budget_default;
 	m_video_fullscreen = m_video_fullscreen_default;
 	pVideo->m_geometry_quality = m_geometry_quality_default;
 	pVideo->m_texture_quality = m_texture_quality_default;
@@ -360,6 +369,8 @@ void cPreferences :: Apply( void )
 {
 	pLevel_Manager->camera->hor_offset_speed = m_camera_hor_speed;
 	pLevel_Manager->camera->ver_offset_speed = m_camera_ver_speed;
+	pFramerate->Set_Fixed_Timestep( m_fixed_timestep_rate );
+	pImage_Manager->m_texture_budget = m_video_texture_budget;
 	
 	// disable joystick if the joystick initialization failed
 	if( pVideo->m_joy_init_failed )
@@ -483,6 +494,26 @@ void cPreferences :: handle_item( const CEGUI::XMLAttributes& attributes )
 	{
 		m_camera_ver_speed = attributes.getValueAsFloat( "Value" );
 	}
+	else if( name.compare( "game_fixed_timestep_rate" ) == 0 )
+	{
+		int val = attributes.getValueAsInteger( "Value" );
+
+		// disabled
+		if( val <= 0 )
+		{
+			val = 0;
+		}
+		else if( val < 16 )
+		{
+			val = 16;
+		}
+		else if( val > 1000 )
+		{
+			val = 1000;
+		}
+
+		m_fixed_timestep_rate = val;
+	}
 	// Video
 	else if( name.compare( "video_screen_h" ) == 0 )
 	{
@@ -533,6 +564,23 @@ void cPreferences :: handle_item( const CEGUI::XMLAttributes& attributes )
 	{
 		m_video_vsync = attributes.getValueAsBool( "Value" );
 	}
+	else if( name.compare( "video_texture_budget" ) == 0 )
+	{
+		int val = attributes.getValueAsInteger( "Value" );
+
+		// unlimited
+		if( val <= 0 )
+		{
+			val = 0;
+		}
+		// at least the textures of one level
+		else if( val < 32 )
+		{
+			val = 32;
+		}
+
+		m_video_texture_budget = val;
+	}
 	else if( name.compare( "video_fullscreen" ) == 0 )
 	{
 		m_video_fullscreen = attributes.getValueAsBool( "Value" );
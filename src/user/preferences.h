@@ -71,6 +71,10 @@ public:
 	std::string m_force_user_data_dir;
 	// smart camera speed
 	float m_camera_hor_speed, m_camera_ver_speed;
+	/* fixed timestep updates per second
+	 * if 0 the game updates once per frame
+	*/
+	unsigned int m_fixed_timestep_rate;
 
 	// Audio
 	bool m_audio_music, m_audio_sound;
@@ -81,6 +85,10 @@ public:
 	Uint16 m_video_screen_w, m_video_screen_h;
 	Uint8 m_video_screen_bpp;
 	bool m_video_vsync;
+	/* image texture budget in megabytes
+	 * if 0 textures are never unloaded
+	*/
+	unsigned int m_video_texture_budget;
 
 	// Keyboard
 	// key definitions
@@ -124,6 +132,7 @@ public:
 	static const bool m_always_run_default;
 	static const std::string m_menu_level_default;
 	static const float m_camera_hor_speed_default, m_camera_ver_speed_default;
+	static const unsigned int m_fixed_timestep_rate_default;
 	// Audio
 	static const bool m_audio_music_default, m_audio_sound_default;
 	static const unsigned int m_audio_hz_default;
@@ -134,6 +143,7 @@ public:
 	static const Uint16 m_video_screen_w_default, m_video_screen_h_default;
 	static const Uint8 m_video_screen_bpp_default;
 	static const bool m_video_vsync_default;
+	static const unsigned int m_video_texture_budget_default;
 	static const float m_geometry_quality_default;
 	static const float m_texture_quality_default;
 	// Keyboard
@@ -230,18 +230,11 @@ int cSavegame :: Load_Game( unsigned int save_slot )
 				// get savegame waypoint pointer
 				cSave_Overworld_Waypoint *save_waypoint = (*wp_itr);
 
-				// get overworld waypoint
-				cWaypoint *waypoint = overworld->Get_Waypoint( overworld->Get_Waypoint_Num( save_waypoint->destination ) );
-
-				// not found
-				if( !waypoint )
+				// set access ( stored until loaded if the overworld is not loaded )
+				if( !overworld->Set_Waypoint_Access( save_waypoint->destination, save_waypoint->access ) )
 				{
 					printf( "Warning : Savegame %d : Overworld %s Waypoint %s not found\n", save_slot, save_overworld->name.c_str(), save_waypoint->destination.c_str() );
-					continue;
 				}
-
-				// set access
-				waypoint->Set_Access( save_waypoint->access );
 			}
 		}
 	}
@@ -420,27 +413,19 @@ bool cSavegame :: Save_Game( unsigned int save_slot, std::string description )
 		// name
 		save_overworld->name = overworld->m_description->name;
 		
-		// Waypoints
-		for( cSprite_List::iterator wp_itr = overworld->m_sprite_manager->objects.begin(), wp_itr_end = overworld->m_sprite_manager->objects.end(); wp_itr != wp_itr_end; ++wp_itr )
-		{
-			// get waypoint
-			cSprite *obj = static_cast<cSprite *>(*wp_itr);
-
-			if( obj->m_type != TYPE_OW_WAYPOINT )
-			{
-				continue;
-			}
-
-			// get waypoint
-			cWaypoint *waypoint = static_cast<cWaypoint *>(obj);
+		// Waypoints ( the stored access if the overworld is not loaded )
+		OverworldWaypointAccessList access_list;
+		overworld->Get_Waypoint_Access( access_list );
 
+		for( OverworldWaypointAccessList::iterator wp_itr = access_list.begin(), wp_itr_end = access_list.end(); wp_itr != wp_itr_end; ++wp_itr )
+		{
 			// create savegame waypoint
 			cSave_Overworld_Waypoint *save_waypoint = new cSave_Overworld_Waypoint();
 			
 			// destination
-			save_waypoint->destination = waypoint->Get_Destination();
+			save_waypoint->destination = (*wp_itr).m_destination;
 			// set access
-			save_waypoint->access = waypoint->access;
+			save_waypoint->access = (*wp_itr).m_access;
 			// save
 			save_overworld->m_waypoints.push_back( save_waypoint );
 		}
@@ -21,12 +21,46 @@
 #include "../core/math/utilities.h"
 #include "../core/i18n.h"
 #include "../core/filesystem/filesystem.h"
+#include <algorithm>
 // CEGUI
 #include "CEGUIXMLAttributes.h"
 
 namespace SMC
 {
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+const float deg_to_rad = static_cast<float>(M_PI / 180.0f);
+
+// Return the rotation in the range from 0 to 360
+static inline float Wrap_Rotation( float rot )
+{
+	rot = fmod( rot, 360.0f );
+
+	if( rot < 0.0f )
+	{
+		rot += 360.0f;
+	}
+
+	return rot;
+}
+
+// particle number sort by z position
+struct particle_pos_z_sort
+{
+	particle_pos_z_sort( const vector<float> &pos_z )
+	: m_pos_z( pos_z ) {};
+
+	bool operator()( unsigned int a, unsigned int b ) const
+	{
+		return m_pos_z[a] < m_pos_z[b];
+	}
+
+	const vector<float> &m_pos_z;
+};
+
 /* *** *** *** *** *** *** *** Base Animation class *** *** *** *** *** *** *** *** *** *** */
 
 cAnimation :: cAnimation( float x /* = 0.0f */, float y /* = 0.0f */ )
@@ -383,128 +417,92 @@ void cAnimation_Fireball :: Draw( cSurface_Request *request /* = NULL */ )
 	}
 }
 
-/* *** *** *** *** *** *** *** cParticle *** *** *** *** *** *** *** *** *** *** */
+/* *** *** *** *** *** *** *** cParticle_List *** *** *** *** *** *** *** *** *** *** */
 
-cParticle :: cParticle( cParticle_Emitter *parent )
-: cMovingSprite()
+cParticle_List :: cParticle_List( void )
 {
-	m_can_be_on_ground = 0;
-	// scale centered
-	Set_Scale_Directions( 1, 1, 1, 1 );
-
-	time_to_live = 0;
-	const_rotx = 0;
-	const_roty = 0;
-	const_rotz = 0;
-	gravity_x = 0;
-	gravity_y = 0;
-
-	fade_pos = 1;
-
-	m_parent = parent;
+	m_count = 0;
+	m_capacity = 0;
 }
 
-cParticle :: ~cParticle( void )
+cParticle_List :: ~cParticle_List( void )
 {
-
+	//
 }
 
-void cParticle :: Update( void )
+unsigned int cParticle_List :: Add( void )
 {
-	// update fade modifier
-	fade_pos -= ( ( static_cast<float>(speedfactor_fps) * 0.001f ) * pFramerate->m_speed_factor ) / time_to_live;
-
-	// finished fading
-	if( fade_pos <= 0.0f )
-	{
-		fade_pos = 0.0f;
-		Set_Active( 0 );
-		return;
-	}
-
-	// with size fading
-	if( m_parent->fade_size )
+	if( m_count >= m_capacity )
 	{
-		m_scale_x = m_start_scale_x * fade_pos;
-		m_scale_y = m_scale_x;
+		Reserve( m_capacity ? m_capacity * 2 : 16 );
 	}
 
-	// move
-	Move( m_velx, m_vely );
-	// add gravity velocity
-	Add_Velocity( gravity_x, gravity_y );
-
-	// constant rotation
-	if( const_rotx != 0 )
-	{
-		Add_Rotation_X( const_rotx * pFramerate->m_speed_factor );
-	}
-	if( const_roty != 0 )
-	{
-		Add_Rotation_Y( const_roty * pFramerate->m_speed_factor );
-	}
-	if( const_rotz != 0 )
-	{
-		Add_Rotation_Z( const_rotz * pFramerate->m_speed_factor );
-	}
+	return m_count++;
 }
 
-void cParticle :: Draw( cSurface_Request *request /* = NULL */ )
+void cParticle_List :: Remove( unsigned int index )
 {
-	if( !m_image )
+	if( index >= m_count )
 	{
 		return;
 	}
 
-	bool create_request = 0;
-
-	if( !request )
-	{
-		create_request = 1;
-		// create request
-		request = new cSurface_Request();
-	}
-
-	Draw_Image( request );
-
-	// blending
-	if( m_parent->blending == BLEND_ADD )
-	{
-		request->blend_sfactor = GL_SRC_ALPHA;
-		request->blend_dfactor = GL_ONE;
-	}
-	else if( m_parent->blending == BLEND_DRIVE )
-	{
-		request->blend_sfactor = GL_SRC_COLOR;
-		request->blend_dfactor = GL_DST_ALPHA;
-	}
+	m_count--;
 
-	// color fading
-	if( m_parent->fade_color )
+	// order is not important
+	if( index != m_count )
 	{
-		request->color.red = static_cast<Uint8>(m_color.red * fade_pos);
-		request->color.green = static_cast<Uint8>(m_color.green * fade_pos);
-		request->color.blue = static_cast<Uint8>(m_color.blue * fade_pos);
-		request->color.alpha = m_color.alpha;
+		m_pos_x[index] = m_pos_x[m_count];
+		m_pos_y[index] = m_pos_y[m_count];
+		m_pos_z[index] = m_pos_z[m_count];
+		m_vel_x[index] = m_vel_x[m_count];
+		m_vel_y[index] = m_vel_y[m_count];
+		m_gravity_x[index] = m_gravity_x[m_count];
+		m_gravity_y[index] = m_gravity_y[m_count];
+		m_rot_x[index] = m_rot_x[m_count];
+		m_rot_y[index] = m_rot_y[m_count];
+		m_rot_z[index] = m_rot_z[m_count];
+		m_const_rot_x[index] = m_const_rot_x[m_count];
+		m_const_rot_y[index] = m_const_rot_y[m_count];
+		m_const_rot_z[index] = m_const_rot_z[m_count];
+		m_scale[index] = m_scale[m_count];
+		m_fade_pos[index] = m_fade_pos[m_count];
+		m_fade_speed[index] = m_fade_speed[m_count];
+		m_color[index] = m_color[m_count];
 	}
+}
 
-	// alpha fading
-	if( m_parent->fade_alpha )
-	{
-		request->color.alpha = static_cast<Uint8>(request->color.alpha * fade_pos);
-	}
+void cParticle_List :: Clear( void )
+{
+	m_count = 0;
+}
 
-	if( create_request )
+void cParticle_List :: Reserve( unsigned int capacity )
+{
+	if( capacity <= m_capacity )
 	{
-		// add request
-		pRenderer->Add( request );
+		return;
 	}
-}
 
-void cParticle :: Set_Gravity( float x, float y )
-{
-	gravity_x = x;
-	gravity_y = y;
+	m_capacity = capacity;
+
+	m_pos_x.resize( m_capacity );
+	m_pos_y.resize( m_capacity );
+	m_pos_z.resize( m_capacity );
+	m_vel_x.resize( m_capacity );
+	m_vel_y.resize( m_capacity );
+	m_gravity_x.resize( m_capacity );
+	m_gravity_y.resize( m_capacity );
+	m_rot_x.resize( m_capacity );
+	m_rot_y.resize( m_capacity );
+	m_rot_z.resize( m_capacity );
+	m_const_rot_x.resize( m_capacity );
+	m_const_rot_y.resize( m_capacity );
+	m_const_rot_z.resize( m_capacity );
+	m_scale.resize( m_capacity );
+	m_fade_pos.resize( m_capacity );
+	m_fade_speed.resize( m_capacity );
+	m_color.resize( m_capacity );
 }
 
 /* *** *** *** *** *** *** *** cParticle_Emitter *** *** *** *** *** *** *** *** *** *** */
@@ -719,9 +717,11 @@ void cParticle_Emitter :: Emit( void )
 		return;
 	}
 
+	m_particles.Reserve( Get_Particle_Capacity() );
+
 	for( unsigned int i = 0; i < emitter_quota; i++ )
 	{
-		cParticle *particle = new cParticle( this );
+		const unsigned int num = m_particles.Add();
 
 		// X Position
 		float x = m_pos_x - ( m_image->m_w * 0.5f );
@@ -736,16 +736,14 @@ void cParticle_Emitter :: Emit( void )
 			y += Get_Random_Float( 0.0f, m_rect.m_h );
 		}
 		// Set Position
-		particle->Set_Pos( x, y, 1 );
-
-		// Image
-		particle->Set_Image( m_image, 1, 0 );
+		m_particles.m_pos_x[num] = x;
+		m_particles.m_pos_y[num] = y;
 
 		// Z position
-		particle->m_pos_z = m_pos_z;
+		m_particles.m_pos_z[num] = m_pos_z;
 		if( posz_rand > 0.0f )
 		{
-			particle->m_pos_z += Get_Random_Float( 0.0f, posz_rand );
+			m_particles.m_pos_z[num] += Get_Random_Float( 0.0f, posz_rand );
 		}
 
 		// angle range
@@ -763,34 +761,35 @@ void cParticle_Emitter :: Emit( void )
 			speed += Get_Random_Float( 0.0f, vel_rand );
 		}
 		// set Velocity
-		particle->Set_Direction( dir_angle, speed, 1 );
+		m_particles.m_vel_x[num] = cos( dir_angle * deg_to_rad ) * speed;
+		m_particles.m_vel_y[num] = sin( dir_angle * deg_to_rad ) * speed;
 
 		// Start rotation
-		particle->m_rot_x = m_start_rot_x;
-		particle->m_rot_y = m_start_rot_y;
-		particle->m_rot_z = m_start_rot_z;
+		m_particles.m_rot_x[num] = m_start_rot_x;
+		m_particles.m_rot_y[num] = m_start_rot_y;
+		m_particles.m_rot_z[num] = m_start_rot_z;
 
 		// rotation z uses start direction
 		if( start_rot_z_uses_direction )
 		{
-			particle->m_rot_z += dir_angle;
+			m_particles.m_rot_z[num] = Wrap_Rotation( m_particles.m_rot_z[num] + dir_angle );
 		}
 
 		// Constant rotation
-		particle->const_rotx = const_rotx;
-		particle->const_roty = const_roty;
-		particle->const_rotz = const_rotz;
+		m_particles.m_const_rot_x[num] = const_rotx;
+		m_particles.m_const_rot_y[num] = const_roty;
+		m_particles.m_const_rot_z[num] = const_rotz;
 		if( const_rotx_rand > 0.0f )
 		{
-			particle->const_rotx += Get_Random_Float( 0.0f, const_rotx_rand );
+			m_particles.m_const_rot_x[num] += Get_Random_Float( 0.0f, const_rotx_rand );
 		}
 		if( const_roty_rand > 0.0f )
 		{
-			particle->const_roty += Get_Random_Float( 0.0f, const_roty_rand );
+			m_particles.m_const_rot_y[num] += Get_Random_Float( 0.0f, const_roty_rand );
 		}
 		if( const_rotz_rand > 0.0f )
 		{
-			particle->const_rotz += Get_Random_Float( 0.0f, const_rotz_rand );
+			m_particles.m_const_rot_z[num] += Get_Random_Float( 0.0f, const_rotz_rand );
 		}
 
 		// Scale
@@ -799,61 +798,56 @@ void cParticle_Emitter :: Emit( void )
 		{
 			scale += Get_Random_Float( 0.0f, size_scale_rand );
 		}
-		particle->Set_Scale( scale, 1 );
+		m_particles.m_scale[num] = scale;
 
 		// Gravity
-		float grav_x = gravity_x;
+		m_particles.m_gravity_x[num] = gravity_x;
 		if( gravity_x_rand > 0.0f )
 		{
-			grav_x += Get_Random_Float( 0.0f, gravity_x_rand );
+			m_particles.m_gravity_x[num] += Get_Random_Float( 0.0f, gravity_x_rand );
 		}
-		float grav_y = gravity_y;
+		m_particles.m_gravity_y[num] = gravity_y;
 		if( gravity_y_rand > 0.0f )
 		{
-			grav_y += Get_Random_Float( 0.0f, gravity_y_rand );
+			m_particles.m_gravity_y[num] += Get_Random_Float( 0.0f, gravity_y_rand );
 		}
-		// set Gravity
-		particle->Set_Gravity( grav_x, grav_y );
 
 		// Color
-		particle->Set_Color( m_color );
+		Color &color = m_particles.m_color[num];
+		color = m_color;
 		if( color_rand.red > 0 )
 		{
-			particle->m_color.red += rand() % color_rand.red;
+			color.red += rand() % color_rand.red;
 		}
 		if( color_rand.green > 0 )
 		{
-			particle->m_color.green += rand() % color_rand.green;
+			color.green += rand() % color_rand.green;
 		}
 		if( color_rand.blue > 0 )
 		{
-			particle->m_color.blue += rand() % color_rand.blue;
+			color.blue += rand() % color_rand.blue;
 		}
 		if( color_rand.alpha > 0 )
 		{
-			particle->m_color.alpha += rand() % color_rand.alpha;
+			color.alpha += rand() % color_rand.alpha;
 		}
 
 		// Time to life
-		particle->time_to_live = time_to_live;
+		float particle_time_to_live = time_to_live;
 		if( time_to_live_rand > 0.0f )
 		{
-			particle->time_to_live += Get_Random_Float( 0.0f, time_to_live_rand );
+			particle_time_to_live += Get_Random_Float( 0.0f, time_to_live_rand );
 		}
 
-		objects.push_back( particle );
+		m_particles.m_fade_pos[num] = 1.0f;
+		m_particles.m_fade_speed[num] = 1.0f / particle_time_to_live;
 	}
 }
 
 void cParticle_Emitter :: Clear( void )
 {
 	// clear particles
-	for( ParticleList::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
-	{
-		delete *itr;
-	}
-
-	objects.clear();
+	m_particles.Clear();
 
 	// clear animation data
 	emit_counter = 0;
@@ -872,26 +866,7 @@ void cParticle_Emitter :: Update( void )
 	emitter_living_time += pFramerate->m_speed_factor * ( static_cast<float>(speedfactor_fps) * 0.001f );
 
 	// update objects
-	for( ParticleList::iterator itr = objects.begin(); itr != objects.end(); )
-	{
-		// get object pointer
-		cParticle *obj = (*itr);
-
-		// update
-		obj->Update();
-
-		// if finished
-		if( !obj->m_active )
-		{
-			itr = objects.erase( itr );
-			delete obj;
-		}
-		// increment
-		else
-		{
-			++itr;
-		}
-	}
+	Update_Particle_Data();
 
 	// if able to emit or endless emitter
 	if( emitter_living_time < emitter_time_to_live || Is_Float_Equal( emitter_time_to_live, -1.0f ) )
@@ -906,12 +881,147 @@ void cParticle_Emitter :: Update( void )
 		emit_counter += pFramerate->m_speed_factor * ( static_cast<float>(speedfactor_fps) * 0.001f );
 	}
 	// no particles are active
-	else if( objects.empty() )
+	else if( !m_particles.m_count )
 	{
 		Set_Active( 0 );
 	}
 }
 
+void cParticle_Emitter :: Update_Particle_Data( void )
+{
+	const unsigned int count = m_particles.m_count;
+
+	if( !count )
+	{
+		return;
+	}
+
+	const float speed_factor = pFramerate->m_speed_factor;
+	const float fade_step = ( static_cast<float>(speedfactor_fps) * 0.001f ) * speed_factor;
+
+	// separate loops over plain arrays without branches can be vectorized by the compiler
+	float *pos_x = &m_particles.m_pos_x[0];
+	float *pos_y = &m_particles.m_pos_y[0];
+	float *vel_x = &m_particles.m_vel_x[0];
+	float *vel_y = &m_particles.m_vel_y[0];
+	const float *gravity_x = &m_particles.m_gravity_x[0];
+	const float *gravity_y = &m_particles.m_gravity_y[0];
+	float *fade_pos = &m_particles.m_fade_pos[0];
+	const float *fade_speed = &m_particles.m_fade_speed[0];
+
+	// fading
+	for( unsigned int i = 0; i < count; i++ )
+	{
+		fade_pos[i] -= fade_step * fade_speed[i];
+	}
+
+	// move
+	for( unsigned int i = 0; i < count; i++ )
+	{
+		pos_x[i] += vel_x[i] * speed_factor;
+		pos_y[i] += vel_y[i] * speed_factor;
+	}
+
+	// add gravity velocity
+	for( unsigned int i = 0; i < count; i++ )
+	{
+		vel_x[i] += gravity_x[i] * speed_factor;
+		vel_y[i] += gravity_y[i] * speed_factor;
+	}
+
+	// constant rotation
+	if( const_rotx != 0.0f || const_rotx_rand > 0.0f )
+	{
+		float *rot = &m_particles.m_rot_x[0];
+		const float *const_rot = &m_particles.m_const_rot_x[0];
+
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			rot[i] = Wrap_Rotation( rot[i] + ( const_rot[i] * speed_factor ) );
+		}
+	}
+	if( const_roty != 0.0f || const_roty_rand > 0.0f )
+	{
+		float *rot = &m_particles.m_rot_y[0];
+		const float *const_rot = &m_particles.m_const_rot_y[0];
+
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			rot[i] = Wrap_Rotation( rot[i] + ( const_rot[i] * speed_factor ) );
+		}
+	}
+	if( const_rotz != 0.0f || const_rotz_rand > 0.0f )
+	{
+		float *rot = &m_particles.m_rot_z[0];
+		const float *const_rot = &m_particles.m_const_rot_z[0];
+
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			rot[i] = Wrap_Rotation( rot[i] + ( const_rot[i] * speed_factor ) );
+		}
+	}
+
+	// remove finished particles
+	for( unsigned int i = 0; i < m_particles.m_count; )
+	{
+		if( m_particles.m_fade_pos[i] <= 0.0f )
+		{
+			m_particles.Remove( i );
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+unsigned int cParticle_Emitter :: Get_Particle_Capacity( void ) const
+{
+	// single emit
+	if( emitter_time_to_live <= 0.0f && !Is_Float_Equal( emitter_time_to_live, -1.0f ) )
+	{
+		return emitter_quota;
+	}
+
+	// emits while the first particles are still alive
+	float iterations = 1.0f;
+
+	if( emitter_iteration_interval > 0.0f )
+	{
+		iterations += ceil( ( time_to_live + time_to_live_rand ) / emitter_iteration_interval );
+	}
+
+	// limit the preallocation
+	return emitter_quota * static_cast<unsigned int>(std::min( iterations, 1000.0f ));
+}
+
+cSurface_List_Request *cParticle_Emitter :: Create_Particle_Request( void ) const
+{
+	cSurface_List_Request *list_request = new cSurface_List_Request();
+
+	list_request->texture_id = m_image->m_image;
+	list_request->tex_x1 = m_image->m_tex_x1;
+	list_request->tex_y1 = m_image->m_tex_y1;
+	list_request->tex_x2 = m_image->m_tex_x2;
+	list_request->tex_y2 = m_image->m_tex_y2;
+	list_request->w = m_image->m_start_w;
+	list_request->h = m_image->m_start_h;
+
+	// blending
+	if( blending == BLEND_ADD )
+	{
+		list_request->blend_sfactor = GL_SRC_ALPHA;
+		list_request->blend_dfactor = GL_ONE;
+	}
+	else if( blending == BLEND_DRIVE )
+	{
+		list_request->blend_sfactor = GL_SRC_COLOR;
+		list_request->blend_dfactor = GL_DST_ALPHA;
+	}
+
+	return list_request;
+}
+
 void cParticle_Emitter :: Draw( cSurface_Request *request /* = NULL */ )
 {
 	if( !m_valid_draw )
@@ -921,11 +1031,88 @@ void cParticle_Emitter :: Draw( cSurface_Request *request /* = NULL */ )
 
 	if( !editor_enabled )
 	{
-		for( ParticleList::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+		if( !m_image || !m_particles.m_count )
+		{
+			return;
+		}
+
+		m_image->Use_Texture();
+
+		// particles sorted by z position
+		m_draw_order.resize( m_particles.m_count );
+
+		for( unsigned int i = 0; i < m_particles.m_count; i++ )
+		{
+			m_draw_order[i] = i;
+		}
+
+		std::stable_sort( m_draw_order.begin(), m_draw_order.end(), particle_pos_z_sort( m_particles.m_pos_z ) );
+
+		// a request for each z position to keep the depth order with other requests
+		cSurface_List_Request *list_request = NULL;
+
+		for( vector<unsigned int>::const_iterator itr = m_draw_order.begin(), itr_end = m_draw_order.end(); itr != itr_end; ++itr )
 		{
-			(*itr)->Draw();
+			const unsigned int i = (*itr);
+
+			if( !list_request || list_request->pos_z != m_particles.m_pos_z[i] )
+			{
+				if( list_request )
+				{
+					pRenderer->Add( list_request );
+				}
+
+				list_request = Create_Particle_Request();
+				list_request->pos_z = m_particles.m_pos_z[i];
+			}
+
+			list_request->items.push_back( cSurface_List_Request::cItem() );
+			cSurface_List_Request::cItem &item = list_request->items.back();
+			const float fade_pos = m_particles.m_fade_pos[i];
+
+			// scale
+			float scale = m_particles.m_scale[i];
+
+			// with size fading
+			if( fade_size )
+			{
+				scale *= fade_pos;
+			}
+
+			// position scaled from the center
+			item.pos_x = m_particles.m_pos_x[i] + ( m_image->m_int_x * scale ) - ( ( m_image->m_w * 0.5f ) * ( scale - 1.0f ) );
+			item.pos_y = m_particles.m_pos_y[i] + ( m_image->m_int_y * scale ) - ( ( m_image->m_h * 0.5f ) * ( scale - 1.0f ) );
+			item.pos_z = m_particles.m_pos_z[i];
+			item.scale_x = scale;
+			item.scale_y = scale;
+
+			// rotation
+			item.rotx = m_particles.m_rot_x[i] + m_image->m_base_rot_x;
+			item.roty = m_particles.m_rot_y[i] + m_image->m_base_rot_y;
+			item.rotz = m_particles.m_rot_z[i] + m_image->m_base_rot_z;
+
+			// color
+			const Color &color = m_particles.m_color[i];
+			item.color = color;
+
+			// color fading
+			if( fade_color )
+			{
+				item.color.red = static_cast<Uint8>(color.red * fade_pos);
+				item.color.green = static_cast<Uint8>(color.green * fade_pos);
+				item.color.blue = static_cast<Uint8>(color.blue * fade_pos);
+			}
+
+			// alpha fading
+			if( fade_alpha )
+			{
+				item.color.alpha = static_cast<Uint8>(item.color.alpha * fade_pos);
+			}
 		}
+
+		pRenderer->Add( list_request );
 	}
+
 	else
 	{
 		if( !m_spawned )
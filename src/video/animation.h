@@ -131,37 +131,50 @@ public:
 	FireAnimList objects;
 };
 
-/* *** *** *** *** *** *** *** Particle Emitter item *** *** *** *** *** *** *** *** *** *** */
+/* *** *** *** *** *** *** *** Particle list *** *** *** *** *** *** *** *** *** *** */
 
-// pre declare
-class cParticle_Emitter;
-
-// Particle Item
-class cParticle : public cMovingSprite
+/* Particle data with an array for each value
+ * A removed particle is replaced with the last particle.
+ * The capacity only grows and is kept if cleared.
+*/
+class cParticle_List
 {
 public:
-	cParticle( cParticle_Emitter *parent );
-	virtual ~cParticle( void );
-
-	// update
-	virtual void Update( void );
-	// draw
-	virtual void Draw( cSurface_Request *request = NULL );
-
-	// set gravity
-	void Set_Gravity( float x, float y );
-
-	// parent particle emitter
-	cParticle_Emitter *m_parent;
-	// time to live
-	float time_to_live;
+	cParticle_List( void );
+	~cParticle_List( void );
+
+	// Add a particle and return its index
+	unsigned int Add( void );
+	// Remove the particle by moving the last particle to its index
+	void Remove( unsigned int index );
+	// Remove all particles
+	void Clear( void );
+	// Grow the arrays to the given capacity
+	void Reserve( unsigned int capacity );
+
+	// particle count
+	unsigned int m_count;
+	// allocated particles
+	unsigned int m_capacity;
+
+	// position
+	vector<float> m_pos_x, m_pos_y, m_pos_z;
+	// velocity
+	vector<float> m_vel_x, m_vel_y;
+	// gravity
+	vector<float> m_gravity_x, m_gravity_y;
+	// rotation
+	vector<float> m_rot_x, m_rot_y, m_rot_z;
 	// constant rotation
-	float const_rotx, const_roty, const_rotz;
-	// particle gravity
-	float gravity_x, gravity_y;
-
-	// fading position value
-	float fade_pos;
+	vector<float> m_const_rot_x, m_const_rot_y, m_const_rot_z;
+	// start scale
+	vector<float> m_scale;
+	// fading position value from 1 to 0
+	vector<float> m_fade_pos;
+	// fading speed ( 1 / time to live )
+	vector<float> m_fade_speed;
+	// color
+	vector<Color> m_color;
 };
 
 /* *** *** *** *** *** *** *** Particle Emitter *** *** *** *** *** *** *** *** *** *** */
@@ -311,8 +324,7 @@ public:
 	// todo : start rotation x/y/z rand, color, color_rand
 
 	// Particle items
-	typedef vector<cParticle *> ParticleList;
-	ParticleList objects;
+	cParticle_List m_particles;
 
 	// filename of the particle
 	std::string filename;
@@ -346,6 +358,16 @@ public:
 	BlendingMode blending;
 
 private:
+	// Update the particles and remove the finished ones
+	void Update_Particle_Data( void );
+	// Return the expected maximum particle count
+	unsigned int Get_Particle_Capacity( void ) const;
+	// Return a particle list request with the image and blending settings
+	cSurface_List_Request *Create_Particle_Request( void ) const;
+
+	// particle numbers sorted by z position for drawing
+	vector<unsigned int> m_draw_order;
+
 	// time alive
 	float emitter_living_time;
 	// emit counter
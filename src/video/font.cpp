@@ -15,17 +15,150 @@
  
 #include "../video/font.h"
 #include "../video/gl_surface.h"
+#include "../video/video.h"
+#include "../video/renderer.h"
 
 namespace SMC
 {
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
+/* Decode the UTF-8 character at the position and move the position to the next character
+ * characters outside of the basic multilingual plane are returned as '?'
+*/
+static Uint16 Decode_UTF8( const std::string &text, std::string::size_type &pos )
+{
+	const unsigned char c = static_cast<unsigned char>(text[pos]);
+	pos++;
+
+	// ASCII or invalid start byte
+	if( c < 0xC0 )
+	{
+		return c;
+	}
+
+	Uint16 ch;
+	unsigned int count;
+
+	if( ( c & 0xE0 ) == 0xC0 )
+	{
+		ch = c & 0x1F;
+		count = 1;
+	}
+	else if( ( c & 0xF0 ) == 0xE0 )
+	{
+		ch = c & 0x0F;
+		count = 2;
+	}
+	else
+	{
+		ch = '?';
+		count = 0;
+	}
+
+	// continuation bytes
+	while( pos < text.length() && ( static_cast<unsigned char>(text[pos]) & 0xC0 ) == 0x80 )
+	{
+		if( count > 0 )
+		{
+			ch = ( ch << 6 ) | ( static_cast<unsigned char>(text[pos]) & 0x3F );
+			count--;
+		}
+
+		pos++;
+	}
+
+	return ch;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
 void Font_Delete_Ref( cGL_Surface *surface )
 {
 	pFont->Delete_Ref( surface );
 }
 
+/* *** *** *** *** *** *** *** cGlyph *** *** *** *** *** *** *** *** *** *** */
+
+cGlyph :: cGlyph( void )
+{
+	m_char = 0;
+	m_image = NULL;
+	m_offset_x = 0;
+	m_offset_y = 0;
+	m_advance = 0;
+}
+
+cGlyph :: ~cGlyph( void )
+{
+	// the atlas texture is deleted by the font manager
+	if( m_image )
+	{
+		delete m_image;
+		m_image = NULL;
+	}
+}
+
+/* *** *** *** *** *** *** *** cText_Layout *** *** *** *** *** *** *** *** *** *** */
+
+cText_Layout :: cText_Layout( void )
+{
+	m_font = NULL;
+	m_width = 0;
+	m_height = 0;
+}
+
+cText_Layout :: ~cText_Layout( void )
+{
+	//
+}
+
+void cText_Layout :: Clear( void )
+{
+	m_items.clear();
+	m_font = NULL;
+	m_text.clear();
+	m_width = 0;
+	m_height = 0;
+}
+
+bool cText_Layout :: Is_Empty( void ) const
+{
+	return m_text.empty();
+}
+
+void cText_Layout :: Draw( float x, float y, float z, const Color &color, float shadow_pos /* = 0.0f */, const Color &shadow_color /* = static_cast<Uint8>(0) */, bool no_camera /* = 1 */ ) const
+{
+	for( ItemList::const_iterator itr = m_items.begin(), itr_end = m_items.end(); itr != itr_end; ++itr )
+	{
+		const cItem &item = (*itr);
+
+		// glyph image could not be restored
+		if( !item.glyph->m_image )
+		{
+			continue;
+		}
+
+		// create request
+		cSurface_Request *request = new cSurface_Request();
+		item.glyph->m_image->Blit( x + item.x, y + item.y, z, request );
+
+		request->no_camera = no_camera;
+		// color
+		request->color = color;
+
+		// shadow
+		if( shadow_pos )
+		{
+			request->shadow_pos = shadow_pos;
+			request->shadow_color = shadow_color;
+		}
+
+		// add request
+		pRenderer->Add( request );
+	}
+}
+
 /* *** *** *** *** *** *** *** Font Manager class *** *** *** *** *** *** *** *** *** *** */
 
 cFont_Manager :: cFont_Manager( void )
@@ -43,6 +176,8 @@ cFont_Manager :: ~cFont_Manager( void )
 		return;
 	}
 
+	Delete_Glyphs();
+
 	if( m_font_normal )
 	{
 		TTF_CloseFont( m_font_normal );
@@ -139,6 +274,90 @@ cGL_Surface *cFont_Manager :: Render_Text( TTF_Font *font, const std::string &te
 	return surface;
 }
 
+void cFont_Manager :: Layout_Text( cText_Layout &layout, TTF_Font *font, const std::string &text )
+{
+	// already laid out
+	if( font && layout.m_font == font && layout.m_text == text )
+	{
+		return;
+	}
+
+	layout.Clear();
+
+	if( !font || text.empty() )
+	{
+		return;
+	}
+
+	layout.m_font = font;
+	layout.m_text = text;
+	layout.m_height = TTF_FontHeight( font );
+
+	int pen_x = 0;
+	std::string::size_type pos = 0;
+
+	while( pos < text.length() )
+	{
+		const cGlyph *glyph = Get_Glyph( font, Decode_UTF8( text, pos ) );
+
+		// spaces have no image
+		if( glyph->m_image )
+		{
+			cText_Layout::cItem item;
+			item.glyph = glyph;
+			item.x = pen_x + glyph->m_offset_x;
+			item.y = glyph->m_offset_y;
+
+			layout.m_items.push_back( item );
+		}
+
+		pen_x += glyph->m_advance;
+	}
+
+	layout.m_width = pen_x;
+}
+
+const cGlyph *cFont_Manager :: Get_Glyph( TTF_Font *font, Uint16 ch )
+{
+	cFont_Glyphs *font_glyphs = NULL;
+
+	for( FontGlyphsList::iterator itr = m_font_glyphs.begin(), itr_end = m_font_glyphs.end(); itr != itr_end; ++itr )
+	{
+		if( (*itr).font == font )
+		{
+			font_glyphs = &(*itr);
+			break;
+		}
+	}
+
+	// first glyph of this font
+	if( !font_glyphs )
+	{
+		cFont_Glyphs new_font_glyphs;
+		new_font_glyphs.font = font;
+		m_font_glyphs.push_back( new_font_glyphs );
+		font_glyphs = &m_font_glyphs.back();
+	}
+
+	GlyphList &glyphs = font_glyphs->glyphs;
+
+	if( ch >= glyphs.size() )
+	{
+		glyphs.resize( ch + 1, NULL );
+	}
+
+	// rasterize on first use
+	if( !glyphs[ch] )
+	{
+		cGlyph *glyph = new cGlyph();
+		glyph->m_char = ch;
+		Rasterize_Glyph( font, glyph );
+		glyphs[ch] = glyph;
+	}
+
+	return glyphs[ch];
+}
+
 void cFont_Manager :: Grab_Textures( void )
 {
 	// save to software memory
@@ -155,6 +374,9 @@ void cFont_Manager :: Grab_Textures( void )
 		}
 		obj->m_image = 0;
 	}
+
+	// glyphs are rasterized again when restored
+	m_glyph_atlas.Clear();
 }
 
 void cFont_Manager :: Restore_Textures( void )
@@ -175,6 +397,96 @@ void cFont_Manager :: Restore_Textures( void )
 	}
 
 	m_software_textures.clear();
+
+	// rasterize the glyphs again into the same images
+	for( FontGlyphsList::iterator itr = m_font_glyphs.begin(), itr_end = m_font_glyphs.end(); itr != itr_end; ++itr )
+	{
+		cFont_Glyphs &font_glyphs = (*itr);
+
+		for( GlyphList::iterator glyph_itr = font_glyphs.glyphs.begin(), glyph_itr_end = font_glyphs.glyphs.end(); glyph_itr != glyph_itr_end; ++glyph_itr )
+		{
+			if( *glyph_itr )
+			{
+				Rasterize_Glyph( font_glyphs.font, *glyph_itr );
+			}
+		}
+	}
+}
+
+void cFont_Manager :: Rasterize_Glyph( TTF_Font *font, cGlyph *glyph )
+{
+	int minx, maxx, miny, maxy, advance;
+
+	// not available in the font
+	if( TTF_GlyphMetrics( font, glyph->m_char, &minx, &maxx, &miny, &maxy, &advance ) != 0 )
+	{
+		return;
+	}
+
+	glyph->m_offset_x = minx;
+	glyph->m_offset_y = TTF_FontAscent( font ) - maxy;
+	glyph->m_advance = advance;
+
+	// no OpenGL context or no pixels
+	if( pVideo->m_headless || maxx <= minx || maxy <= miny )
+	{
+		return;
+	}
+
+	SDL_Surface *surface = TTF_RenderGlyph_Blended( font, glyph->m_char, white.Get_SDL_Color() );
+
+	if( !surface )
+	{
+		return;
+	}
+
+	const unsigned int width = surface->w;
+	const unsigned int height = surface->h;
+
+	// line height images are already aligned to the top of the line
+	if( static_cast<int>(height) == TTF_FontHeight( font ) )
+	{
+		glyph->m_offset_y = 0;
+	}
+
+	surface = pVideo->Convert_To_Final_Software_Image( surface );
+
+	if( !glyph->m_image )
+	{
+		glyph->m_image = new cGL_Surface();
+		glyph->m_image->m_tex_w = width;
+		glyph->m_image->m_tex_h = height;
+		glyph->m_image->m_start_w = static_cast<float>(width);
+		glyph->m_image->m_start_h = static_cast<float>(height);
+		glyph->m_image->m_w = glyph->m_image->m_start_w;
+		glyph->m_image->m_h = glyph->m_image->m_start_h;
+		glyph->m_image->m_col_w = glyph->m_image->m_w;
+		glyph->m_image->m_col_h = glyph->m_image->m_h;
+	}
+
+	if( !m_glyph_atlas.Add( glyph->m_image, surface->pixels, width, height, surface->pitch / surface->format->BytesPerPixel ) )
+	{
+		printf( "Warning : Could not add glyph %d to the atlas\n", glyph->m_char );
+		delete glyph->m_image;
+		glyph->m_image = NULL;
+	}
+
+	SDL_FreeSurface( surface );
+}
+
+void cFont_Manager :: Delete_Glyphs( void )
+{
+	for( FontGlyphsList::iterator itr = m_font_glyphs.begin(), itr_end = m_font_glyphs.end(); itr != itr_end; ++itr )
+	{
+		GlyphList &glyphs = (*itr).glyphs;
+
+		for( GlyphList::iterator glyph_itr = glyphs.begin(), glyph_itr_end = glyphs.end(); glyph_itr != glyph_itr_end; ++glyph_itr )
+		{
+			delete *glyph_itr;
+		}
+	}
+
+	m_font_glyphs.clear();
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
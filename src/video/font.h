@@ -18,6 +18,7 @@
 
 #include "../core/globals.h"
 #include "../video/img_manager.h"
+#include "../video/texture_atlas.h"
 // SDL
 // also includes SDL.h
 #include "SDL_ttf.h"
@@ -25,6 +26,66 @@
 namespace SMC
 {
 
+/* *** *** *** *** *** *** *** cGlyph *** *** *** *** *** *** *** *** *** *** */
+
+// A rasterized font character in the glyph atlas
+class cGlyph
+{
+public:
+	cGlyph( void );
+	~cGlyph( void );
+
+	// unicode character
+	Uint16 m_char;
+	// atlas image or NULL if the character has no pixels
+	cGL_Surface *m_image;
+	// image position relative to the pen position on the top of the line
+	int m_offset_x, m_offset_y;
+	// pen movement to the next character
+	int m_advance;
+};
+
+/* *** *** *** *** *** *** *** cText_Layout *** *** *** *** *** *** *** *** *** *** */
+
+/* A string laid out as glyph positions
+ * Keep it to draw the same text every frame without rendering it again.
+ * Drawing adds a request per glyph which are batched by the renderer
+ * because all glyphs are in the same atlas texture.
+*/
+class cText_Layout
+{
+public:
+	cText_Layout( void );
+	~cText_Layout( void );
+
+	// Remove the text
+	void Clear( void );
+	// Check if no text is set
+	bool Is_Empty( void ) const;
+
+	/* Draw the text with the top left position
+	 * color : modulates the white glyphs
+	 * shadow_pos : if set draws a shadow with the shadow color
+	*/
+	void Draw( float x, float y, float z, const Color &color, float shadow_pos = 0.0f, const Color &shadow_color = static_cast<Uint8>(0), bool no_camera = 1 ) const;
+
+	// positioned glyph
+	struct cItem
+	{
+		const cGlyph *glyph;
+		int x, y;
+	};
+
+	typedef vector<cItem> ItemList;
+	ItemList m_items;
+
+	// laid out font and text
+	TTF_Font *m_font;
+	std::string m_text;
+	// size
+	int m_width, m_height;
+};
+
 /* *** *** *** *** *** *** *** Font Manager class *** *** *** *** *** *** *** *** *** *** */
 
 // Deletes an active Font Surface
@@ -47,6 +108,15 @@ public:
 	// Renders the given text into a new surface
 	cGL_Surface *Render_Text( TTF_Font *font, const std::string &text, const Color color = static_cast<Uint8>(0) );
 
+	/* Lay out the UTF-8 text with the glyph atlas
+	 * nothing is done if the layout already has the same font and text
+	*/
+	void Layout_Text( cText_Layout &layout, TTF_Font *font, const std::string &text );
+	/* Get the glyph of the character
+	 * it is rasterized into the glyph atlas when used the first time
+	*/
+	const cGlyph *Get_Glyph( TTF_Font *font, Uint16 ch );
+
 	/* Saves hardware textures in software memory
 	*/
 	void Grab_Textures( void );
@@ -64,6 +134,27 @@ public:
 
 	// saved software textures only used for reloading
 	Saved_Texture_List m_software_textures;
+
+private:
+	// Rasterize the glyph image into the glyph atlas
+	void Rasterize_Glyph( TTF_Font *font, cGlyph *glyph );
+	// Delete all glyphs
+	void Delete_Glyphs( void );
+
+	// glyphs of a font indexed by the character
+	typedef vector<cGlyph *> GlyphList;
+
+	struct cFont_Glyphs
+	{
+		TTF_Font *font;
+		GlyphList glyphs;
+	};
+
+	typedef vector<cFont_Glyphs> FontGlyphsList;
+	FontGlyphsList m_font_glyphs;
+
+	// glyph images of all fonts
+	cTexture_Atlas m_glyph_atlas;
 };
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
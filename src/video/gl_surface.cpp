@@ -36,6 +36,11 @@ cGL_Surface :: cGL_Surface( void )
 	m_h = 0;
 	m_tex_w = 0;
 	m_tex_h = 0;
+	m_tex_x1 = 0.0f;
+	m_tex_y1 = 0.0f;
+	m_tex_x2 = 1.0f;
+	m_tex_y2 = 1.0f;
+	m_atlas = 0;
 
 	// internal rotation data
 	m_base_rot_x = 0;
@@ -51,6 +56,10 @@ cGL_Surface :: cGL_Surface( void )
 	m_auto_del_img = 1;
 	m_managed = 0;
 	m_obsolete = 0;
+	m_last_use_frame = 0;
+	m_unloaded = 0;
+	m_reload_queued = 0;
+	m_external_file = 0;
 
 	// default type is passive
 	m_type = TYPE_PASSIVE;
@@ -63,7 +72,8 @@ cGL_Surface :: cGL_Surface( void )
 cGL_Surface :: ~cGL_Surface( void )
 {
 	// don't delete a managed OpenGL image if still in use by another managed cGL_Surface
-	if( m_auto_del_img && glIsTexture( m_image ) && ( !m_managed || !Is_Texture_Use_Multiple() ) )
+	// atlas textures are deleted by the image manager
+	if( m_auto_del_img && m_image && !m_atlas && glIsTexture( m_image ) && ( !m_managed || !Is_Texture_Use_Multiple() ) )
 	{
 		glDeleteTextures( 1, &m_image );
 	}
@@ -76,6 +86,9 @@ cGL_Surface :: ~cGL_Surface( void )
 
 cGL_Surface *cGL_Surface :: Copy( void )
 {
+	// the copy needs a loaded texture
+	Use_Texture();
+
 	// create copy image
 	cGL_Surface *new_surface = new cGL_Surface();
 
@@ -89,6 +102,11 @@ cGL_Surface *cGL_Surface :: Copy( void )
 	new_surface->m_h = m_h;
 	new_surface->m_tex_h = m_tex_h;
 	new_surface->m_tex_w = m_tex_w;
+	new_surface->m_tex_x1 = m_tex_x1;
+	new_surface->m_tex_y1 = m_tex_y1;
+	new_surface->m_tex_x2 = m_tex_x2;
+	new_surface->m_tex_y2 = m_tex_y2;
+	new_surface->m_atlas = m_atlas;
 	new_surface->m_base_rot_x = m_base_rot_x;
 	new_surface->m_base_rot_y = m_base_rot_y;
 	new_surface->m_base_rot_z = m_base_rot_z;
@@ -96,6 +114,7 @@ cGL_Surface *cGL_Surface :: Copy( void )
 	new_surface->m_col_w = m_col_w;
 	new_surface->m_col_h = m_col_h;
 	new_surface->m_filename = m_filename;
+	new_surface->m_external_file = m_external_file;
 
 	// settings
 	new_surface->m_obsolete = m_obsolete;
@@ -134,8 +153,8 @@ void cGL_Surface :: Blit( float x, float y, float z, cSurface_Request *request /
 
 void cGL_Surface :: Blit_Data( cSurface_Request *request ) const
 {
-	// texture id
-	request->texture_id = m_image;
+	// texture
+	Set_Texture_Data( request );
 
 	// position
 	request->pos_x += m_int_x;
@@ -151,8 +170,49 @@ void cGL_Surface :: Blit_Data( cSurface_Request *request ) const
 	request->rotz += m_base_rot_z;
 }
 
+void cGL_Surface :: Set_Texture_Data( cSurface_Request *request ) const
+{
+	Use_Texture();
+
+	// texture id
+	request->texture_id = m_image;
+
+	// texture coordinates
+	request->tex_x1 = m_tex_x1;
+	request->tex_y1 = m_tex_y1;
+	request->tex_x2 = m_tex_x2;
+	request->tex_y2 = m_tex_y2;
+}
+
+void cGL_Surface :: Use_Texture( void ) const
+{
+	// only managed textures are unloaded
+	if( !m_managed )
+	{
+		return;
+	}
+
+	m_last_use_frame = pImage_Manager->m_frame;
+
+	// not prefetched
+	if( m_unloaded )
+	{
+		pImage_Manager->Reload_Texture( const_cast<cGL_Surface *>(this) );
+	}
+}
+
+void cGL_Surface :: Prefetch_Texture( void ) const
+{
+	if( m_unloaded && !m_reload_queued )
+	{
+		pImage_Manager->Queue_Reload( const_cast<cGL_Surface *>(this) );
+	}
+}
+
 void cGL_Surface :: Save( const std::string &filename )
 {
+	Use_Texture();
+
 	if( !m_image )
 	{
 		printf( "Couldn't save cGL_Surface : No Image Texture ID set\n" );
@@ -162,10 +222,33 @@ void cGL_Surface :: Save( const std::string &filename )
 	// bind the texture
 	glBindTexture( GL_TEXTURE_2D, m_image );
 
+	// get the full texture size
+	GLint full_w = m_tex_w;
+	GLint full_h = m_tex_h;
+
+	if( m_atlas )
+	{
+		glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &full_w );
+		glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &full_h );
+	}
+
 	// create image data
-	GLubyte *data = new GLubyte[m_tex_w * m_tex_h * 4];
+	GLubyte *data = new GLubyte[full_w * full_h * 4];
 	// read texture
 	glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLvoid *>(data) );
+
+	// copy the image rectangle from the atlas texture
+	if( m_atlas )
+	{
+		const unsigned int start_x = static_cast<unsigned int>( m_tex_x1 * full_w + 0.5f );
+		const unsigned int start_y = static_cast<unsigned int>( m_tex_y1 * full_h + 0.5f );
+
+		for( unsigned int y = 0; y < m_tex_h; y++ )
+		{
+			memmove( data + ( y * m_tex_w * 4 ), data + ( ( ( ( start_y + y ) * full_w ) + start_x ) * 4 ), m_tex_w * 4 );
+		}
+	}
+
 	// save
 	pVideo->Save_Surface( filename, data, m_tex_w, m_tex_h );
 	// clear data
@@ -202,7 +285,8 @@ cSaved_Texture *cGL_Surface :: Get_Software_Texture( bool only_filename /* = 0 *
 	cSaved_Texture *soft_tex = new cSaved_Texture();
 
 	// hardware texture to software texture
-	if( !only_filename )
+	// atlas images are always loaded again from file
+	if( !only_filename && !m_atlas )
 	{
 		// bind the texture
 		glBindTexture( GL_TEXTURE_2D, m_image );
@@ -282,7 +366,23 @@ void cGL_Surface :: Load_Software_Texture( cSaved_Texture *soft_tex )
 	// load from file
 	else
 	{
-		cGL_Surface *surface_copy = pVideo->Load_GL_Surface( m_filename );
+		cGL_Surface *surface_copy = NULL;
+
+		// the path is used as it is
+		if( m_external_file )
+		{
+			cVideo::cSoftware_Image software_image;
+			software_image.sdl_surface = IMG_Load( m_filename.c_str() );
+
+			if( software_image.sdl_surface )
+			{
+				surface_copy = pVideo->Create_GL_Surface( m_filename, software_image, 1, m_atlas );
+			}
+		}
+		else
+		{
+			surface_copy = pVideo->Load_GL_Surface( m_filename, 1, 1, m_atlas );
+		}
 
 		if( !surface_copy )
 		{
@@ -294,6 +394,11 @@ void cGL_Surface :: Load_Software_Texture( cSaved_Texture *soft_tex )
 		m_image = surface_copy->m_image;
 		m_tex_w = surface_copy->m_tex_w;
 		m_tex_h = surface_copy->m_tex_h;
+		m_tex_x1 = surface_copy->m_tex_x1;
+		m_tex_y1 = surface_copy->m_tex_y1;
+		m_tex_x2 = surface_copy->m_tex_x2;
+		m_tex_y2 = surface_copy->m_tex_y2;
+		m_atlas = surface_copy->m_atlas;
 		// keep hardware texture
 		surface_copy->m_auto_del_img = 0;
 		// delete copy
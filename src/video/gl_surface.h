@@ -39,6 +39,16 @@ public:
 	void Blit( float x, float y, float z, cSurface_Request *request = NULL ) const;
 	// Blit only the surface data on the given request
 	void Blit_Data( cSurface_Request *request ) const;
+	// Set the texture id and texture coordinates on the given request
+	void Set_Texture_Data( cSurface_Request *request ) const;
+	/* Mark the texture as used in the current frame
+	 * if it was unloaded by the image manager it is loaded again
+	*/
+	void Use_Texture( void ) const;
+	/* Queue loading the texture again if it was unloaded by the image manager
+	 * the queue is loaded before drawing so Use_Texture does not need to load it
+	*/
+	void Prefetch_Texture( void ) const;
 
 	// Copy cGL_Surface and return it
 	cGL_Surface *Copy( void );
@@ -74,6 +84,10 @@ public:
 	float m_w, m_h;
 	// texture dimension
 	unsigned int m_tex_w, m_tex_h;
+	// texture coordinates ( a sub rectangle if in a texture atlas )
+	float m_tex_x1, m_tex_y1, m_tex_x2, m_tex_y2;
+	// if the texture is shared in a texture atlas
+	bool m_atlas;
 	// internal rotation
 	float m_base_rot_x, m_base_rot_y, m_base_rot_z;
 	// image collision data
@@ -82,12 +96,20 @@ public:
 
 	// origin if created from a file
 	std::string m_filename;
+	// if set the file is not in the pixmaps directory and is loaded again without image settings
+	bool m_external_file;
 	// should the image be deleted
 	bool m_auto_del_img;
 	// if managed over the image manager
 	bool m_managed;
 	// if the image is tagged as obsolete 
 	bool m_obsolete;
+	// image manager frame the texture was last used in
+	mutable unsigned int m_last_use_frame;
+	// if the texture was unloaded by the image manager to stay in the texture budget
+	bool m_unloaded;
+	// if in the image manager reload queue
+	mutable bool m_reload_queued;
 
 	// editor tags
 	std::string m_editor_tags;
@@ -16,10 +16,37 @@
 #include "../video/img_manager.h"
 #include "../video/renderer.h"
 #include "../core/i18n.h"
+#include "../core/filesystem/filesystem.h"
+#include <algorithm>
 
 namespace SMC
 {
 
+// frames between the texture budget checks
+static const unsigned int texture_residency_interval = 30;
+// textures used in this number of frames are never unloaded
+static const unsigned int texture_min_unused_frames = 120;
+// queued textures loaded per frame
+static const unsigned int texture_reloads_per_frame = 8;
+
+// texture last use sort
+struct last_use_sort
+{
+	bool operator()( const cGL_Surface *a, const cGL_Surface *b ) const
+	{
+		return a->m_last_use_frame < b->m_last_use_frame;
+	}
+};
+
+// texture id sort
+struct texture_id_sort
+{
+	bool operator()( const cGL_Surface *a, const cGL_Surface *b ) const
+	{
+		return a->m_image < b->m_image;
+	}
+};
+
 /* *** *** *** *** *** cSaved_Texture *** *** *** *** *** *** *** *** *** *** *** *** */
 
 cSaved_Texture :: cSaved_Texture( void )
@@ -51,6 +78,10 @@ cImage_Manager :: cImage_Manager( void )
 : cObject_Manager<cGL_Surface>()
 {
 	high_texture_id = 0;
+	m_texture_generation = 0;
+	m_texture_budget = 0;
+	m_frame = 0;
+	m_texture_size = 0;
 }
 
 cImage_Manager :: ~cImage_Manager( void )
@@ -70,41 +101,68 @@ void cImage_Manager :: Add( cGL_Surface *obj )
 
 	// Add
 	cObject_Manager<cGL_Surface>::Add( obj );
+	// only the first surface with the filename is found
+	m_filename_index.Add( obj->m_filename, obj );
 }
 
-cGL_Surface *cImage_Manager :: Get_Pointer( const std::string &path ) const
+bool cImage_Manager :: Delete( size_t array_num, bool delete_data /* = 1 */ )
 {
-	for( GL_Surface_List::const_iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	// not in vector
+	if( array_num >= objects.size() )
 	{
-		cGL_Surface *obj = (*itr);
-
-		// return first match
-		if( obj->m_filename.compare( path ) == 0 )
-		{
-			return obj;
-		}
+		return 0;
 	}
 
-	// not found
-	return NULL;
+	return Delete( objects[array_num], delete_data );
 }
 
-cGL_Surface *cImage_Manager :: Copy( const std::string &path )
+bool cImage_Manager :: Delete( cGL_Surface *obj, bool delete_data /* = 1 */ )
 {
-	for( GL_Surface_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	// empty object
+	if( !obj )
 	{
-		// get object
-		cGL_Surface *obj = (*itr);
+		return 0;
+	}
 
-		// first match
-		if( obj->m_filename.compare( path ) == 0 )
+	if( obj->m_reload_queued )
+	{
+		m_reload_queue.erase( std::find( m_reload_queue.begin(), m_reload_queue.end(), obj ) );
+		obj->m_reload_queued = 0;
+	}
+
+	// remove from index
+	if( m_filename_index.Remove( obj->m_filename, obj ) )
+	{
+		// index the next surface with the same filename
+		for( GL_Surface_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
 		{
-			return obj->Copy();
+			if( (*itr) != obj && (*itr)->m_filename.compare( obj->m_filename ) == 0 )
+			{
+				m_filename_index.Add( (*itr)->m_filename, (*itr) );
+				break;
+			}
 		}
 	}
 
+	return cObject_Manager<cGL_Surface>::Delete( obj, delete_data );
+}
+
+cGL_Surface *cImage_Manager :: Get_Pointer( const std::string &path ) const
+{
+	return m_filename_index.Get( path );
+}
+
+cGL_Surface *cImage_Manager :: Copy( const std::string &path )
+{
+	cGL_Surface *obj = Get_Pointer( path );
+
 	// not found
-	return NULL;
+	if( !obj )
+	{
+		return NULL;
+	}
+
+	return obj->Copy();
 }
 
 void cImage_Manager :: Grab_Textures( bool from_file /* = 0 */, bool draw_gui /* = 0 */ )
@@ -139,7 +197,7 @@ void cImage_Manager :: Grab_Textures( bool from_file /* = 0 */, bool draw_gui /*
 		// get software texture and save it to software memory
 		saved_textures.push_back( obj->Get_Software_Texture( from_file ) );
 		// delete hardware texture
-		if( glIsTexture( obj->m_image ) )
+		if( !obj->m_atlas && glIsTexture( obj->m_image ) )
 		{
 			glDeleteTextures( 1, &obj->m_image );
 		}
@@ -156,6 +214,9 @@ void cImage_Manager :: Grab_Textures( bool from_file /* = 0 */, bool draw_gui /*
 			Loading_Screen_Draw();
 		}
 	}
+
+	// atlas images are loaded again from file
+	m_atlas.Clear();
 }
 
 void cImage_Manager :: Restore_Textures( bool draw_gui /* = 0 */ )
@@ -200,6 +261,7 @@ void cImage_Manager :: Restore_Textures( bool draw_gui /* = 0 */ )
 	}
 
 	saved_textures.clear();
+	m_texture_generation++;
 }
 
 void cImage_Manager :: Delete_Image_Textures( void )
@@ -209,15 +271,20 @@ void cImage_Manager :: Delete_Image_Textures( void )
 		// get object
 		cGL_Surface *obj = (*itr);
 
-		if( obj->m_auto_del_img && glIsTexture( obj->m_image ) )
+		if( obj->m_auto_del_img && !obj->m_atlas && glIsTexture( obj->m_image ) )
 		{
 			glDeleteTextures( 1, &obj->m_image );
 		}
 	}
+
+	m_atlas.Clear();
+	m_texture_generation++;
 }
 
 void cImage_Manager :: Delete_Hardware_Textures( void )
 {
+	m_atlas.Clear();
+
 	// delete all hardware surfaces
 	for( GLuint i = 0; i < high_texture_id; i++ )
 	{
@@ -229,15 +296,148 @@ void cImage_Manager :: Delete_Hardware_Textures( void )
 	}
 
 	high_texture_id = 0;
+	m_texture_generation++;
 }
 
 void cImage_Manager :: Delete_All( void )
 {
 	// stops cGL_Surface destructor from checking if GL texture id still in use
 	Delete_Image_Textures();
+	m_filename_index.Clear();
+	m_reload_queue.clear();
 	cObject_Manager<cGL_Surface>::Delete_All();
 }
 
+void cImage_Manager :: Update_Residency( void )
+{
+	m_frame++;
+
+	// unlimited or not yet checked again
+	if( !m_texture_budget || m_frame % texture_residency_interval != 0 )
+	{
+		return;
+	}
+
+	// surfaces with an own texture which can be loaded again from file
+	GL_Surface_List surfaces;
+	// atlas textures are never unloaded but count to the budget
+	m_texture_size = m_atlas.Get_Texture_Size();
+
+	for( GL_Surface_List::iterator itr = objects.begin(), itr_end = objects.end(); itr != itr_end; ++itr )
+	{
+		cGL_Surface *obj = (*itr);
+
+		// not loaded or in the shared atlas texture
+		if( obj->m_unloaded || !obj->m_image || obj->m_atlas )
+		{
+			continue;
+		}
+
+		m_texture_size += static_cast<Uint64>(obj->m_tex_w) * obj->m_tex_h * 4;
+
+		if( obj->m_auto_del_img && !obj->m_filename.empty() )
+		{
+			surfaces.push_back( obj );
+		}
+	}
+
+	const Uint64 budget = static_cast<Uint64>(m_texture_budget) * 1024 * 1024;
+
+	if( m_texture_size <= budget )
+	{
+		return;
+	}
+
+	// textures used by multiple surfaces are kept
+	std::sort( surfaces.begin(), surfaces.end(), texture_id_sort() );
+
+	GL_Surface_List candidates;
+
+	for( GL_Surface_List::iterator itr = surfaces.begin(), itr_end = surfaces.end(); itr != itr_end; ++itr )
+	{
+		cGL_Surface *obj = (*itr);
+
+		if( ( itr != surfaces.begin() && (*( itr - 1 ))->m_image == obj->m_image ) || ( itr + 1 != itr_end && (*( itr + 1 ))->m_image == obj->m_image ) )
+		{
+			continue;
+		}
+
+		// used recently
+		if( m_frame - obj->m_last_use_frame < texture_min_unused_frames )
+		{
+			continue;
+		}
+
+		candidates.push_back( obj );
+	}
+
+	// least recently used first
+	std::sort( candidates.begin(), candidates.end(), last_use_sort() );
+
+	for( GL_Surface_List::iterator itr = candidates.begin(), itr_end = candidates.end(); itr != itr_end && m_texture_size > budget; ++itr )
+	{
+		cGL_Surface *obj = (*itr);
+
+		// can not be loaded again
+		if( !File_Exists( obj->m_filename ) )
+		{
+			continue;
+		}
+
+		if( glIsTexture( obj->m_image ) )
+		{
+			glDeleteTextures( 1, &obj->m_image );
+		}
+
+		m_texture_size -= static_cast<Uint64>(obj->m_tex_w) * obj->m_tex_h * 4;
+		obj->m_image = 0;
+		obj->m_unloaded = 1;
+	}
+}
+
+void cImage_Manager :: Reload_Texture( cGL_Surface *obj )
+{
+	// not tried again if loading fails
+	obj->m_unloaded = 0;
+
+	// load from file
+	cSaved_Texture soft_tex;
+	soft_tex.base = obj;
+	obj->Load_Software_Texture( &soft_tex );
+
+	m_texture_size += static_cast<Uint64>(obj->m_tex_w) * obj->m_tex_h * 4;
+}
+
+void cImage_Manager :: Queue_Reload( cGL_Surface *obj )
+{
+	obj->m_reload_queued = 1;
+	m_reload_queue.push_back( obj );
+}
+
+void cImage_Manager :: Load_Queued_Textures( void )
+{
+	unsigned int count = 0;
+	GL_Surface_List::iterator itr = m_reload_queue.begin();
+
+	// the others are loaded in the next frames or when used
+	for( ; itr != m_reload_queue.end() && count < texture_reloads_per_frame; ++itr )
+	{
+		cGL_Surface *obj = (*itr);
+		obj->m_reload_queued = 0;
+
+		// already loaded when used
+		if( !obj->m_unloaded )
+		{
+			continue;
+		}
+
+		Reload_Texture( obj );
+		count++;
+	}
+
+	m_reload_queue.erase( m_reload_queue.begin(), itr );
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 cImage_Manager *pImage_Manager = NULL;
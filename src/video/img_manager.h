@@ -19,7 +19,9 @@
 #include "../core/globals.h"
 #include "../video/video.h"
 #include "../core/obj_manager.h"
+#include "../core/hash_index.h"
 #include "../video/gl_surface.h"
+#include "../video/texture_atlas.h"
 
 namespace SMC
 {
@@ -71,6 +73,11 @@ public:
 	// Add a surface
 	virtual void Add( cGL_Surface *obj );
 
+	// Delete the surface from given array number
+	virtual bool Delete( size_t array_num, bool delete_data = 1 );
+	// Delete the given surface
+	virtual bool Delete( cGL_Surface *obj, bool delete_data = 1 );
+
 	// Return the surface by path
 	cGL_Surface *Get_Pointer( const std::string &path ) const;
 
@@ -108,12 +115,47 @@ public:
 	// Delete all Surfaces
 	virtual void Delete_All( void );
 
+	/* Unload the least recently used textures if the texture size is over the budget
+	 * they are loaded again from file on the next use
+	 * must be called once per frame after rendering
+	*/
+	void Update_Residency( void );
+	// Load the texture of the unloaded surface again
+	void Reload_Texture( cGL_Surface *obj );
+	// Add the unloaded surface to the textures loaded before the next drawing
+	void Queue_Reload( cGL_Surface *obj );
+	/* Load the queued textures
+	 * must be called after updating and before drawing
+	*/
+	void Load_Queued_Textures( void );
+
 	// highest opengl texture id found
 	GLuint high_texture_id;
+	/* changed when textures were deleted or restored
+	 * saved texture ids and coordinates are invalid if it changed
+	*/
+	unsigned int m_texture_generation;
+
+	// shared textures for small images
+	cTexture_Atlas m_atlas;
+
+	// texture budget in megabytes ( 0 is unlimited )
+	unsigned int m_texture_budget;
+	// current frame for the texture last use
+	unsigned int m_frame;
+	// estimated size of the loaded surface and atlas textures from the last check in bytes
+	Uint64 m_texture_size;
 
 private:
 	// saved textures for reloading
 	Saved_Texture_List saved_textures;
+	// unloaded surfaces to load before the next drawing
+	GL_Surface_List m_reload_queue;
+
+	/* surfaces by filename
+	 * the filename and the surface pointer stay the same when the textures are grabbed and restored
+	*/
+	cHash_Index<cGL_Surface> m_filename_index;
 };
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
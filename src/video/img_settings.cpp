@@ -18,10 +18,139 @@
 #include "../core/math/utilities.h"
 #include "../core/math/size.h"
 #include "../core/filesystem/filesystem.h"
+#include "../core/filesystem/resource_manager.h"
+#include <cstring>
 
 namespace SMC
 {
 
+// index file identifier
+static const char image_settings_index_magic[4] = { 'S', 'M', 'C', 'S' };
+
+/* *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** *** */
+
+// Return the settings file with its current size and modification time
+static cImage_settings_file Get_Settings_File( const std::string &filename )
+{
+	size_t size;
+	time_t time;
+	Get_File_Size_And_Time( filename, size, time );
+
+	cImage_settings_file file;
+	file.m_filename = filename;
+	file.m_size = static_cast<unsigned int>(size);
+	file.m_time = static_cast<unsigned int>(time);
+
+	return file;
+}
+
+// Add the value in little endian byte order
+static void Write_Uint( std::string &data, unsigned int value )
+{
+	data += static_cast<char>(value & 0xFF);
+	data += static_cast<char>(( value >> 8 ) & 0xFF);
+	data += static_cast<char>(( value >> 16 ) & 0xFF);
+	data += static_cast<char>(( value >> 24 ) & 0xFF);
+}
+
+// Add the string length and characters
+static void Write_String( std::string &data, const std::string &str )
+{
+	Write_Uint( data, static_cast<unsigned int>(str.length()) );
+	data += str;
+}
+
+// Add the float bits
+static void Write_Float( std::string &data, float value )
+{
+	unsigned int bits;
+	memcpy( &bits, &value, sizeof(bits) );
+	Write_Uint( data, bits );
+}
+
+/* Read a little endian value and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Uint( const vector<char> &data, size_t &pos, unsigned int &value )
+{
+	if( pos + 4 > data.size() )
+	{
+		return 0;
+	}
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&data[pos]);
+	value = bytes[0] | ( bytes[1] << 8 ) | ( bytes[2] << 16 ) | ( static_cast<unsigned int>(bytes[3]) << 24 );
+	pos += 4;
+
+	return 1;
+}
+
+/* Read a signed value and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Int( const vector<char> &data, size_t &pos, int &value )
+{
+	unsigned int bits;
+
+	if( !Read_Uint( data, pos, bits ) )
+	{
+		return 0;
+	}
+
+	value = static_cast<int>(bits);
+	return 1;
+}
+
+/* Read a boolean value and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Bool( const vector<char> &data, size_t &pos, bool &value )
+{
+	unsigned int bits;
+
+	if( !Read_Uint( data, pos, bits ) )
+	{
+		return 0;
+	}
+
+	value = bits != 0;
+	return 1;
+}
+
+/* Read the float bits and advance the position
+ * returns false if the data ended
+*/
+static bool Read_Float( const vector<char> &data, size_t &pos, float &value )
+{
+	unsigned int bits;
+
+	if( !Read_Uint( data, pos, bits ) )
+	{
+		return 0;
+	}
+
+	memcpy( &value, &bits, sizeof(value) );
+	return 1;
+}
+
+/* Read a string and advance the position
+ * returns false if the data ended
+*/
+static bool Read_String( const vector<char> &data, size_t &pos, std::string &str )
+{
+	unsigned int length;
+
+	if( !Read_Uint( data, pos, length ) || pos + length > data.size() )
+	{
+		return 0;
+	}
+
+	str.assign( data.begin() + pos, data.begin() + pos + length );
+	pos += length;
+
+	return 1;
+}
+
 /* *** *** *** *** *** *** cImage_settings_data *** *** *** *** *** *** *** *** *** *** *** */
 
 cImage_settings_data :: cImage_settings_data( void )
@@ -271,6 +400,27 @@ void cImage_settings_data :: Apply_Base( const cImage_settings_data *base_settin
 	}
 }
 
+/* *** *** *** *** *** *** cImage_settings_cache_item *** *** *** *** *** *** *** *** *** *** *** */
+
+bool cImage_settings_cache_item :: Is_Valid( void ) const
+{
+	for( Image_Settings_File_List::const_iterator itr = m_files.begin(), itr_end = m_files.end(); itr != itr_end; ++itr )
+	{
+		const cImage_settings_file &file = (*itr);
+
+		size_t size;
+		time_t time;
+		Get_File_Size_And_Time( file.m_filename, size, time );
+
+		if( file.m_size != static_cast<unsigned int>(size) || file.m_time != static_cast<unsigned int>(time) )
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
 /* *** *** *** *** *** *** cImage_settings *** *** *** *** *** *** *** *** *** *** *** */
 
 cImage_settings :: cImage_settings( void )
@@ -282,17 +432,225 @@ cImage_settings :: cImage_settings( void )
 
 cImage_settings :: ~cImage_settings( void )
 {
-	//
+	Clear_Cache();
 }
 
 cImage_settings_data *cImage_settings :: Get( const std::string &filename, bool load_base_settings /* = 1 */ )
 {
-	m_load_base = load_base_settings;
-	m_settings_temp = new cImage_settings_data();
+	// only complete settings are cached
+	if( !load_base_settings )
+	{
+		Image_Settings_File_List files;
+		return Parse_Settings( filename, 0, files );
+	}
 
-	Parse( filename );
-	cImage_settings_data *settings = m_settings_temp;
-	m_settings_temp = NULL;
+	cImage_settings_cache_item *item = m_cache.Get( filename );
+
+	// not cached
+	if( !item )
+	{
+		item = new cImage_settings_cache_item();
+		item->m_filename = filename;
+
+		cImage_settings_data *settings = Parse_Settings( filename, 1, item->m_files );
+		item->m_settings = *settings;
+		delete settings;
+
+		m_cache_items.push_back( item );
+		m_cache.Add( item->m_filename, item );
+	}
+	// changed
+	else if( !item->Is_Valid() )
+	{
+		item->m_files.clear();
+
+		cImage_settings_data *settings = Parse_Settings( filename, 1, item->m_files );
+		item->m_settings = *settings;
+		delete settings;
+	}
+
+	return new cImage_settings_data( item->m_settings );
+}
+
+void cImage_settings :: Clear_Cache( void )
+{
+	m_cache.Clear();
+
+	for( Image_Settings_Cache_List::iterator itr = m_cache_items.begin(), itr_end = m_cache_items.end(); itr != itr_end; ++itr )
+	{
+		delete *itr;
+	}
+
+	m_cache_items.clear();
+}
+
+bool cImage_settings :: Load_Index( const std::string &filename )
+{
+	ifstream ifs( filename.c_str(), ios::in | ios::binary );
+
+	if( !ifs )
+	{
+		return 0;
+	}
+
+	// read the whole file
+	vector<char> data;
+	ifs.seekg( 0, ios::end );
+	data.resize( static_cast<size_t>(ifs.tellg()) );
+	ifs.seekg( 0, ios::beg );
+
+	if( data.size() < sizeof(image_settings_index_magic) || !ifs.read( &data[0], data.size() ) )
+	{
+		return 0;
+	}
+
+	ifs.close();
+
+	// check identifier
+	if( memcmp( &data[0], image_settings_index_magic, sizeof(image_settings_index_magic) ) != 0 )
+	{
+		printf( "Warning : Image settings index %s is not valid\n", filename.c_str() );
+		return 0;
+	}
+
+	size_t pos = sizeof(image_settings_index_magic);
+	unsigned int version, item_count;
+
+	if( !Read_Uint( data, pos, version ) || version != image_settings_index_version || !Read_Uint( data, pos, item_count ) )
+	{
+		return 0;
+	}
+
+	for( unsigned int i = 0; i < item_count; i++ )
+	{
+		cImage_settings_cache_item *item = new cImage_settings_cache_item();
+		cImage_settings_data &settings = item->m_settings;
+		unsigned int file_count;
+		int ground_type;
+		bool valid = Read_String( data, pos, item->m_filename ) && Read_Uint( data, pos, file_count );
+
+		for( unsigned int j = 0; valid && j < file_count; j++ )
+		{
+			cImage_settings_file file;
+			valid = Read_String( data, pos, file.m_filename ) && Read_Uint( data, pos, file.m_size ) && Read_Uint( data, pos, file.m_time );
+			item->m_files.push_back( file );
+		}
+
+		valid = valid && Read_String( data, pos, settings.m_base ) && Read_Bool( data, pos, settings.m_base_settings )
+			&& Read_Int( data, pos, settings.m_int_x ) && Read_Int( data, pos, settings.m_int_y )
+			&& Read_Float( data, pos, settings.m_col_rect.m_x ) && Read_Float( data, pos, settings.m_col_rect.m_y )
+			&& Read_Float( data, pos, settings.m_col_rect.m_w ) && Read_Float( data, pos, settings.m_col_rect.m_h )
+			&& Read_Int( data, pos, settings.m_width ) && Read_Int( data, pos, settings.m_height )
+			&& Read_Int( data, pos, settings.m_rotation_x ) && Read_Int( data, pos, settings.m_rotation_y ) && Read_Int( data, pos, settings.m_rotation_z )
+			&& Read_Bool( data, pos, settings.m_mipmap ) && Read_String( data, pos, settings.m_editor_tags )
+			&& Read_String( data, pos, settings.m_name ) && Read_Int( data, pos, settings.m_type )
+			&& Read_Int( data, pos, ground_type ) && Read_String( data, pos, settings.m_author )
+			&& Read_Bool( data, pos, settings.m_obsolete );
+
+		// data ended
+		if( !valid )
+		{
+			delete item;
+			return 0;
+		}
+
+		settings.m_ground_type = static_cast<GroundType>(ground_type);
+
+		// changed or already cached
+		if( !item->Is_Valid() || !m_cache.Add( item->m_filename, item ) )
+		{
+			delete item;
+			continue;
+		}
+
+		m_cache_items.push_back( item );
+	}
+
+	return 1;
+}
+
+bool cImage_settings :: Save_Index( const std::string &filename ) const
+{
+	std::string data( image_settings_index_magic, sizeof(image_settings_index_magic) );
+	Write_Uint( data, image_settings_index_version );
+	Write_Uint( data, static_cast<unsigned int>(m_cache_items.size()) );
+
+	for( Image_Settings_Cache_List::const_iterator itr = m_cache_items.begin(), itr_end = m_cache_items.end(); itr != itr_end; ++itr )
+	{
+		const cImage_settings_cache_item *item = (*itr);
+		const cImage_settings_data &settings = item->m_settings;
+
+		Write_String( data, item->m_filename );
+		Write_Uint( data, static_cast<unsigned int>(item->m_files.size()) );
+
+		for( Image_Settings_File_List::const_iterator file_itr = item->m_files.begin(), file_itr_end = item->m_files.end(); file_itr != file_itr_end; ++file_itr )
+		{
+			Write_String( data, (*file_itr).m_filename );
+			Write_Uint( data, (*file_itr).m_size );
+			Write_Uint( data, (*file_itr).m_time );
+		}
+
+		Write_String( data, settings.m_base );
+		Write_Uint( data, settings.m_base_settings );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_int_x) );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_int_y) );
+		Write_Float( data, settings.m_col_rect.m_x );
+		Write_Float( data, settings.m_col_rect.m_y );
+		Write_Float( data, settings.m_col_rect.m_w );
+		Write_Float( data, settings.m_col_rect.m_h );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_width) );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_height) );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_rotation_x) );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_rotation_y) );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_rotation_z) );
+		Write_Uint( data, settings.m_mipmap );
+		Write_String( data, settings.m_editor_tags );
+		Write_String( data, settings.m_name );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_type) );
+		Write_Uint( data, static_cast<unsigned int>(settings.m_ground_type) );
+		Write_String( data, settings.m_author );
+		Write_Uint( data, settings.m_obsolete );
+	}
+
+	ofstream ofs( filename.c_str(), ios::out | ios::binary | ios::trunc );
+
+	if( !ofs )
+	{
+		printf( "Error : Couldn't open image settings index %s for saving\n", filename.c_str() );
+		return 0;
+	}
+
+	ofs.write( data.c_str(), data.length() );
+	ofs.close();
+
+	return 1;
+}
+
+unsigned int cImage_settings :: Build_Index( const std::string &dir )
+{
+	vector<std::string> settings_files = Get_Directory_Files( dir, ".settings" );
+
+	for( vector<std::string>::iterator itr = settings_files.begin(), itr_end = settings_files.end(); itr != itr_end; ++itr )
+	{
+		delete Get( *itr );
+	}
+
+	return static_cast<unsigned int>(settings_files.size());
+}
+
+cImage_settings_data *cImage_settings :: Parse_Settings( const std::string &filename, bool load_base_settings, Image_Settings_File_List &files ) const
+{
+	// a new parser as base settings are parsed while parsing
+	cImage_settings parser;
+	parser.m_load_base = load_base_settings;
+	parser.m_settings_temp = new cImage_settings_data();
+	parser.m_parsed_files.push_back( Get_Settings_File( filename ) );
+
+	parser.Parse( filename );
+	files = parser.m_parsed_files;
+
+	cImage_settings_data *settings = parser.m_settings_temp;
+	parser.m_settings_temp = NULL;
 	return settings;
 }
 
@@ -335,17 +693,34 @@ bool cImage_settings :: HandleMessage( const std::string *parts, unsigned int co
 						settings_file.insert( settings_file.rfind( "." ) + 1, "settings" );
 					}
 
+					// the cached settings are invalid if it changes or is created
+					m_parsed_files.push_back( Get_Settings_File( settings_file ) );
+
 					// not found
 					if( !File_Exists( settings_file ) )
 					{
 						break;
 					}
 
-					// create new temporary parser
-					cImage_settings *temp_parser = new cImage_settings();
-					cImage_settings_data *base_settings = temp_parser->Get( settings_file );
-					// finished loading base settings
-					delete temp_parser;
+					// use the cached base settings
+					cImage_settings *base_parser = pSettingsParser ? pSettingsParser : this;
+					cImage_settings_data *base_settings = base_parser->Get( settings_file );
+
+					// the files the base settings are based on
+					const cImage_settings_cache_item *base_item = base_parser->m_cache.Get( settings_file );
+
+					if( base_item )
+					{
+						for( Image_Settings_File_List::const_iterator file_itr = base_item->m_files.begin(), file_itr_end = base_item->m_files.end(); file_itr != file_itr_end; ++file_itr )
+						{
+							// the base settings file is already added
+							if( (*file_itr).m_filename.compare( settings_file ) != 0 )
+							{
+								m_parsed_files.push_back( *file_itr );
+							}
+						}
+					}
+
 					settings_file.clear();
 
 					// handle
@@ -615,6 +990,13 @@ bool cImage_settings :: HandleMessage( const std::string *parts, unsigned int co
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
+std::string Get_Image_Settings_Index_Filename( void )
+{
+	return pResource_Manager->user_data_dir + USER_IMGCACHE_DIR "/image_settings.idx";
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
 cImage_settings *pSettingsParser = NULL;
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
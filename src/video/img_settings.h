@@ -20,6 +20,7 @@
 #include "../core/file_parser.h"
 #include "../video/gl_surface.h"
 #include "../core/math/rect.h"
+#include "../core/hash_index.h"
 
 namespace SMC
 {
@@ -71,8 +72,39 @@ public:
 	bool m_obsolete;
 };
 
+/* *** *** *** *** *** *** cImage_settings_cache_item *** *** *** *** *** *** *** *** *** *** *** */
+
+// settings file with the size and modification time it was parsed with
+struct cImage_settings_file
+{
+	std::string m_filename;
+	// size and modification time are 0 if it did not exist
+	unsigned int m_size;
+	unsigned int m_time;
+};
+
+typedef vector<cImage_settings_file> Image_Settings_File_List;
+
+// Parsed settings with the base settings applied
+class cImage_settings_cache_item
+{
+public:
+	// Return true if no file changed since parsing
+	bool Is_Valid( void ) const;
+
+	// settings filename
+	std::string m_filename;
+	// settings
+	cImage_settings_data m_settings;
+	// the settings file and all base settings files
+	Image_Settings_File_List m_files;
+};
+
 /* *** *** *** *** *** *** cImage_settings *** *** *** *** *** *** *** *** *** *** *** */
 
+// image settings index file version
+static const unsigned int image_settings_index_version = 2;
+
 // Image Settings Handler
 // Inherits from cFile_parser
 class cImage_settings : public cFile_parser
@@ -83,10 +115,27 @@ public:
 
 	/* Returns the settings from the given file
 	 * load_base_settings : if set will overwrite settings with all base settings if available
+	 * settings with base settings are cached until the file or a base settings file changes
 	 * The returned settings data should be deleted if not used anymore
 	*/
 	cImage_settings_data *Get( const std::string &filename, bool load_base_settings = 1 );
 
+	// Delete all cached settings
+	void Clear_Cache( void );
+	/* Cache the settings from the index file
+	 * settings with changed files are not used
+	 * returns false if not available or not valid
+	*/
+	bool Load_Index( const std::string &filename );
+	/* Save all cached settings into the index file
+	 * returns true if successful
+	*/
+	bool Save_Index( const std::string &filename ) const;
+	/* Cache the settings of all settings files in the directory and its sub-directories
+	 * returns the number of settings files
+	*/
+	unsigned int Build_Index( const std::string &dir );
+
 	// Handles the Image Settings Line
 	virtual bool HandleMessage( const std::string *parts, unsigned int count, unsigned int line );
 
@@ -94,10 +143,28 @@ public:
 	cImage_settings_data *m_settings_temp;
 	// load base settings
 	bool m_load_base;
+
+private:
+	/* Parse the settings file with a new parser
+	 * files : set to the settings file and the used base settings files
+	*/
+	cImage_settings_data *Parse_Settings( const std::string &filename, bool load_base_settings, Image_Settings_File_List &files ) const;
+
+	// base settings files used while parsing
+	Image_Settings_File_List m_parsed_files;
+
+	// cached settings by filename
+	cHash_Index<cImage_settings_cache_item> m_cache;
+	typedef vector<cImage_settings_cache_item *> Image_Settings_Cache_List;
+	// cached settings
+	Image_Settings_Cache_List m_cache_items;
 };
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
+// Return the image settings index filename in the user image cache directory
+std::string Get_Image_Settings_Index_Filename( void );
+
 // Image Settings Handler class
 extern cImage_settings *pSettingsParser;
 
@@ -15,6 +15,8 @@
 
 #include "../video/renderer.h"
 #include "../core/game_core.h"
+#include "../core/profiler.h"
+#include "../core/memory_pool.h"
 #include <algorithm>
 // SDL
 #include "SDL.h"
@@ -30,6 +32,42 @@ namespace SMC
 const float doubled_pi = static_cast<float>(M_PI * 2.0f);
 static GLuint last_bind_texture = 0;
 
+/* *** *** *** *** *** *** *** Request memory *** *** *** *** *** *** *** *** *** *** */
+
+// memory for the requests created every frame
+static cMemory_Pool line_request_pool( sizeof(cLine_Request), 128 );
+static cMemory_Pool rect_request_pool( sizeof(cRect_Request), 256 );
+static cMemory_Pool gradient_request_pool( sizeof(cGradient_Request), 32 );
+static cMemory_Pool circle_request_pool( sizeof(cCircle_Request), 32 );
+static cMemory_Pool surface_request_pool( sizeof(cSurface_Request), 1024 );
+static cMemory_Pool surface_list_request_pool( sizeof(cSurface_List_Request), 32 );
+static cMemory_Pool vertex_array_request_pool( sizeof(cVertex_Array_Request), 64 );
+
+/* Return a block from the pool or from the heap if a derived class
+ * the pool block size is aligned so the size is compared with the class size
+*/
+static void *Alloc_Request( cMemory_Pool &pool, size_t size, size_t class_size )
+{
+	if( size != class_size )
+	{
+		return ::operator new( size );
+	}
+
+	return pool.Alloc();
+}
+
+// Give the block back to the pool or to the heap if a derived class
+static void Free_Request( cMemory_Pool &pool, void *ptr, size_t size, size_t class_size )
+{
+	if( size != class_size )
+	{
+		::operator delete( ptr );
+		return;
+	}
+
+	pool.Free( ptr );
+}
+
 /* *** *** *** *** *** *** cRenderRequest *** *** *** *** *** *** *** *** *** *** *** */
 
 cRenderRequest :: cRenderRequest( void )
@@ -170,6 +208,16 @@ cLine_Request :: ~cLine_Request( void )
 
 }
 
+void *cLine_Request :: operator new( size_t size )
+{
+	return Alloc_Request( line_request_pool, size, sizeof(cLine_Request) );
+}
+
+void cLine_Request :: operator delete( void *ptr, size_t size )
+{
+	Free_Request( line_request_pool, ptr, size, sizeof(cLine_Request) );
+}
+
 void cLine_Request :: Draw( void )
 {
 	Render_Basic();
@@ -259,6 +307,16 @@ cRect_Request :: ~cRect_Request( void )
 
 }
 
+void *cRect_Request :: operator new( size_t size )
+{
+	return Alloc_Request( rect_request_pool, size, sizeof(cRect_Request) );
+}
+
+void cRect_Request :: operator delete( void *ptr, size_t size )
+{
+	Free_Request( rect_request_pool, ptr, size, sizeof(cRect_Request) );
+}
+
 void cRect_Request :: Draw( void )
 {
 	Render_Basic();
@@ -366,6 +424,16 @@ cGradient_Request :: ~cGradient_Request( void )
 
 }
 
+void *cGradient_Request :: operator new( size_t size )
+{
+	return Alloc_Request( gradient_request_pool, size, sizeof(cGradient_Request) );
+}
+
+void cGradient_Request :: operator delete( void *ptr, size_t size )
+{
+	Free_Request( gradient_request_pool, ptr, size, sizeof(cGradient_Request) );
+}
+
 void cGradient_Request :: Draw( void )
 {
 	Render_Basic();
@@ -437,6 +505,16 @@ cCircle_Request :: ~cCircle_Request( void )
 
 }
 
+void *cCircle_Request :: operator new( size_t size )
+{
+	return Alloc_Request( circle_request_pool, size, sizeof(cCircle_Request) );
+}
+
+void cCircle_Request :: operator delete( void *ptr, size_t size )
+{
+	Free_Request( circle_request_pool, ptr, size, sizeof(cCircle_Request) );
+}
+
 void cCircle_Request :: Draw( void )
 {
 	Render_Basic();
@@ -529,6 +607,11 @@ cSurface_Request :: cSurface_Request( void )
 	type = REND_SURFACE;
 	texture_id = 0;
 
+	tex_x1 = 0.0f;
+	tex_y1 = 0.0f;
+	tex_x2 = 1.0f;
+	tex_y2 = 1.0f;
+
 	pos_x = 0.0f;
 	pos_y = 0.0f;
 
@@ -552,6 +635,16 @@ cSurface_Request :: ~cSurface_Request( void )
 	}
 }
 
+void *cSurface_Request :: operator new( size_t size )
+{
+	return Alloc_Request( surface_request_pool, size, sizeof(cSurface_Request) );
+}
+
+void cSurface_Request :: operator delete( void *ptr, size_t size )
+{
+	Free_Request( surface_request_pool, ptr, size, sizeof(cSurface_Request) );
+}
+
 void cSurface_Request :: Draw( void )
 {
 	// draw shadow
@@ -650,16 +743,16 @@ void cSurface_Request :: Draw( void )
 	// rectangle
 	glBegin( GL_QUADS );
 		// top left
-		glTexCoord2f( 0.0f, 0.0f );
+		glTexCoord2f( tex_x1, tex_y1 );
 		glVertex2f( -half_w, -half_h );
 		// top right
-		glTexCoord2f( 1.0f, 0.0f );
+		glTexCoord2f( tex_x2, tex_y1 );
 		glVertex2f( half_w, -half_h );
 		// bottom right
-		glTexCoord2f( 1.0f, 1.0f );
+		glTexCoord2f( tex_x2, tex_y2 );
 		glVertex2f( half_w, half_h );
 		// bottom left
-		glTexCoord2f( 0.0f, 1.0f );
+		glTexCoord2f( tex_x1, tex_y2 );
 		glVertex2f( -half_w, half_h );
 	glEnd();
 
@@ -676,11 +769,447 @@ void cSurface_Request :: Draw( void )
 	Render_Basic_Clear();
 }
 
+/* *** *** *** *** *** *** cSurfaceListRequest *** *** *** *** *** *** *** *** *** *** *** */
+
+cSurface_List_Request :: cSurface_List_Request( void )
+: cRenderRequest()
+{
+	type = REND_SURFACE_LIST;
+	texture_id = 0;
+
+	tex_x1 = 0.0f;
+	tex_y1 = 0.0f;
+	tex_x2 = 1.0f;
+	tex_y2 = 1.0f;
+
+	w = 0.0f;
+	h = 0.0f;
+}
+
+cSurface_List_Request :: ~cSurface_List_Request( void )
+{
+
+}
+
+void *cSurface_List_Request :: operator new( size_t size )
+{
+	return Alloc_Request( surface_list_request_pool, size, sizeof(cSurface_List_Request) );
+}
+
+void cSurface_List_Request :: operator delete( void *ptr, size_t size )
+{
+	Free_Request( surface_list_request_pool, ptr, size, sizeof(cSurface_List_Request) );
+}
+
+void cSurface_List_Request :: Draw( void )
+{
+	cSurface_Request request;
+
+	for( ItemList::const_iterator itr = items.begin(), itr_end = items.end(); itr != itr_end; ++itr )
+	{
+		Set_Item_Request( &request, (*itr) );
+		request.Draw();
+	}
+}
+
+void cSurface_List_Request :: Set_Item_Request( cSurface_Request *request, const cItem &item ) const
+{
+	// shared settings
+	request->globalscale = globalscale;
+	request->no_camera = no_camera;
+	request->blend_sfactor = blend_sfactor;
+	request->blend_dfactor = blend_dfactor;
+	request->combine_type = combine_type;
+	request->combine_col[0] = combine_col[0];
+	request->combine_col[1] = combine_col[1];
+	request->combine_col[2] = combine_col[2];
+
+	// texture
+	request->texture_id = texture_id;
+	request->tex_x1 = tex_x1;
+	request->tex_y1 = tex_y1;
+	request->tex_x2 = tex_x2;
+	request->tex_y2 = tex_y2;
+	request->w = w;
+	request->h = h;
+
+	// item
+	request->pos_x = item.pos_x;
+	request->pos_y = item.pos_y;
+	request->pos_z = item.pos_z;
+	request->scale_x = item.scale_x;
+	request->scale_y = item.scale_y;
+	request->rotx = item.rotx;
+	request->roty = item.roty;
+	request->rotz = item.rotz;
+	request->color = item.color;
+}
+
+/* *** *** *** *** *** *** cRender_Batch *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Set the mirror factor for the given x or y rotation
+ * returns false if the rotation is not a multiple of 180 degrees
+*/
+static bool Get_Rotation_Mirror( float rot, float &mirror )
+{
+	const float rest = fmod( fabs( rot ), 360.0f );
+
+	if( rest == 0.0f )
+	{
+		mirror = 1.0f;
+		return 1;
+	}
+	if( rest == 180.0f )
+	{
+		mirror = -1.0f;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* Add the transformed quad of the request
+ * view : if set the camera position and global scale are applied
+*/
+static void Add_Quad_Vertices( RenderVertexList &vertices, const cSurface_Request *request, float offset, float pos_z, float mirror_x, float mirror_y, const Color &color, bool view )
+{
+	// get half the size
+	const float half_w = request->w / 2;
+	const float half_h = request->h / 2;
+	// center position
+	float center_x = request->pos_x + offset + ( half_w * request->scale_x );
+	float center_y = request->pos_y + offset + ( half_h * request->scale_y );
+
+	// set camera position
+	if( view && !request->no_camera )
+	{
+		center_x -= pActive_Camera->x;
+		center_y -= pActive_Camera->y;
+	}
+
+	// global scale
+	float global_x = 1.0f;
+	float global_y = 1.0f;
+
+	if( view && request->globalscale )
+	{
+		global_x = global_upscalex;
+		global_y = global_upscaley;
+	}
+
+	// z rotation
+	float rot_sin = 0.0f;
+	float rot_cos = 1.0f;
+
+	if( request->rotz != 0.0f )
+	{
+		const float rad = request->rotz * static_cast<float>(M_PI / 180.0f);
+		rot_sin = sin( rad );
+		rot_cos = cos( rad );
+	}
+
+	// top left, top right, bottom right, bottom left
+	static const float corner_x[4] = { -1.0f, 1.0f, 1.0f, -1.0f };
+	static const float corner_y[4] = { -1.0f, -1.0f, 1.0f, 1.0f };
+
+	for( unsigned int i = 0; i < 4; i++ )
+	{
+		const float x = corner_x[i] * half_w;
+		const float y = corner_y[i] * half_h;
+
+		cRender_Vertex vertex;
+		// the z rotation is applied before the x and y mirroring
+		vertex.x = ( center_x + ( ( ( x * rot_cos ) - ( y * rot_sin ) ) * mirror_x * request->scale_x ) ) * global_x;
+		vertex.y = ( center_y + ( ( ( x * rot_sin ) + ( y * rot_cos ) ) * mirror_y * request->scale_y ) ) * global_y;
+		vertex.z = pos_z;
+		vertex.u = corner_x[i] < 0.0f ? request->tex_x1 : request->tex_x2;
+		vertex.v = corner_y[i] < 0.0f ? request->tex_y1 : request->tex_y2;
+		vertex.r = color.red;
+		vertex.g = color.green;
+		vertex.b = color.blue;
+		vertex.a = color.alpha;
+
+		vertices.push_back( vertex );
+	}
+}
+
+// Draw the textured quads with the current texture and matrix
+static void Draw_Vertices( const cRender_Vertex *data, unsigned int count )
+{
+	glEnableClientState( GL_VERTEX_ARRAY );
+	glEnableClientState( GL_TEXTURE_COORD_ARRAY );
+	glEnableClientState( GL_COLOR_ARRAY );
+
+	glVertexPointer( 3, GL_FLOAT, sizeof(cRender_Vertex), &data->x );
+	glTexCoordPointer( 2, GL_FLOAT, sizeof(cRender_Vertex), &data->u );
+	glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof(cRender_Vertex), &data->r );
+
+	glDrawArrays( GL_QUADS, 0, static_cast<GLsizei>(count) );
+
+	glDisableClientState( GL_COLOR_ARRAY );
+	glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+	glDisableClientState( GL_VERTEX_ARRAY );
+
+	// the current color is undefined after using a color array
+	glColor4f( 1.0f, 1.0f, 1.0f, 1.0f );
+}
+
+cRender_Batch :: cRender_Batch( void )
+{
+	m_draw_calls = 0;
+
+	m_texture_id = 0;
+	m_blend_sfactor = GL_SRC_ALPHA;
+	m_blend_dfactor = GL_ONE_MINUS_SRC_ALPHA;
+	m_combine_type = 0;
+	m_combine_col[0] = 0.0f;
+	m_combine_col[1] = 0.0f;
+	m_combine_col[2] = 0.0f;
+
+	m_vertices.reserve( 4000 );
+}
+
+cRender_Batch :: ~cRender_Batch( void )
+{
+	//
+}
+
+bool cRender_Batch :: Add( const cSurface_Request *request )
+{
+	float mirror_x, mirror_y;
+
+	// only x and y rotations which mirror the image are possible without the matrix
+	if( !Get_Rotation_Mirror( request->roty, mirror_x ) || !Get_Rotation_Mirror( request->rotx, mirror_y ) )
+	{
+		return 0;
+	}
+
+	// shadow
+	if( request->shadow_pos )
+	{
+		// shadow as a black texture with the shadow_color alpha
+		Color shadow_color = black;
+		shadow_color.alpha = request->shadow_color.alpha;
+
+		float shadow_combine_col[3];
+		shadow_combine_col[0] = static_cast<float>(request->shadow_color.red) / 260;
+		shadow_combine_col[1] = static_cast<float>(request->shadow_color.green) / 260;
+		shadow_combine_col[2] = static_cast<float>(request->shadow_color.blue) / 260;
+
+		Add_Quad( request, request->shadow_pos, request->pos_z - 0.000001f, mirror_x, mirror_y, shadow_color, GL_REPLACE, shadow_combine_col );
+	}
+
+	Add_Quad( request, 0.0f, request->pos_z, mirror_x, mirror_y, request->color, request->combine_type, request->combine_col );
+
+	return 1;
+}
+
+void cRender_Batch :: Add_Quad( const cSurface_Request *request, float offset, float pos_z, float mirror_x, float mirror_y, const Color &color, GLint combine_type, const float *combine_col )
+{
+	// state changed
+	if( !m_vertices.empty() && ( m_texture_id != request->texture_id || m_blend_sfactor != request->blend_sfactor || m_blend_dfactor != request->blend_dfactor ||
+		m_combine_type != combine_type || ( combine_type != 0 && ( m_combine_col[0] != combine_col[0] || m_combine_col[1] != combine_col[1] || m_combine_col[2] != combine_col[2] ) ) ) )
+	{
+		Flush();
+	}
+
+	if( m_vertices.empty() )
+	{
+		m_texture_id = request->texture_id;
+		m_blend_sfactor = request->blend_sfactor;
+		m_blend_dfactor = request->blend_dfactor;
+		m_combine_type = combine_type;
+		m_combine_col[0] = combine_col[0];
+		m_combine_col[1] = combine_col[1];
+		m_combine_col[2] = combine_col[2];
+	}
+
+	Add_Quad_Vertices( m_vertices, request, offset, pos_z, mirror_x, mirror_y, color, 1 );
+}
+
+void cRender_Batch :: Flush( void )
+{
+	if( m_vertices.empty() )
+	{
+		return;
+	}
+
+	// clear the matrix as the vertices are already transformed
+	glLoadIdentity();
+
+	// blend factor
+	if( m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA )
+	{
+		glBlendFunc( m_blend_sfactor, m_blend_dfactor );
+	}
+
+	// Color Combine
+	if( m_combine_type != 0 )
+	{
+		glTexEnvi( GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE );
+		glTexEnvi( GL_TEXTURE_ENV, GL_COMBINE_RGB, m_combine_type );
+		glTexEnvi( GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_CONSTANT );
+		glTexEnvfv( GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, m_combine_col );
+		glTexEnvi( GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_TEXTURE );
+	}
+
+	if( !glIsEnabled( GL_TEXTURE_2D ) )
+	{
+		glEnable( GL_TEXTURE_2D );
+	}
+
+	// only bind if not the same texture
+	if( last_bind_texture != m_texture_id )
+	{
+		glBindTexture( GL_TEXTURE_2D, m_texture_id );
+		last_bind_texture = m_texture_id;
+	}
+
+	Draw_Vertices( &m_vertices[0], static_cast<unsigned int>(m_vertices.size()) );
+	m_draw_calls++;
+
+	// clear color modifications
+	if( m_combine_type != 0 )
+	{
+		float col[3] = { 0.0f, 0.0f, 0.0f };
+		glTexEnvfv( GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, col );
+		glTexEnvi( GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_MODULATE );
+		glTexEnvi( GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE );
+	}
+
+	// clear blend factor
+	if( m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA )
+	{
+		glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+	}
+
+	m_vertices.clear();
+}
+
+/* *** *** *** *** *** *** cVertex_Array *** *** *** *** *** *** *** *** *** *** *** */
+
+cVertex_Array :: cVertex_Array( void )
+{
+	//
+}
+
+cVertex_Array :: ~cVertex_Array( void )
+{
+	//
+}
+
+bool cVertex_Array :: Add( const cSurface_Request *request )
+{
+	// only the default state
+	if( !request->texture_id || request->no_camera || !request->globalscale || request->shadow_pos || request->combine_type != 0 ||
+		request->blend_sfactor != GL_SRC_ALPHA || request->blend_dfactor != GL_ONE_MINUS_SRC_ALPHA )
+	{
+		return 0;
+	}
+
+	float mirror_x, mirror_y;
+
+	// only x and y rotations which mirror the image are possible without the matrix
+	if( !Get_Rotation_Mirror( request->roty, mirror_x ) || !Get_Rotation_Mirror( request->rotx, mirror_y ) )
+	{
+		return 0;
+	}
+
+	// texture or z position changed
+	if( m_runs.empty() || m_runs.back().texture_id != request->texture_id || m_runs.back().pos_z != request->pos_z )
+	{
+		cRun run;
+		run.texture_id = request->texture_id;
+		run.pos_z = request->pos_z;
+		run.start = static_cast<unsigned int>(m_vertices.size());
+		run.count = 0;
+		m_runs.push_back( run );
+	}
+
+	Add_Quad_Vertices( m_vertices, request, 0.0f, request->pos_z, mirror_x, mirror_y, request->color, 0 );
+	m_runs.back().count += 4;
+
+	return 1;
+}
+
+void cVertex_Array :: Clear( void )
+{
+	m_runs.clear();
+	m_vertices.clear();
+}
+
+void cVertex_Array :: Draw( unsigned int run_start, unsigned int run_count ) const
+{
+	if( run_count == 0 || run_start + run_count > m_runs.size() )
+	{
+		return;
+	}
+
+	// the vertices are in level coordinates
+	glLoadIdentity();
+	glScalef( global_upscalex, global_upscaley, 1.0f );
+	glTranslatef( -pActive_Camera->x, -pActive_Camera->y, 0.0f );
+
+	if( !glIsEnabled( GL_TEXTURE_2D ) )
+	{
+		glEnable( GL_TEXTURE_2D );
+	}
+
+	for( RunList::const_iterator itr = m_runs.begin() + run_start, itr_end = m_runs.begin() + run_start + run_count; itr != itr_end; ++itr )
+	{
+		const cRun &run = (*itr);
+
+		// only bind if not the same texture
+		if( last_bind_texture != run.texture_id )
+		{
+			glBindTexture( GL_TEXTURE_2D, run.texture_id );
+			last_bind_texture = run.texture_id;
+		}
+
+		Draw_Vertices( &m_vertices[run.start], run.count );
+	}
+}
+
+/* *** *** *** *** *** *** cVertex_Array_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+cVertex_Array_Request :: cVertex_Array_Request( void )
+: cRenderRequest()
+{
+	type = REND_VERTEX_ARRAY;
+	m_array = NULL;
+	m_run_start = 0;
+	m_run_count = 0;
+}
+
+cVertex_Array_Request :: ~cVertex_Array_Request( void )
+{
+	//
+}
+
+void *cVertex_Array_Request :: operator new( size_t size )
+{
+	return Alloc_Request( vertex_array_request_pool, size, sizeof(cVertex_Array_Request) );
+}
+
+void cVertex_Array_Request :: operator delete( void *ptr, size_t size )
+{
+	Free_Request( vertex_array_request_pool, ptr, size, sizeof(cVertex_Array_Request) );
+}
+
+void cVertex_Array_Request :: Draw( void )
+{
+	if( m_array )
+	{
+		m_array->Draw( m_run_start, m_run_count );
+	}
+}
+
 /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
 
 cRenderQueue :: cRenderQueue( unsigned int reserve_items )
 {
 	renderdata.reserve( reserve_items );
+	m_batch_enabled = 1;
 }
 
 cRenderQueue :: ~cRenderQueue( void )
@@ -707,10 +1236,13 @@ void cRenderQueue :: Add( cRenderRequest *obj )
 
 void cRenderQueue :: Render( bool clear /* = 1 */ )
 {
+	cProfiler_Zone zone( PERF_RENDER_QUEUE );
+
 	// z position sort
 	std::sort( renderdata.begin(), renderdata.end(), zpos_sort() );
 	// reset last texture
 	last_bind_texture = 0;
+	m_batch.m_draw_calls = 0;
 
 	// draw
 	for( RenderList::iterator itr = renderdata.begin(), itr_end = renderdata.end(); itr != itr_end; ++itr )
@@ -718,10 +1250,40 @@ void cRenderQueue :: Render( bool clear /* = 1 */ )
 		// get object pointer
 		cRenderRequest *obj = (*itr);
 
-		obj->Draw();
 		obj->render_count--;
+
+		// add to the batch
+		if( m_batch_enabled && obj->type == REND_SURFACE && m_batch.Add( static_cast<cSurface_Request *>(obj) ) )
+		{
+			continue;
+		}
+
+		// add all items to the batch
+		if( m_batch_enabled && obj->type == REND_SURFACE_LIST )
+		{
+			cSurface_List_Request *list = static_cast<cSurface_List_Request *>(obj);
+
+			for( cSurface_List_Request::ItemList::const_iterator item_itr = list->items.begin(), item_itr_end = list->items.end(); item_itr != item_itr_end; ++item_itr )
+			{
+				list->Set_Item_Request( &m_item_request, (*item_itr) );
+
+				if( !m_batch.Add( &m_item_request ) )
+				{
+					m_batch.Flush();
+					m_item_request.Draw();
+				}
+			}
+
+			continue;
+		}
+
+		// draw the batch first to keep the z order
+		m_batch.Flush();
+		obj->Draw();
 	}
 
+	m_batch.Flush();
+
 	// clear
 	if( clear )
 	{
@@ -731,7 +1293,9 @@ void cRenderQueue :: Render( bool clear /* = 1 */ )
 
 void cRenderQueue :: Clear( bool force /* = 1 */ )
 {
-	for( RenderList::iterator itr = renderdata.begin(); itr != renderdata.end(); )
+	RenderList::iterator valid_itr = renderdata.begin();
+
+	for( RenderList::iterator itr = renderdata.begin(), itr_end = renderdata.end(); itr != itr_end; ++itr )
 	{
 		// get object pointer
 		cRenderRequest *obj = (*itr);
@@ -739,15 +1303,16 @@ void cRenderQueue :: Clear( bool force /* = 1 */ )
 		// if forced or finished rendering
 		if( force || obj->render_count <= 0 )
 		{
-			itr = renderdata.erase( itr );
 			delete obj;
+			continue;
 		}
-		// increment
-		else
-		{
-			++itr;
-		}
+
+		// keep
+		*valid_itr = obj;
+		++valid_itr;
 	}
+
+	renderdata.erase( valid_itr, renderdata.end() );
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
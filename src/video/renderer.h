@@ -33,7 +33,9 @@ enum RenderType
 	REND_SURFACE = 3,
 	REND_TEXT = 4, // todo
 	REND_LINE = 5,
-	REND_CIRCLE = 6
+	REND_CIRCLE = 6,
+	REND_SURFACE_LIST = 7,
+	REND_VERTEX_ARRAY = 8
 };
 
 /* *** *** *** *** *** *** cRenderRequest *** *** *** *** *** *** *** *** *** *** *** */
@@ -107,6 +109,10 @@ public:
 	float line_width;
 	// stipple pattern
 	GLushort stipple_pattern;
+
+	// allocate from the line request memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
 };
 
 /* *** *** *** *** *** *** cRectRequest *** *** *** *** *** *** *** *** *** *** *** */
@@ -133,6 +139,10 @@ public:
 	float line_width;
 	// stipple pattern (only used if not filled)
 	GLushort stipple_pattern;
+
+	// allocate from the rect request memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
 };
 
 /* *** *** *** *** *** *** cGradientRequest *** *** *** *** *** *** *** *** *** *** *** */
@@ -153,6 +163,10 @@ public:
 	// colors
 	Color color_1;
 	Color color_2;
+
+	// allocate from the gradient request memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
 };
 
 /* *** *** *** *** *** *** cCircleRequest *** *** *** *** *** *** *** *** *** *** *** */
@@ -173,6 +187,10 @@ public:
 	float radius;
 	// if set circle is not filled
 	float line_width;
+
+	// allocate from the circle request memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
 };
 
 /* *** *** *** *** *** *** cSurfaceRequest *** *** *** *** *** *** *** *** *** *** *** */
@@ -188,6 +206,8 @@ public:
 
 	// texture id
 	GLuint texture_id;
+	// texture coordinates
+	float tex_x1, tex_y1, tex_x2, tex_y2;
 	// position
 	float pos_x, pos_y;
 	// scale
@@ -202,6 +222,165 @@ public:
 
 	// delete texture after request finished
 	bool delete_texture;
+
+	// allocate from the surface request memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
+};
+
+/* *** *** *** *** *** *** cSurfaceListRequest *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Draws the same texture at multiple positions
+ * The request settings like blending are used for all items.
+*/
+class cSurface_List_Request : public cRenderRequest
+{
+public:
+	cSurface_List_Request( void );
+	virtual ~cSurface_List_Request( void );
+
+	// Draw
+	virtual void Draw( void );
+
+	// surface item
+	struct cItem
+	{
+		// position
+		float pos_x, pos_y, pos_z;
+		// scale
+		float scale_x, scale_y;
+		// rotation
+		float rotx, roty, rotz;
+		// color
+		Color color;
+	};
+
+	typedef vector<cItem> ItemList;
+
+	// Set the given surface request to the item
+	void Set_Item_Request( cSurface_Request *request, const cItem &item ) const;
+
+	// texture id
+	GLuint texture_id;
+	// texture coordinates
+	float tex_x1, tex_y1, tex_x2, tex_y2;
+	// size
+	float w, h;
+
+	// items
+	ItemList items;
+
+	// allocate from the surface list request memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
+};
+
+/* *** *** *** *** *** *** cRender_Vertex *** *** *** *** *** *** *** *** *** *** *** */
+
+// vertex array data
+struct cRender_Vertex
+{
+	GLfloat x, y, z;
+	GLfloat u, v;
+	GLubyte r, g, b, a;
+};
+
+typedef vector<cRender_Vertex> RenderVertexList;
+
+/* *** *** *** *** *** *** cRender_Batch *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Collects surface requests into a vertex array
+ * Consecutive quads with the same texture, blending and color combine state
+ * are drawn with one draw call. The transformation is calculated on the cpu.
+*/
+class cRender_Batch
+{
+public:
+	cRender_Batch( void );
+	~cRender_Batch( void );
+
+	/* Add the surface request and its shadow
+	 * returns false if the request can not be batched and was not added
+	*/
+	bool Add( const cSurface_Request *request );
+	// Draw the collected quads
+	void Flush( void );
+
+	// draw calls since the last reset
+	unsigned int m_draw_calls;
+
+private:
+	// Add a quad with the given state
+	void Add_Quad( const cSurface_Request *request, float offset, float pos_z, float mirror_x, float mirror_y, const Color &color, GLint combine_type, const float *combine_col );
+
+	RenderVertexList m_vertices;
+
+	// state of the collected quads
+	GLuint m_texture_id;
+	GLenum m_blend_sfactor;
+	GLenum m_blend_dfactor;
+	GLint m_combine_type;
+	float m_combine_col[3];
+};
+
+/* *** *** *** *** *** *** cVertex_Array *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Prebuilt quads in level coordinates
+ * Only surface requests with the default blending and no color combine or shadow can be added.
+ * Consecutive quads with the same texture and z position are drawn with one draw call.
+*/
+class cVertex_Array
+{
+public:
+	cVertex_Array( void );
+	~cVertex_Array( void );
+
+	/* Add the quad of the surface request
+	 * returns false if the request state or rotation can not be added
+	*/
+	bool Add( const cSurface_Request *request );
+	// Remove all quads
+	void Clear( void );
+	// Draw the quads of the given runs with the camera position and global scale
+	void Draw( unsigned int run_start, unsigned int run_count ) const;
+
+	// quads with the same texture and z position
+	struct cRun
+	{
+		GLuint texture_id;
+		float pos_z;
+		unsigned int start;
+		unsigned int count;
+	};
+
+	typedef vector<cRun> RunList;
+	RunList m_runs;
+	RenderVertexList m_vertices;
+};
+
+/* *** *** *** *** *** *** cVertex_Array_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Draws a prebuilt vertex array
+ * the array is not copied and must be valid until the request is rendered
+*/
+class cVertex_Array_Request : public cRenderRequest
+{
+public:
+	cVertex_Array_Request( void );
+	virtual ~cVertex_Array_Request( void );
+
+	// Draw
+	virtual void Draw( void );
+
+	// vertex array
+	const cVertex_Array *m_array;
+	// drawn runs of the array
+	unsigned int m_run_start;
+	unsigned int m_run_count;
+
+	// allocate from the vertex array request memory pool
+	static void *operator new( size_t size );
+	static void operator delete( void *ptr, size_t size );
 };
 
 /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
@@ -222,12 +401,20 @@ public:
 
 	/* clear the render data
 	 * if force is given all objects will be removed
+	 * the not finished requests keep their order
 	*/
 	void Clear( bool force = 1 );
 
 	// renderdata array
 	RenderList renderdata;
 
+	// if set surface requests are drawn batched
+	bool m_batch_enabled;
+	// surface request batch
+	cRender_Batch m_batch;
+	// request for the surface list items
+	cSurface_Request m_item_request;
+
 	// Z position sort
 	struct zpos_sort
 	{
@@ -0,0 +1,251 @@
+/***************************************************************************
+ * texture_atlas.cpp  -  packs small images into shared textures
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/texture_atlas.h"
+#include "../video/gl_surface.h"
+#include "../video/video.h"
+#include "../video/img_manager.h"
+#include <cstring>
+
+namespace SMC
+{
+
+// default atlas texture width and height
+static const unsigned int atlas_default_page_size = 1024;
+// border around each image
+static const unsigned int atlas_border = 1;
+
+/* *** *** *** *** *** *** cTexture_Atlas *** *** *** *** *** *** *** *** *** *** *** */
+
+cTexture_Atlas :: cTexture_Atlas( void )
+{
+	m_max_image_size = 128;
+	m_page_size = 0;
+}
+
+cTexture_Atlas :: ~cTexture_Atlas( void )
+{
+	// textures are deleted with the OpenGL context
+	Clear( 0 );
+}
+
+bool cTexture_Atlas :: Add( cGL_Surface *image, const void *pixels, unsigned int width, unsigned int height, unsigned int row_length )
+{
+	if( !image || !pixels || !width || !height || width > m_max_image_size || height > m_max_image_size )
+	{
+		return 0;
+	}
+
+	// size with border
+	const unsigned int full_width = width + ( atlas_border * 2 );
+	const unsigned int full_height = height + ( atlas_border * 2 );
+
+	// find space
+	cAtlas_Page *page = NULL;
+	unsigned int x = 0;
+	unsigned int y = 0;
+
+	for( AtlasPageList::iterator itr = m_pages.begin(), itr_end = m_pages.end(); itr != itr_end; ++itr )
+	{
+		if( Find_Space( *itr, full_width, full_height, x, y ) )
+		{
+			page = &(*itr);
+			break;
+		}
+	}
+
+	// no space found
+	if( !page )
+	{
+		if( !Add_Page() || !Find_Space( m_pages.back(), full_width, full_height, x, y ) )
+		{
+			return 0;
+		}
+
+		page = &m_pages.back();
+	}
+
+	// copy pixels with the edge pixels repeated in the border
+	m_buffer.resize( full_width * full_height * 4 );
+	const Uint8 *src = static_cast<const Uint8 *>(pixels);
+
+	for( unsigned int dst_y = 0; dst_y < full_height; dst_y++ )
+	{
+		unsigned int src_y = dst_y > atlas_border ? dst_y - atlas_border : 0;
+
+		if( src_y >= height )
+		{
+			src_y = height - 1;
+		}
+
+		const Uint8 *src_row = src + ( src_y * row_length * 4 );
+		Uint8 *dst_row = &m_buffer[dst_y * full_width * 4];
+
+		// left border
+		memcpy( dst_row, src_row, 4 );
+		// image row
+		memcpy( dst_row + ( atlas_border * 4 ), src_row, width * 4 );
+		// right border
+		memcpy( dst_row + ( ( full_width - 1 ) * 4 ), src_row + ( ( width - 1 ) * 4 ), 4 );
+	}
+
+	// upload
+	glBindTexture( GL_TEXTURE_2D, page->texture_id );
+	glTexSubImage2D( GL_TEXTURE_2D, 0, x, y, full_width, full_height, GL_RGBA, GL_UNSIGNED_BYTE, &m_buffer[0] );
+
+	// set image data
+	const float page_size = static_cast<float>(m_page_size);
+
+	image->m_image = page->texture_id;
+	image->m_tex_x1 = static_cast<float>(x + atlas_border) / page_size;
+	image->m_tex_y1 = static_cast<float>(y + atlas_border) / page_size;
+	image->m_tex_x2 = static_cast<float>(x + atlas_border + width) / page_size;
+	image->m_tex_y2 = static_cast<float>(y + atlas_border + height) / page_size;
+	image->m_atlas = 1;
+
+	return 1;
+}
+
+bool cTexture_Atlas :: Is_Atlas_Texture( GLuint texture_id ) const
+{
+	for( AtlasPageList::const_iterator itr = m_pages.begin(), itr_end = m_pages.end(); itr != itr_end; ++itr )
+	{
+		if( (*itr).texture_id == texture_id )
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+Uint64 cTexture_Atlas :: Get_Texture_Size( void ) const
+{
+	return static_cast<Uint64>(m_pages.size()) * m_page_size * m_page_size * 4;
+}
+
+void cTexture_Atlas :: Clear( bool delete_textures /* = 1 */ )
+{
+	if( delete_textures )
+	{
+		for( AtlasPageList::iterator itr = m_pages.begin(), itr_end = m_pages.end(); itr != itr_end; ++itr )
+		{
+			if( glIsTexture( (*itr).texture_id ) )
+			{
+				glDeleteTextures( 1, &(*itr).texture_id );
+			}
+		}
+	}
+
+	m_pages.clear();
+	m_buffer.clear();
+}
+
+bool cTexture_Atlas :: Add_Page( void )
+{
+	// get the size
+	if( !m_page_size )
+	{
+		int size = atlas_default_page_size;
+		int size_h = atlas_default_page_size;
+		pVideo->Apply_Max_Texture_Size( size, size_h );
+		m_page_size = std::min( size, size_h );
+	}
+
+	// too small for the images
+	if( m_page_size < m_max_image_size + ( atlas_border * 2 ) )
+	{
+		return 0;
+	}
+
+	cAtlas_Page page;
+	page.texture_id = 0;
+	page.height = 0;
+
+	glGenTextures( 1, &page.texture_id );
+
+	// if image id is 0 it failed
+	if( !page.texture_id )
+	{
+		printf( "Error : GL atlas image generation failed\n" );
+		return 0;
+	}
+
+	// set highest texture id
+	if( pImage_Manager->high_texture_id < page.texture_id )
+	{
+		pImage_Manager->high_texture_id = page.texture_id;
+	}
+
+	glBindTexture( GL_TEXTURE_2D, page.texture_id );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+	// create empty texture
+	pVideo->Create_GL_Texture( m_page_size, m_page_size, NULL );
+
+	m_pages.push_back( page );
+	return 1;
+}
+
+bool cTexture_Atlas :: Find_Space( cAtlas_Page &page, unsigned int width, unsigned int height, unsigned int &x, unsigned int &y )
+{
+	// find a row with enough space and the least wasted height
+	cAtlas_Row *best_row = NULL;
+
+	for( AtlasRowList::iterator itr = page.rows.begin(), itr_end = page.rows.end(); itr != itr_end; ++itr )
+	{
+		cAtlas_Row &row = (*itr);
+
+		if( row.height < height || row.width + width > m_page_size )
+		{
+			continue;
+		}
+
+		if( !best_row || row.height < best_row->height )
+		{
+			best_row = &row;
+		}
+	}
+
+	// create a new row
+	if( !best_row )
+	{
+		if( page.height + height > m_page_size )
+		{
+			return 0;
+		}
+
+		cAtlas_Row row;
+		row.y = page.height;
+		row.height = height;
+		row.width = 0;
+
+		page.rows.push_back( row );
+		page.height += height;
+		best_row = &page.rows.back();
+	}
+
+	x = best_row->width;
+	y = best_row->y;
+	best_row->width += width;
+
+	return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
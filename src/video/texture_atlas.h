@@ -0,0 +1,100 @@
+/***************************************************************************
+ * texture_atlas.h  -  header for the corresponding cpp file
+ *
+ * Copyright (C) 2009 Florian Richter
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_TEXTURE_ATLAS_H
+#define SMC_TEXTURE_ATLAS_H
+
+#include "../core/globals.h"
+// SDL
+#include "SDL.h"
+#include "SDL_opengl.h"
+
+namespace SMC
+{
+
+/* *** *** *** *** *** cTexture_Atlas *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Packs small images into shared textures
+ * Each image gets a one pixel border with its edge pixels to prevent
+ * filtering with the neighbour images. The images are stored in rows
+ * and the space is only given back if the atlas is cleared.
+*/
+class cTexture_Atlas
+{
+public:
+	cTexture_Atlas( void );
+	~cTexture_Atlas( void );
+
+	/* Add the image pixels to an atlas texture and set the surface texture data
+	 * pixels : 32 bit RGBA data
+	 * row_length : pixels per row in the data
+	 * returns false if the image is too big or could not be added
+	*/
+	bool Add( cGL_Surface *image, const void *pixels, unsigned int width, unsigned int height, unsigned int row_length );
+
+	// Check if the given texture is an atlas texture
+	bool Is_Atlas_Texture( GLuint texture_id ) const;
+	// Return the size of all atlas textures in bytes
+	Uint64 Get_Texture_Size( void ) const;
+
+	/* Remove all images
+	 * delete_textures : if set delete the atlas textures
+	*/
+	void Clear( bool delete_textures = 1 );
+
+	// maximum image width and height added to the atlas
+	unsigned int m_max_image_size;
+
+private:
+	// row of images
+	struct cAtlas_Row
+	{
+		unsigned int y;
+		unsigned int height;
+		// used width
+		unsigned int width;
+	};
+
+	typedef vector<cAtlas_Row> AtlasRowList;
+
+	// atlas texture
+	struct cAtlas_Page
+	{
+		GLuint texture_id;
+		AtlasRowList rows;
+		// used height
+		unsigned int height;
+	};
+
+	typedef vector<cAtlas_Page> AtlasPageList;
+
+	// Create a new atlas texture
+	bool Add_Page( void );
+	// Find space in the given page and return true if found
+	bool Find_Space( cAtlas_Page &page, unsigned int width, unsigned int height, unsigned int &x, unsigned int &y );
+
+	// atlas texture width and height
+	unsigned int m_page_size;
+	// atlas textures
+	AtlasPageList m_pages;
+	// pixel data with border
+	vector<Uint8> m_buffer;
+};
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
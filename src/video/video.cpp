@@ -17,6 +17,7 @@
 #include "../gui/hud.h"
 #include "../user/preferences.h"
 #include "../core/framerate.h"
+#include "../core/profiler.h"
 #include "../video/font.h"
 #include "../core/game_core.h"
 #include "../video/img_settings.h"
@@ -28,6 +29,8 @@
 #include "../core/math/size.h"
 #include "../core/filesystem/filesystem.h"
 #include "../core/filesystem/resource_manager.h"
+#include "../level/level_preloader.h"
+#include "../core/worker_pool.h"
 // SDL
 #include "SDL_opengl.h"
 // CEGUI
@@ -41,6 +44,7 @@ namespace fs = boost::filesystem;
 #ifndef PNG_COLOR_TYPE_RGBA
 	#define PNG_COLOR_TYPE_RGBA PNG_COLOR_TYPE_RGB_ALPHA
 #endif
+#include <algorithm>
 
 namespace SMC
 {
@@ -101,18 +105,230 @@ CEGUI::colour Color :: Get_cegui_Color( void ) const
 	return CEGUI::colour( static_cast<float>(red) / 255, static_cast<float>(green) / 255, static_cast<float>(blue) / 255, static_cast<float>(alpha) / 255 );
 }
 
+/* *** *** *** *** *** *** *** CEGUI texture fake class *** *** *** *** *** *** *** *** *** *** */
+
+cFake_Texture :: cFake_Texture( CEGUI::Renderer *owner, unsigned int size /* = 0 */ )
+: CEGUI::Texture( owner )
+{
+	m_width = static_cast<CEGUI::ushort>(size);
+	m_height = static_cast<CEGUI::ushort>(size);
+}
+
+cFake_Texture :: ~cFake_Texture( void )
+{
+
+}
+
+void cFake_Texture :: loadFromFile( const CEGUI::String &filename, const CEGUI::String &resourceGroup )
+{
+	CEGUI::ResourceProvider *rp = CEGUI::System::getSingleton().getResourceProvider();
+	CEGUI::RawDataContainer data;
+	rp->loadRawDataContainer( filename, data, resourceGroup );
+
+	// decode to get the size
+	SDL_Surface *surface = IMG_Load_RW( SDL_RWFromConstMem( data.getDataPtr(), static_cast<int>(data.getSize()) ), 1 );
+
+	if( surface )
+	{
+		m_width = static_cast<CEGUI::ushort>(surface->w);
+		m_height = static_cast<CEGUI::ushort>(surface->h);
+		SDL_FreeSurface( surface );
+	}
+	else
+	{
+		printf( "Warning : Fake texture could not load %s\n", filename.c_str() );
+	}
+
+	rp->unloadRawDataContainer( data );
+}
+
+void cFake_Texture :: loadFromMemory( const void *buffPtr, CEGUI::uint buffWidth, CEGUI::uint buffHeight, CEGUI::Texture::PixelFormat pixelFormat )
+{
+	m_width = static_cast<CEGUI::ushort>(buffWidth);
+	m_height = static_cast<CEGUI::ushort>(buffHeight);
+}
+
 /* *** *** *** *** *** *** *** CEGUI renderer fake class *** *** *** *** *** *** *** *** *** *** */
 
 cFake_Renderer :: cFake_Renderer( void )
+: m_display_size( 800, 600 )
 {
 	d_identifierString = "Fake Renderer";
 }
 
 cFake_Renderer :: ~cFake_Renderer( void )
 {
+	destroyAllTextures();
+}
+
+CEGUI::Texture *cFake_Renderer :: createTexture( void )
+{
+	cFake_Texture *texture = new cFake_Texture( this );
+	m_textures.push_back( texture );
+	return texture;
+}
+
+CEGUI::Texture *cFake_Renderer :: createTexture( const CEGUI::String &filename, const CEGUI::String &resourceGroup )
+{
+	cFake_Texture *texture = new cFake_Texture( this );
+	texture->loadFromFile( filename, resourceGroup );
+	m_textures.push_back( texture );
+	return texture;
+}
+
+CEGUI::Texture *cFake_Renderer :: createTexture( float size )
+{
+	cFake_Texture *texture = new cFake_Texture( this, static_cast<unsigned int>(size) );
+	m_textures.push_back( texture );
+	return texture;
+}
+
+void cFake_Renderer :: destroyTexture( CEGUI::Texture *texture )
+{
+	Fake_Texture_List::iterator itr = std::find( m_textures.begin(), m_textures.end(), texture );
+
+	if( itr == m_textures.end() )
+	{
+		return;
+	}
+
+	delete *itr;
+	m_textures.erase( itr );
+}
+
+void cFake_Renderer :: destroyAllTextures( void )
+{
+	for( Fake_Texture_List::iterator itr = m_textures.begin(), itr_end = m_textures.end(); itr != itr_end; ++itr )
+	{
+		delete *itr;
+	}
 
+	m_textures.clear();
 }
 
+/* *** *** *** *** *** *** *** Image jobs *** *** *** *** *** *** *** *** *** *** */
+
+// Decodes an image in a worker thread
+class cImage_Decode_Job : public cWorker_Job
+{
+public:
+	cImage_Decode_Job( void )
+	{
+		m_settings = NULL;
+		m_surface = NULL;
+	};
+
+	virtual ~cImage_Decode_Job( void )
+	{
+		if( m_settings )
+		{
+			delete m_settings;
+		}
+
+		if( m_surface )
+		{
+			SDL_FreeSurface( m_surface );
+		}
+	};
+
+	// Set the files to load like cVideo::Load_Image and load the settings
+	void Init( const std::string &filename )
+	{
+		m_filename = filename;
+		m_settings = pVideo->Load_Image_Settings( filename );
+		m_image_file = pVideo->Get_Image_File( filename, m_settings );
+
+		// if the image cache file fails and not set in image settings
+		if( m_image_file.compare( filename ) != 0 && File_Exists( filename ) && ( !m_settings || m_settings->m_base.empty() ) )
+		{
+			m_fallback_file = filename;
+		}
+	};
+
+	virtual void Run( void )
+	{
+		if( !m_image_file.empty() )
+		{
+			m_surface = IMG_Load( m_image_file.c_str() );
+		}
+
+		if( !m_surface && !m_fallback_file.empty() )
+		{
+			m_surface = IMG_Load( m_fallback_file.c_str() );
+		}
+	};
+
+	// image filename
+	std::string m_filename;
+	// file to decode
+	std::string m_image_file;
+	// file to decode if the image file failed
+	std::string m_fallback_file;
+	// image settings
+	cImage_settings_data *m_settings;
+	// decoded image
+	SDL_Surface *m_surface;
+};
+
+// Decodes, downscales and saves an image into the image cache in a worker thread
+class cImage_Cache_Job : public cImage_Decode_Job
+{
+public:
+	virtual void Run( void )
+	{
+		cImage_Decode_Job::Run();
+
+		// failed to load image
+		if( !m_surface )
+		{
+			printf( "Error loading image : %s\n", m_filename.c_str() );
+			return;
+		}
+
+		// create final image
+		SDL_Surface *sdl_surface = pVideo->Convert_To_Final_Software_Image( m_surface );
+		m_surface = NULL;
+
+		// get final size for this resolution
+		cSize_Float size = m_settings->Get_Surface_Size( sdl_surface );
+		int new_width = static_cast<int>(size.m_width);
+		int new_height = static_cast<int>(size.m_height);
+
+		// apply maximum texture size
+		pVideo->Apply_Max_Texture_Size( new_width, new_height );
+
+		// does not need to be sampled down
+		if( new_width >= sdl_surface->w && new_height >= sdl_surface->h )
+		{
+			SDL_FreeSurface( sdl_surface );
+			return;
+		}
+
+		// calculate block reduction
+		int reduce_block_x = sdl_surface->w / new_width;
+		int reduce_block_y = sdl_surface->h / new_height;
+
+		// create downsampled image
+		unsigned int image_bpp = sdl_surface->format->BytesPerPixel;
+		unsigned char *image_downsampled = new unsigned char[new_width * new_height * image_bpp];
+		bool sampled = pVideo->Downscale_Image( static_cast<unsigned char*>(sdl_surface->pixels), sdl_surface->w, sdl_surface->h, image_bpp, image_downsampled, reduce_block_x, reduce_block_y );
+
+		SDL_FreeSurface( sdl_surface );
+		
+		// if image is available
+		if( sampled )
+		{
+			// save image
+			pVideo->Save_Surface( m_cache_file, image_downsampled, new_width, new_height, image_bpp );
+		}
+
+		delete[] image_downsampled;
+	};
+
+	// image cache filename
+	std::string m_cache_file;
+};
+
 /* *** *** *** *** *** *** *** Video class *** *** *** *** *** *** *** *** *** *** */
 
 cVideo :: cVideo( void )
@@ -133,6 +349,7 @@ cVideo :: cVideo( void )
 	m_geometry_quality = cPreferences::m_geometry_quality_default;
 	m_texture_quality = cPreferences::m_texture_quality_default;
 
+	m_headless = 0;
 	m_initialised = 0;
 }
 
@@ -172,6 +389,22 @@ void cVideo :: Delete_CEGUI_Fake( void ) const
 	delete rp;
 }
 
+void cVideo :: Init_CEGUI_Headless( void ) const
+{
+	CEGUI::DefaultResourceProvider *rp = static_cast<CEGUI::DefaultResourceProvider *>(pGuiSystem->getResourceProvider());
+
+	// set Resource Provider directories
+	rp->setResourceGroupDirectory( "schemes", DATA_DIR "/" GUI_SCHEME_DIR "/" );
+	rp->setResourceGroupDirectory( "imagesets", DATA_DIR "/" GUI_IMAGESET_DIR "/" );
+	rp->setResourceGroupDirectory( "fonts", DATA_DIR "/" GUI_FONT_DIR "/" );
+	rp->setResourceGroupDirectory( "looknfeels", DATA_DIR "/" GUI_LOOKNFEEL_DIR "/" );
+	rp->setResourceGroupDirectory( "layouts", DATA_DIR "/" GUI_LAYOUT_DIR "/" );
+
+	// layout with the preferences resolution
+	cFake_Renderer *renderer = static_cast<cFake_Renderer *>(pGuiSystem->getRenderer());
+	renderer->m_display_size = CEGUI::Size( static_cast<float>(pPreferences->m_video_screen_w), static_cast<float>(pPreferences->m_video_screen_h) );
+}
+
 void cVideo :: Init_CEGUI( void ) const
 {
 	// create renderer
@@ -267,6 +500,12 @@ void cVideo :: Init_CEGUI_Data( void ) const
 
 void cVideo :: Init_SDL( void )
 {
+	// video subsystem without a window for the event queue and timers
+	if( m_headless )
+	{
+		SDL_putenv( const_cast<char *>("SDL_VIDEODRIVER=dummy") );
+	}
+
 	if( SDL_Init( SDL_INIT_VIDEO ) == -1 )
 	{
 		printf( "Error : SDL initialization failed\nReason : %s\n", SDL_GetError() );
@@ -802,7 +1041,12 @@ void cVideo :: Init_Image_Cache( bool recreate /* = 0 */, bool draw_gui /* = 0 *
 	unsigned int loaded_files = 0;
 	unsigned int file_count = image_files.size();
 
-	// create directories, load images and save to cache
+	// decoding, downscaling and saving runs in worker threads
+	cWorker_Pool pool;
+	typedef vector<cImage_Cache_Job *> CacheJobList;
+	CacheJobList jobs;
+
+	// create directories and add the image jobs
 	for( vector<std::string>::iterator itr = image_files.begin(), itr_end = image_files.end(); itr != itr_end; ++itr )
 	{
 		// get filename
@@ -833,14 +1077,15 @@ void cVideo :: Init_Image_Cache( bool recreate /* = 0 */, bool draw_gui /* = 0 *
 			filename.insert( filename.length(), ".png" );
 		}
 
-		// load software image
-		cSoftware_Image software_image = Load_Image( filename );
-		SDL_Surface *sdl_surface = software_image.sdl_surface;
-		cImage_settings_data *settings = software_image.settings;
+		// load settings and get the image file
+		cImage_Cache_Job *job = new cImage_Cache_Job();
+		job->Init( filename );
 
 		// failed to load image
-		if( !sdl_surface )
+		if( job->m_image_file.empty() && job->m_fallback_file.empty() )
 		{
+			printf( "Error loading image : %s\n", filename.c_str() );
+			delete job;
 			continue;
 		}
 
@@ -849,69 +1094,40 @@ void cVideo :: Init_Image_Cache( bool recreate /* = 0 */, bool draw_gui /* = 0 *
 		 * as there is currently no support to get the old and real image size
 		 * and thus the scaled down (cached) image size is used which is wrong
 		*/
-		if( !settings || !settings->m_width || !settings->m_height )
+		if( !job->m_settings || !job->m_settings->m_width || !job->m_settings->m_height )
 		{
 			debug_print( "Info : %s has no image settings image size set and will not get cached\n", cache_filename.c_str() );
-			SDL_FreeSurface( sdl_surface );
+			delete job;
 			continue;
 		}
 
-		// create final image
-		sdl_surface = Convert_To_Final_Software_Image( sdl_surface );
-
-		// get final size for this resolution
-		cSize_Float size = settings->Get_Surface_Size( sdl_surface );
-		delete settings;
-		int new_width = static_cast<int>(size.m_width);
-		int new_height = static_cast<int>(size.m_height);
-
-		// apply maximum texture size
-		Apply_Max_Texture_Size( new_width, new_height );
-
-		// does not need to be sampled down
-		if( new_width >= sdl_surface->w && new_height >= sdl_surface->h )
+		// save as png
+		if( settings_file )
 		{
-			SDL_FreeSurface( sdl_surface );
-			continue;
+			cache_filename.insert( cache_filename.length(), ".png" );
 		}
 
-		// calculate block reduction
-		int reduce_block_x = sdl_surface->w / new_width;
-		int reduce_block_y = sdl_surface->h / new_height;
-
-		// create downsampled image
-		unsigned int image_bpp = sdl_surface->format->BytesPerPixel;
-		unsigned char *image_downsampled = new unsigned char[new_width * new_height * image_bpp];
-		bool sampled = Downscale_Image( static_cast<unsigned char*>(sdl_surface->pixels), sdl_surface->w, sdl_surface->h, image_bpp, image_downsampled, reduce_block_x, reduce_block_y );
-
-		SDL_FreeSurface( sdl_surface );
-		
-		// if image is available
-		if( sampled )
-		{
-			// save as png
-			if( settings_file )
-			{
-				cache_filename.insert( cache_filename.length(), ".png" );
-			}
+		job->m_cache_file = imgcache_dir_active + "/" + cache_filename;
 
-			// save image
-			Save_Surface( imgcache_dir_active + "/" + cache_filename, image_downsampled, new_width, new_height, image_bpp );
-		}
+		jobs.push_back( job );
+		pool.Add( job );
+	}
 
-		delete[] image_downsampled;
+	// wait for the jobs and draw the progress
+	unsigned int finished = 0;
 
-		// count files
-		loaded_files++;
+	while( finished < jobs.size() )
+	{
+		finished = pool.Wait_Finished( finished );
 
 		// draw
 		if( draw_gui )
 		{
 			// update filename
-			cGL_Surface *surface_filename = pFont->Render_Text( pFont->m_font_small, filename, white );
+			cGL_Surface *surface_filename = pFont->Render_Text( pFont->m_font_small, jobs[finished - 1]->m_filename, white );
 
 			// update progress
-			progress_bar->setProgress( static_cast<float>(loaded_files) / static_cast<float>(file_count) );
+			progress_bar->setProgress( static_cast<float>(loaded_files + finished) / static_cast<float>(file_count) );
 			// draw filename
 
 			surface_filename->Blit( game_res_w * 0.2f, game_res_h * 0.8f, 0.1f );
@@ -923,6 +1139,11 @@ void cVideo :: Init_Image_Cache( bool recreate /* = 0 */, bool draw_gui /* = 0 *
 		}
 	}
 
+	for( CacheJobList::iterator itr = jobs.begin(), itr_end = jobs.end(); itr != itr_end; ++itr )
+	{
+		delete *itr;
+	}
+
 	// set back texture detail
 	m_texture_quality = real_texture_detail;
 	// set directory after surfaces got loaded from Load_GL_Surface()
@@ -1001,22 +1222,29 @@ void cVideo :: Clear_Screen( void ) const
 
 void cVideo :: Render( void ) const
 {
-	pRenderer->Render();
+	// nothing to show
+	if( m_headless )
+	{
+		pRenderer->Clear();
+		pRenderer_GUI->Clear();
+		return;
+	}
+
+	cProfiler_Zone zone( PERF_RENDER );
 
-	// update performance timer
-	pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
+	pProfiler->Begin_Zone( PERF_RENDER_GAME );
+	pRenderer->Render();
+	pProfiler->End_Zone();
 
+	pProfiler->Begin_Zone( PERF_RENDER_GUI );
 	pGuiSystem->renderGUI();
 	pRenderer_GUI->Render();
 	pMouseCursor->Render();
+	pProfiler->End_Zone();
 
-	// update performance timer
-	pFramerate->m_perf_timer[PERF_RENDER_GUI]->Update();
-
+	pProfiler->Begin_Zone( PERF_RENDER_BUFFER );
 	SDL_GL_SwapBuffers();
-
-	// update performance timer
-	pFramerate->m_perf_timer[PERF_RENDER_BUFFER]->Update();
+	pProfiler->End_Zone();
 }
 
 void cVideo :: Toggle_Fullscreen( void )
@@ -1040,7 +1268,7 @@ void cVideo :: Toggle_Fullscreen( void )
 	glClearColor( clear_color[0], clear_color[1], clear_color[2], clear_color[3] );
 }
 
-cGL_Surface *cVideo :: Get_Surface( std::string filename, bool print_errors /* = 1 */ )
+std::string cVideo :: Get_Surface_Filename( std::string filename ) const
 {
 	// .settings file type can't be used directly
 	if( filename.find( ".settings" ) != std::string::npos )
@@ -1055,6 +1283,13 @@ cGL_Surface *cVideo :: Get_Surface( std::string filename, bool print_errors /* =
 		filename.insert( 0, DATA_DIR "/" GAME_PIXMAPS_DIR "/" );
 	}
 
+	return filename;
+}
+
+cGL_Surface *cVideo :: Get_Surface( std::string filename, bool print_errors /* = 1 */ )
+{
+	filename = Get_Surface_Filename( filename );
+
 	// check if already loaded
 	cGL_Surface *image = pImage_Manager->Get_Pointer( filename );
 	// already loaded
@@ -1064,7 +1299,8 @@ cGL_Surface *cVideo :: Get_Surface( std::string filename, bool print_errors /* =
 	}
 
 	// load new image
-	image = Load_GL_Surface( filename, 1, print_errors );
+	// managed images are kept until the image manager is cleared and can use the atlas
+	image = Load_GL_Surface( filename, 1, print_errors, 1 );
 	// add new image
 	if( image )
 	{
@@ -1074,71 +1310,208 @@ cGL_Surface *cVideo :: Get_Surface( std::string filename, bool print_errors /* =
 	return image;
 }
 
-cVideo::cSoftware_Image cVideo :: Load_Image( std::string filename, bool load_settings /* = 1 */, bool print_errors /* = 1 */ ) const
+void cVideo :: Load_Surfaces( const vector<std::string> &filenames, CEGUI::ProgressBar *progress_bar /* = NULL */ )
 {
-	// pixmaps dir must be given
-	if( filename.find( DATA_DIR "/" GAME_PIXMAPS_DIR "/" ) == std::string::npos ) 
+	// decoding runs in worker threads
+	cWorker_Pool pool;
+	typedef vector<cImage_Decode_Job *> DecodeJobList;
+	DecodeJobList jobs;
+
+	for( vector<std::string>::const_iterator itr = filenames.begin(), itr_end = filenames.end(); itr != itr_end; ++itr )
 	{
-		filename.insert( 0, DATA_DIR "/" GAME_PIXMAPS_DIR "/" );
+		std::string filename = Get_Surface_Filename( *itr );
+
+		// already loaded
+		if( pImage_Manager->Get_Pointer( filename ) )
+		{
+			continue;
+		}
+
+		cImage_Decode_Job *job = new cImage_Decode_Job();
+		job->Init( filename );
+
+		jobs.push_back( job );
+		pool.Add( job );
 	}
 
-	cSoftware_Image software_image = cSoftware_Image();
-	SDL_Surface *sdl_surface = NULL;
-	cImage_settings_data *settings = NULL;
+	const float job_count = static_cast<float>(jobs.size());
 
-	// load settings if available
-	if( load_settings )
+	// wait for decoding
+	unsigned int finished = 0;
+
+	while( finished < jobs.size() )
 	{
-		std::string settings_file = filename;
+		finished = pool.Wait_Finished( finished );
 
-		// if not already set
-		if( settings_file.rfind( ".settings" ) == std::string::npos )
+		if( progress_bar )
 		{
-			settings_file.erase( settings_file.rfind( "." ) + 1 );
-			settings_file.insert( settings_file.rfind( "." ) + 1, "settings" );
+			// first half is decoding
+			progress_bar->setProgress( static_cast<float>(finished) / job_count * 0.5f );
+
+			Loading_Screen_Draw();
 		}
+	}
 
-		// if a settings file exists
-		if( File_Exists( settings_file ) )
+	// create textures in the given order
+	for( unsigned int i = 0; i < jobs.size(); i++ )
+	{
+		cImage_Decode_Job *job = jobs[i];
+
+		// not loaded by an earlier job with the same filename
+		if( !pImage_Manager->Get_Pointer( job->m_filename ) )
 		{
-			settings = pSettingsParser->Get( settings_file );
+			// decoded
+			if( job->m_surface )
+			{
+				cSoftware_Image software_image;
+				software_image.sdl_surface = job->m_surface;
+				software_image.settings = job->m_settings;
+				job->m_surface = NULL;
+				job->m_settings = NULL;
 
-			// add cache dir and remove data dir
-			std::string img_filename_cache = m_imgcache_dir + "/" + settings_file.substr( strlen( DATA_DIR "/" ) ) + ".png";
+				cGL_Surface *image = Create_GL_Surface( job->m_filename, software_image, 1, 1 );
 
-			// check if image cache file exists
-			if( File_Exists( img_filename_cache ) )
+				if( image )
+				{
+					pImage_Manager->Add( image );
+				}
+			}
+			// failed : load directly to print the error
+			else
 			{
-				sdl_surface = IMG_Load( img_filename_cache.c_str() );
+				Get_Surface( job->m_filename );
 			}
-			// image given in base settings
-			else if( !settings->m_base.empty() )
+		}
+
+		delete job;
+
+		if( progress_bar )
+		{
+			// second half is texture creation
+			progress_bar->setProgress( 0.5f + ( static_cast<float>(i + 1) / job_count * 0.5f ) );
+
+			Loading_Screen_Draw();
+		}
+	}
+}
+
+// Return the image surface from the level preloader or load it
+static SDL_Surface *Load_Image_Surface( const std::string &filename )
+{
+	if( pLevel_Preloader )
+	{
+		SDL_Surface *surface = pLevel_Preloader->Get_Surface( filename );
+
+		if( surface )
+		{
+			return surface;
+		}
+	}
+
+	return IMG_Load( filename.c_str() );
+}
+
+// Return the settings filename of the image
+static std::string Get_Settings_Filename( const std::string &filename )
+{
+	std::string settings_file = filename;
+
+	// if not already set
+	if( settings_file.rfind( ".settings" ) == std::string::npos )
+	{
+		settings_file.erase( settings_file.rfind( "." ) + 1 );
+		settings_file.insert( settings_file.rfind( "." ) + 1, "settings" );
+	}
+
+	return settings_file;
+}
+
+cImage_settings_data *cVideo :: Load_Image_Settings( const std::string &filename ) const
+{
+	std::string settings_file = Get_Settings_Filename( filename );
+
+	// if a settings file exists
+	if( !File_Exists( settings_file ) )
+	{
+		return NULL;
+	}
+
+	return pSettingsParser->Get( settings_file );
+}
+
+std::string cVideo :: Get_Image_File( const std::string &filename, const cImage_settings_data *settings ) const
+{
+	if( settings )
+	{
+		// add cache dir and remove data dir
+		std::string img_filename_cache = m_imgcache_dir + "/" + Get_Settings_Filename( filename ).substr( strlen( DATA_DIR "/" ) ) + ".png";
+
+		// check if image cache file exists
+		if( File_Exists( img_filename_cache ) )
+		{
+			return img_filename_cache;
+		}
+		// image given in base settings
+		else if( !settings->m_base.empty() )
+		{
+			// use current directory
+			std::string img_filename = filename.substr( 0, filename.rfind( "/" ) + 1 ) + settings->m_base;
+
+			// not found
+			if( !File_Exists( img_filename ) )
 			{
-				// use current directory
-				std::string img_filename = filename.substr( 0, filename.rfind( "/" ) + 1 ) + settings->m_base;
+				// use data dir
+				img_filename = settings->m_base;
 
-				// not found
-				if( !File_Exists( img_filename ) )
+				// pixmaps dir must be given
+				if( img_filename.find( DATA_DIR "/" GAME_PIXMAPS_DIR "/" ) == std::string::npos )
 				{
-					// use data dir
-					img_filename = settings->m_base;
-
-					// pixmaps dir must be given
-					if( img_filename.find( DATA_DIR "/" GAME_PIXMAPS_DIR "/" ) == std::string::npos )
-					{
-						img_filename.insert( 0, DATA_DIR "/" GAME_PIXMAPS_DIR "/" );
-					}
+					img_filename.insert( 0, DATA_DIR "/" GAME_PIXMAPS_DIR "/" );
 				}
-
-				sdl_surface = IMG_Load( img_filename.c_str() );
 			}
+
+			return img_filename;
 		}
 	}
 
-	// if not set in image settings and file exists
-	if( !sdl_surface && File_Exists( filename ) && ( !settings || settings->m_base.empty() ) )
+	// if file exists
+	if( File_Exists( filename ) )
+	{
+		return filename;
+	}
+
+	return "";
+}
+
+cVideo::cSoftware_Image cVideo :: Load_Image( std::string filename, bool load_settings /* = 1 */, bool print_errors /* = 1 */ ) const
+{
+	// pixmaps dir must be given
+	if( filename.find( DATA_DIR "/" GAME_PIXMAPS_DIR "/" ) == std::string::npos ) 
+	{
+		filename.insert( 0, DATA_DIR "/" GAME_PIXMAPS_DIR "/" );
+	}
+
+	cSoftware_Image software_image = cSoftware_Image();
+	SDL_Surface *sdl_surface = NULL;
+	cImage_settings_data *settings = NULL;
+
+	// load settings if available
+	if( load_settings )
+	{
+		settings = Load_Image_Settings( filename );
+	}
+
+	std::string image_file = Get_Image_File( filename, settings );
+
+	if( !image_file.empty() )
+	{
+		sdl_surface = Load_Image_Surface( image_file );
+	}
+
+	// if the image cache file failed and not set in image settings
+	if( !sdl_surface && image_file.compare( filename ) != 0 && File_Exists( filename ) && ( !settings || settings->m_base.empty() ) )
 	{
-		sdl_surface = IMG_Load( filename.c_str() );
+		sdl_surface = Load_Image_Surface( filename );
 	}
 
 	if( !sdl_surface )
@@ -1162,7 +1535,7 @@ cVideo::cSoftware_Image cVideo :: Load_Image( std::string filename, bool load_se
 	return software_image;
 }
 
-cGL_Surface *cVideo :: Load_GL_Surface( std::string filename, bool use_settings /* = 1 */, bool print_errors /* = 1 */ )
+cGL_Surface *cVideo :: Load_GL_Surface( std::string filename, bool use_settings /* = 1 */, bool print_errors /* = 1 */, bool use_atlas /* = 0 */ )
 {
 	// pixmaps dir must be given
 	if( filename.find( DATA_DIR "/" GAME_PIXMAPS_DIR "/" ) == std::string::npos ) 
@@ -1171,7 +1544,11 @@ cGL_Surface *cVideo :: Load_GL_Surface( std::string filename, bool use_settings
 	}
 
 	// load software image
-	cSoftware_Image software_image = Load_Image( filename, use_settings, print_errors );
+	return Create_GL_Surface( filename, Load_Image( filename, use_settings, print_errors ), print_errors, use_atlas );
+}
+
+cGL_Surface *cVideo :: Create_GL_Surface( const std::string &filename, cSoftware_Image software_image, bool print_errors /* = 1 */, bool use_atlas /* = 0 */ )
+{
 	SDL_Surface *sdl_surface = software_image.sdl_surface;
 	cImage_settings_data *settings = software_image.settings;
 
@@ -1184,7 +1561,7 @@ cGL_Surface *cVideo :: Load_GL_Surface( std::string filename, bool use_settings
 		// get the size
 		cSize_Float size = settings->Get_Surface_Size( sdl_surface );
 		// get basic settings surface
-		image = pVideo->Create_Texture( sdl_surface, settings->m_mipmap, static_cast<unsigned int>(size.m_width), static_cast<unsigned int>(size.m_height) );
+		image = pVideo->Create_Texture( sdl_surface, settings->m_mipmap, static_cast<unsigned int>(size.m_width), static_cast<unsigned int>(size.m_height), use_atlas );
 		// apply settings
 		settings->Apply( image );
 		delete settings;
@@ -1192,7 +1569,7 @@ cGL_Surface *cVideo :: Load_GL_Surface( std::string filename, bool use_settings
 	// without settings
 	else
 	{
-		image = Create_Texture( sdl_surface );
+		image = Create_Texture( sdl_surface, 0, 0, 0, use_atlas );
 	}
 	// set filename
 	if( image )
@@ -1238,7 +1615,7 @@ SDL_Surface *cVideo :: Convert_To_Final_Software_Image( SDL_Surface *surface ) c
 	return surface;
 }
 
-cGL_Surface *cVideo :: Create_Texture( SDL_Surface *surface, bool mipmap /* = 0 */, unsigned int force_width /* = 0 */, unsigned int force_height /* = 0 */ ) const
+cGL_Surface *cVideo :: Create_Texture( SDL_Surface *surface, bool mipmap /* = 0 */, unsigned int force_width /* = 0 */, unsigned int force_height /* = 0 */, bool use_atlas /* = 0 */ ) const
 {
 	if( !surface )
 	{
@@ -1248,24 +1625,6 @@ cGL_Surface *cVideo :: Create_Texture( SDL_Surface *surface, bool mipmap /* = 0
 	// create final image
 	surface = Convert_To_Final_Software_Image( surface );
 
-	// create one texture
-	GLuint image_num = 0;
-	glGenTextures( 1, &image_num );
-
-	// if image id is 0 it failed
-	if( !image_num )
-	{
-		printf( "Error : GL image generation failed\n" );
-		SDL_FreeSurface( surface );
-		return NULL;
-	}
-	
-	// set highest texture id
-	if( pImage_Manager->high_texture_id < image_num )
-	{
-		pImage_Manager->high_texture_id = image_num;
-	}
-
 	int width = surface->w;
 	int height = surface->h;
 
@@ -1290,6 +1649,9 @@ cGL_Surface *cVideo :: Create_Texture( SDL_Surface *surface, bool mipmap /* = 0
 	// check if the image size is greater than the maximum texture size
 	Apply_Max_Texture_Size( texture_width, texture_height );
 
+	// pixels per row
+	int row_length = texture_width;
+
 	// scale to new size
 	if( texture_width != surface->w || texture_height != surface->h )
 	{
@@ -1302,10 +1664,62 @@ cGL_Surface *cVideo :: Create_Texture( SDL_Surface *surface, bool mipmap /* = 0
 		SDL_free( surface->pixels );
 		surface->pixels = new_pixels;
 	}
-	// set SDL_image pixel store mode
 	else
 	{
-		glPixelStorei( GL_UNPACK_ROW_LENGTH, surface->pitch / surface->format->BytesPerPixel );
+		row_length = surface->pitch / surface->format->BytesPerPixel;
+	}
+
+	// create OpenGL surface class
+	cGL_Surface *image = new cGL_Surface();
+	image->m_tex_w = texture_width;
+	image->m_tex_h = texture_height;
+	image->m_start_w = static_cast<float>(width);
+	image->m_start_h = static_cast<float>(height);
+	image->m_w = image->m_start_w;
+	image->m_h = image->m_start_h;
+	image->m_col_w = image->m_w;
+	image->m_col_h = image->m_h;
+
+	// no OpenGL context
+	if( m_headless )
+	{
+		SDL_FreeSurface( surface );
+		return image;
+	}
+
+	// add to the texture atlas
+	// mipmaps would mix the neighbour images
+	if( use_atlas && !mipmap && pImage_Manager->m_atlas.Add( image, surface->pixels, texture_width, texture_height, row_length ) )
+	{
+		SDL_FreeSurface( surface );
+		return image;
+	}
+
+	// create one texture
+	GLuint image_num = 0;
+	glGenTextures( 1, &image_num );
+
+	// if image id is 0 it failed
+	if( !image_num )
+	{
+		printf( "Error : GL image generation failed\n" );
+		SDL_FreeSurface( surface );
+		delete image;
+		return NULL;
+	}
+	
+	// set highest texture id
+	if( pImage_Manager->high_texture_id < image_num )
+	{
+		pImage_Manager->high_texture_id = image_num;
+	}
+
+	image->m_image = image_num;
+
+	// set SDL_image pixel store mode
+	if( row_length != texture_width )
+	{
+		glPixelStorei( GL_UNPACK_ROW_LENGTH, row_length );
 	}
 
 	// use the generated texture
@@ -1324,18 +1738,6 @@ cGL_Surface *cVideo :: Create_Texture( SDL_Surface *surface, bool mipmap /* = 0
 
 	SDL_FreeSurface( surface );
 
-	// create OpenGL surface class
-	cGL_Surface *image = new cGL_Surface();
-	image->m_image = image_num;
-	image->m_tex_w = texture_width;
-	image->m_tex_h = texture_height;
-	image->m_start_w = static_cast<float>(width);
-	image->m_start_h = static_cast<float>(height);
-	image->m_w = image->m_start_w;
-	image->m_h = image->m_start_h;
-	image->m_col_w = image->m_w;
-	image->m_col_h = image->m_h;
-
 	// if debug build check for errors
 #ifdef _DEBUG
 	while( 1 )
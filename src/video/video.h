@@ -129,6 +129,25 @@ enum Effect_Fadein
 	EFFECT_IN_AMOUNT
 };
 
+/* *** *** *** *** *** *** *** CEGUI texture fake class *** *** *** *** *** *** *** *** *** *** */
+
+// only remembers the texture size
+class cFake_Texture : public CEGUI::Texture
+{
+public:
+	cFake_Texture( CEGUI::Renderer *owner, unsigned int size = 0 );
+	virtual ~cFake_Texture( void );
+
+	virtual CEGUI::ushort getWidth(void) const { return m_width; };
+	virtual CEGUI::ushort getHeight(void) const { return m_height; };
+	// only reads the image size
+	virtual void loadFromFile(const CEGUI::String& filename, const CEGUI::String& resourceGroup);
+	virtual void loadFromMemory(const void* buffPtr, CEGUI::uint buffWidth, CEGUI::uint buffHeight, CEGUI::Texture::PixelFormat pixelFormat);
+
+	CEGUI::ushort m_width;
+	CEGUI::ushort m_height;
+};
+
 /* *** *** *** *** *** *** *** CEGUI renderer fake class *** *** *** *** *** *** *** *** *** *** */
 
 class cFake_Renderer : public CEGUI::Renderer
@@ -141,19 +160,27 @@ public:
 	virtual	void doRender(void) {};
 	virtual	void clearRenderList(void) {};
 	virtual void setQueueingEnabled(bool setting) {};
-	virtual	CEGUI::Texture *createTexture(void) { return NULL; };
-	virtual	CEGUI::Texture *createTexture(const CEGUI::String& filename, const CEGUI::String& resourceGroup) { return NULL; };
-	virtual	CEGUI::Texture *createTexture(float size) { return NULL; };
-	virtual	void destroyTexture(CEGUI::Texture* texture) {};
-	virtual void destroyAllTextures(void) {};
+	virtual	CEGUI::Texture *createTexture(void);
+	virtual	CEGUI::Texture *createTexture(const CEGUI::String& filename, const CEGUI::String& resourceGroup);
+	virtual	CEGUI::Texture *createTexture(float size);
+	virtual	void destroyTexture(CEGUI::Texture* texture);
+	virtual void destroyAllTextures(void);
 	virtual bool isQueueingEnabled(void) const { return 0; };
-	virtual float getWidth(void) const { return 0; };
-	virtual float getHeight(void) const { return 0; };
-	virtual CEGUI::Size getSize(void) const { return CEGUI::Size();};
-	virtual CEGUI::Rect getRect(void) const { return CEGUI::Rect();};
-	virtual	unsigned int getMaxTextureSize(void) const { return 0; };
-	virtual	unsigned int getHorzScreenDPI(void) const { return 0; };
-	virtual	unsigned int getVertScreenDPI(void) const { return 0; };
+	virtual float getWidth(void) const { return m_display_size.d_width; };
+	virtual float getHeight(void) const { return m_display_size.d_height; };
+	virtual CEGUI::Size getSize(void) const { return m_display_size; };
+	virtual CEGUI::Rect getRect(void) const { return CEGUI::Rect( 0, 0, m_display_size.d_width, m_display_size.d_height ); };
+	virtual	unsigned int getMaxTextureSize(void) const { return 2048; };
+	virtual	unsigned int getHorzScreenDPI(void) const { return 96; };
+	virtual	unsigned int getVertScreenDPI(void) const { return 96; };
+
+	// display size used for the GUI layout
+	CEGUI::Size m_display_size;
+
+private:
+	typedef vector<cFake_Texture *> Fake_Texture_List;
+	// created textures
+	Fake_Texture_List m_textures;
 };
 
 /* *** *** *** *** *** *** *** Video class *** *** *** *** *** *** *** *** *** *** */
@@ -168,6 +195,10 @@ public:
 	void Init_CEGUI_Fake( void ) const;
 	// Delete the CEGUI system and renderer fake
 	void Delete_CEGUI_Fake( void ) const;
+	/* Keep the CEGUI system and renderer fake as GUI without a screen
+	 * sets the resource directories and the display size from the preferences
+	*/
+	void Init_CEGUI_Headless( void ) const;
 	// Initialize the CEGUI System and Renderer
 	void Init_CEGUI( void ) const;
 	// Initialize the basic CEGUI data and configuration
@@ -219,6 +250,13 @@ public:
 	 * The returned image should not be deleted or modified.
 	 */
 	cGL_Surface *Get_Surface( std::string filename, bool print_errors = 1 );
+	// Return the image filename used by Get_Surface with the pixmaps directory and file type
+	std::string Get_Surface_Filename( std::string filename ) const;
+	/* Load all given images which are not already loaded into the image manager
+	 * the images are decoded in worker threads and the textures are created in the given order
+	 * progress_bar : if set the progress is drawn with the loading screen
+	*/
+	void Load_Surfaces( const vector<std::string> &filenames, CEGUI::ProgressBar *progress_bar = NULL );
 
 	// Software image
 	class cSoftware_Image
@@ -240,13 +278,29 @@ public:
 	 * The returned data in the software image should be deleted if not used anymore
 	*/
 	cSoftware_Image Load_Image( std::string filename, bool load_settings = 1, bool print_errors = 1 ) const;
+	/* Load and return the image settings of the given image filename
+	 * returns NULL if not available
+	 * The returned settings should be deleted if not used anymore
+	*/
+	cImage_settings_data *Load_Image_Settings( const std::string &filename ) const;
+	/* Return the file to load for the given image filename and its settings
+	 * this is the image cache file, the settings base image or the image itself
+	 * returns an empty string if not available
+	*/
+	std::string Get_Image_File( const std::string &filename, const cImage_settings_data *settings ) const;
 
 	/* Load and return the hardware image
 	 * use_settings : enable file settings if set to 1
 	 * print_errors : print errors if image couldn't be created or loaded
+	 * use_atlas : if set small images are added to the image manager texture atlas
 	 * The returned image should be deleted if not used anymore
 	*/
-	cGL_Surface *Load_GL_Surface( std::string filename, bool use_settings = 1, bool print_errors = 1 );
+	cGL_Surface *Load_GL_Surface( std::string filename, bool use_settings = 1, bool print_errors = 1, bool use_atlas = 0 );
+	/* Create and return the hardware image from the software image
+	 * the software image data is deleted
+	 * The returned image should be deleted if not used anymore
+	*/
+	cGL_Surface *Create_GL_Surface( const std::string &filename, cSoftware_Image software_image, bool print_errors = 1, bool use_atlas = 0 );
 
 	/* Convert to a software image with a power of 2 size and 32 bits per pixel
 	 * surface : the source image which gets converted if needed
@@ -257,8 +311,9 @@ public:
 	/* Create a GL image from a SDL_Surface
 	 * mipmap : create texture mipmaps
 	 * force_width/height : force the given width and height
+	 * use_atlas : if set and small enough add it to the image manager texture atlas
 	*/
-	cGL_Surface *Create_Texture( SDL_Surface *surface, bool mipmap = 0, unsigned int force_width = 0, unsigned int force_height = 0 ) const;
+	cGL_Surface *Create_Texture( SDL_Surface *surface, bool mipmap = 0, unsigned int force_width = 0, unsigned int force_height = 0, bool use_atlas = 0 ) const;
 
 	/* Create a texture into the bound GL texture
 	 * mipmap : create texture mipmaps
@@ -329,6 +384,12 @@ public:
 	float m_geometry_quality;
 	// texture quality level 0.0 - 1.0
 	float m_texture_quality;
+
+	/* if set there is no screen and no OpenGL context
+	 * textures only get their size and nothing is drawn
+	 * used by the benchmark mode
+	*/
+	bool m_headless;
 private:
 	// if set video is initialized successfully
 	bool m_initialised;